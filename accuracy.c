@@ -0,0 +1,132 @@
+/*
+    Author: Johnathan M Melo Neto (jmmn.mg@gmail.com)
+    Related paper: "Hybridization of Cartesian Genetic Programming and Differential Evolution 
+        for Generating Classifiers based on Neural Networks"
+
+    This file is an adapted version of CGP-Library
+    Copyright (c) Andrew James Turner 2014, 2015 (andrew.turner@york.ac.uk)
+    The original CGP-Library is available in <http://www.cgplibrary.co.uk>    
+*/
+
+/*
+    The accuracy fitness functions of the classification tasks, shared by
+    main.c and bench.c so that the benchmarks time the code the example runs
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+
+#include "cgpdelib.h"
+#include "accuracy.h"
+
+/* 
+    Accuracy: the proportion of correctly classified instances
+    The output node that presents the higher value is defined as the class of the instance
+    e.g. Consider a chromosome with 3 output nodes, their final values are:
+    Output1: 0.25 | Output2: 0.34 | Output3: 0.09
+    As Output2 presents the larger value, the instance is labeled as Class #2
+    
+    Here, we aim to minimize -(accuracy), which is equivalent to maximize +(accuracy)
+*/
+double accuracy(struct parameters *params, struct chromosome *chromo, struct dataSet *data)
+{
+    return classificationAccuracy(chromo, data, DBL_MAX);
+}
+
+/*
+    The accuracy reported for the testing sets: +(accuracy)
+*/
+double testingAccuracy(struct parameters *params, struct chromosome *chromo, struct dataSet *data)
+{
+    return -accuracy(params, chromo, data);
+}
+
+/*
+    The bounded form of accuracy, see classificationAccuracy
+*/
+double accuracyBounded(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff)
+{
+    return classificationAccuracy(chromo, data, cutoff);
+}
+
+/*
+    -(accuracy) of the given chromosome on the given dataSet. Unless the cutoff
+    is DBL_MAX, the instances are classified a block at a time and the remaining
+    instances are skipped once, even if all of them were correctly classified,
+    -(accuracy) could not be lower than or equal to the cutoff
+*/
+double classificationAccuracy(struct chromosome *chromo, struct dataSet *data, double cutoff)
+{
+    int i,j;
+    int accuracy = 0;
+    int numOutputs = getNumChromosomeOutputs(chromo);
+    int numSamples = getNumDataSetSamples(data);
+    int blockSize = (cutoff == DBL_MAX) ? numSamples : 256;
+    int firstSample;
+    double *outputs;
+
+    if(getNumChromosomeInputs(chromo) != getNumDataSetInputs(data))
+    {
+        printf("Error: the number of chromosome inputs must match the number of inputs specified in the dataSet.\n");
+        printf("Terminating.\n");
+        exit(0);
+    }
+
+    if(getNumChromosomeOutputs(chromo) != getNumDataSetOutputs(data))
+    {
+        printf("Error: the number of chromosome outputs must match the number of outputs specified in the dataSet.\n");
+        printf("Terminating.\n");
+        exit(0);
+    }
+
+    outputs = (double*)malloc(blockSize * numOutputs * sizeof(double));
+
+    for(firstSample = 0; firstSample < numSamples; firstSample += blockSize)
+    {
+        // the best fitness still reachable by the chromosome
+        double bestFitness = -(double)(accuracy + numSamples - firstSample) / (double)numSamples;
+
+        if(bestFitness > cutoff)
+        {
+            free(outputs);
+            return bestFitness;
+        }
+
+        int numBlockSamples = numSamples - firstSample < blockSize ? numSamples - firstSample : blockSize;
+
+        executeChromosomeSamples(chromo, data, firstSample, numBlockSamples, outputs);
+
+        for(i = 0; i < numBlockSamples; i++)
+        {
+            double max_predicted = -DBL_MAX;
+            int predicted_class = 0;
+            int correct_class = 0;
+
+            for(j = 0; j < numOutputs; j++)
+            {
+                double current_prediction = outputs[(i * numOutputs) + j];
+
+                if(current_prediction > max_predicted)
+                {
+                    max_predicted = current_prediction;
+                    predicted_class = j;
+                }
+
+                if(getDataSetSampleOutput(data,firstSample + i,j) == 1.0)
+                {
+                    correct_class = j;
+                }
+            }
+
+            if(predicted_class == correct_class)
+            {
+                accuracy++;
+            }
+        }
+    }
+
+    free(outputs);
+
+    return -accuracy / (double)numSamples;
+}
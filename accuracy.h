@@ -0,0 +1,25 @@
+/*
+    Author: Johnathan M Melo Neto (jmmn.mg@gmail.com)
+    Related paper: "Hybridization of Cartesian Genetic Programming and Differential Evolution 
+        for Generating Classifiers based on Neural Networks"
+
+    This file is an adapted version of CGP-Library
+    Copyright (c) Andrew James Turner 2014, 2015 (andrew.turner@york.ac.uk)
+    The original CGP-Library is available in <http://www.cgplibrary.co.uk>    
+*/
+
+/*
+    The accuracy fitness functions of the classification tasks, see accuracy.c
+*/
+
+#ifndef ACCURACY
+#define ACCURACY
+
+#include "cgpdelib.h"
+
+double accuracy(struct parameters *, struct chromosome *, struct dataSet *);
+double accuracyBounded(struct parameters *, struct chromosome *, struct dataSet *, double);
+double testingAccuracy(struct parameters *, struct chromosome *, struct dataSet *);
+double classificationAccuracy(struct chromosome *, struct dataSet *, double);
+
+#endif
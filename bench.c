@@ -0,0 +1,305 @@
+/*
+    Microbenchmarks of the evolutionary hot paths of CGPDE-Library.
+
+    Every benchmark uses fixed seeds and a fixed number of iterations so
+    that the same work is timed on every run. The results are written to
+    stdout as comma separated values, one line per benchmark:
+
+        benchmark,dataSet,nodes,arity,iterations,seconds,nsPerOp
+
+    nodes and arity are 0 for the benchmarks of the dataSets. Build and
+    run with "make bench", which also keeps a copy in bench_output.txt.
+*/
+
+/* clock_gettime */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cgpdelib.h"
+#include "accuracy.h"
+
+#define NUMDATASETS 7
+#define NUMNODECOUNTS 3
+#define NUMARITIES 3
+#define NUMMUTATIONTYPES 5
+
+// the chromosomes executed for each benchmark, and so the number of iterations, are fixed
+#define WORK 200000000
+
+double getTime(void);
+void printResult(const char *benchmark, const char *dataSet, int nodes, int arity, long iterations, double seconds);
+void benchDataSets(void);
+void benchChromosomes(struct dataSet *data, const char *dataSetName, int numNodes, int arity);
+void benchDE(struct dataSet *data, const char *dataSetName, int numNodes, int arity);
+
+int main(void)
+{
+    const char *dataSetName = "iris";
+    const int nodeCounts[NUMNODECOUNTS] = {50, 200, 500};
+    const int arities[NUMARITIES] = {2, 10, 20};
+    int i, j;
+
+    struct dataSet *data = initialiseDataSetFromFile("./dataSets/iris.txt");
+
+    printf("benchmark,dataSet,nodes,arity,iterations,seconds,nsPerOp\n");
+
+    benchDataSets();
+
+    for (i = 0; i < NUMNODECOUNTS; i++)
+    {
+        for (j = 0; j < NUMARITIES; j++)
+        {
+            benchChromosomes(data, dataSetName, nodeCounts[i], arities[j]);
+            benchDE(data, dataSetName, nodeCounts[i], arities[j]);
+        }
+    }
+
+    freeDataSet(data);
+
+    return 0;
+}
+
+/*
+    The loading of every bundled dataSet and the generation of its folds
+*/
+void benchDataSets(void)
+{
+    const char *dataSetNames[NUMDATASETS] = {"cancer", "diabetes", "glass", "ionosphere", "iris", "vertebral", "wine"};
+    const int iterations = 200;
+    char file[64];
+    int i, j, k;
+    unsigned int seed;
+    double start;
+    struct dataSet *data;
+    struct dataSet **folds;
+
+    for (i = 0; i < NUMDATASETS; i++)
+    {
+        snprintf(file, sizeof(file), "./dataSets/%s.txt", dataSetNames[i]);
+
+        start = getTime();
+
+        for (k = 0; k < iterations; k++)
+        {
+            data = initialiseDataSetFromFile(file);
+            freeDataSet(data);
+        }
+
+        printResult("initialiseDataSetFromFile", dataSetNames[i], 0, 0, iterations, getTime() - start);
+
+        data = initialiseDataSetFromFile(file);
+        seed = 50;
+        shuffleData(data, &seed);
+
+        start = getTime();
+
+        for (k = 0; k < iterations; k++)
+        {
+            folds = generateFolds(data);
+
+            for (j = 0; j < 10; j++)
+            {
+                freeDataSet(folds[j]);
+            }
+            free(folds);
+        }
+
+        printResult("generateFolds", dataSetNames[i], 0, 0, iterations, getTime() - start);
+
+        freeDataSet(data);
+    }
+}
+
+/*
+    The execution, evaluation, copying and mutation of chromosomes of the
+    given size. The active nodes are found again after each mutation and
+    their time is that counted by a profile of the mutations.
+*/
+void benchChromosomes(struct dataSet *data, const char *dataSetName, int numNodes, int arity)
+{
+    const char *mutationTypes[NUMMUTATIONTYPES] = {"probabilistic", "point", "pointANN", "onlyActive", "single"};
+    const int numSamples = getNumDataSetSamples(data);
+    const int numInputs = getNumDataSetInputs(data);
+    const int numOutputs = getNumDataSetOutputs(data);
+    long iterations;
+    long k;
+    int i;
+    unsigned int seed = 123;
+    char benchmark[64];
+    double start;
+    double *outputs;
+    struct parameters *params;
+    struct chromosome *chromo;
+    struct chromosome *chromoCopy;
+    struct profile *prof;
+
+    params = initialiseParameters(numInputs, numNodes, numOutputs, arity);
+    addNodeFunction(params, "sig");
+    setConnectionWeightRange(params, 5);
+    setMutationRate(params, 0.05);
+
+    chromo = initialiseChromosome(params, &seed);
+    chromoCopy = initialiseChromosomeFromChromosome(chromo, &seed);
+    outputs = (double*)malloc(numSamples * numOutputs * sizeof(double));
+
+    // execution of one sample at a time and of every sample at once
+    iterations = 1 + WORK / ((long)numNodes * arity);
+
+    start = getTime();
+    for (k = 0; k < iterations; k++)
+    {
+        executeChromosome(chromo, getDataSetSampleInputs(data, k % numSamples));
+    }
+    printResult("executeChromosome", dataSetName, numNodes, arity, iterations, getTime() - start);
+
+    iterations = 1 + WORK / ((long)numNodes * arity * numSamples);
+
+    start = getTime();
+    for (k = 0; k < iterations; k++)
+    {
+        executeChromosomeBatch(chromo, data, outputs);
+    }
+    printResult("executeChromosomeBatch", dataSetName, numNodes, arity, iterations, getTime() - start);
+
+    // the fitness functions, on every sample
+    start = getTime();
+    for (k = 0; k < iterations; k++)
+    {
+        setChromosomeFitness(params, chromo, data);
+    }
+    printResult("fitnessSupervisedLearning", dataSetName, numNodes, arity, iterations, getTime() - start);
+
+    setCustomFitnessFunction(params, accuracy, "accuracy");
+
+    start = getTime();
+    for (k = 0; k < iterations; k++)
+    {
+        setChromosomeFitness(params, chromo, data);
+    }
+    printResult("fitnessAccuracy", dataSetName, numNodes, arity, iterations, getTime() - start);
+
+    // the fast evaluator only applies to chromosomes initialised once it is set
+    setFastActivation(params, 1);
+    freeChromosome(chromoCopy);
+    seed = 123;
+    chromoCopy = initialiseChromosome(params, &seed);
+
+    start = getTime();
+    for (k = 0; k < iterations; k++)
+    {
+        setChromosomeFitness(params, chromoCopy, data);
+    }
+    printResult("fitnessAccuracyFastActivation", dataSetName, numNodes, arity, iterations, getTime() - start);
+
+    setFastActivation(params, 0);
+    freeChromosome(chromoCopy);
+    chromoCopy = initialiseChromosomeFromChromosome(chromo, &seed);
+
+    // copying, which also rebuilds the execution plan
+    iterations = 1 + WORK / ((long)numNodes * arity * 20);
+
+    start = getTime();
+    for (k = 0; k < iterations; k++)
+    {
+        copyChromosome(chromoCopy, chromo);
+    }
+    printResult("copyChromosome", dataSetName, numNodes, arity, iterations, getTime() - start);
+
+    // each mutation type, from the same chromosome and seed, counting the updates of the active nodes
+    prof = initialiseProfile();
+    setProfile(params, prof);
+
+    freeChromosome(chromoCopy);
+    chromoCopy = initialiseChromosome(params, &seed);
+    resetProfile(prof);
+
+    for (i = 0; i < NUMMUTATIONTYPES; i++)
+    {
+        setMutationType(params, mutationTypes[i]);
+        copyChromosome(chromoCopy, chromo);
+        seed = 456;
+
+        start = getTime();
+        for (k = 0; k < iterations; k++)
+        {
+            mutateChromosome(params, chromoCopy, 0, &seed);
+        }
+        snprintf(benchmark, sizeof(benchmark), "mutateChromosome_%s", mutationTypes[i]);
+        printResult(benchmark, dataSetName, numNodes, arity, iterations, getTime() - start);
+    }
+
+    printResult("setChromosomeActiveNodes", dataSetName, numNodes, arity, (long)getProfileActiveNodesUpdates(prof), getProfileTime(prof, "activeNodes"));
+
+    setProfile(params, NULL);
+    freeProfile(prof);
+
+    free(outputs);
+    freeChromosome(chromoCopy);
+    freeChromosome(chromo);
+    freeParameters(params);
+}
+
+/*
+    DE iterations of CGPDE-OUT on the weights of a chromosome of the given size
+*/
+void benchDE(struct dataSet *data, const char *dataSetName, int numNodes, int arity)
+{
+    const int NP = 20;
+    int maxIter;
+    int i;
+    unsigned int seed = 789;
+    double start;
+    struct parameters *params;
+    struct chromosome *chromo;
+    struct chromosome **population;
+
+    params = initialiseParameters(getNumDataSetInputs(data), numNodes, getNumDataSetOutputs(data), arity);
+    addNodeFunction(params, "sig");
+    setConnectionWeightRange(params, 5);
+    setCustomFitnessFunction(params, accuracy, "accuracy");
+
+    maxIter = 1 + WORK / ((long)numNodes * arity * getNumDataSetSamples(data) * NP);
+
+    setNP_OUT(params, NP);
+    setMaxIter_OUT(params, maxIter);
+
+    chromo = initialiseChromosome(params, &seed);
+
+    start = getTime();
+    population = runDE(params, chromo, data, data, 2, &seed);
+    printResult("runDE_iteration", dataSetName, numNodes, arity, maxIter, getTime() - start);
+
+    for (i = 0; i < NP; i++)
+    {
+        freeChromosome(population[i]);
+    }
+    free(population);
+
+    freeChromosome(chromo);
+    freeParameters(params);
+}
+
+/*
+    Prints the result of a benchmark as a line of comma separated values
+*/
+void printResult(const char *benchmark, const char *dataSet, int nodes, int arity, long iterations, double seconds)
+{
+    printf("%s,%s,%d,%d,%ld,%.6f,%.1f\n", benchmark, dataSet, nodes, arity, iterations, seconds, (seconds * 1e9) / (iterations > 0 ? iterations : 1));
+    fflush(stdout);
+}
+
+/*
+    Returns a monotonic time in seconds
+*/
+double getTime(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + (now.tv_nsec * 1e-9);
+}
@@ -8,12 +8,29 @@
 	The original CGP-Library is available in <http://www.cgplibrary.co.uk>    
 */
 
+/* madvise, used to prefetch and release the chunks of streamed dataSets */
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <math.h>
 #include <float.h>
+#include <stdint.h>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef CGPDE_MPI
+#include <mpi.h>
+#endif
 
 #include "cgpdelib.h"
 
@@ -28,6 +45,39 @@
 #define MUTATIONTYPENAMELENGTH 21
 #define SELECTIONSCHEMENAMELENGTH 21
 #define REPRODUCTIONSCHEMENAMELENGTH 21
+#define CHECKPOINTFILENAMELENGTH 256
+#define BATCHBLOCKSIZE 32
+#define OFFLOADBLOCKSIZE 256
+
+/* the phases timed by a profile, see getProfileTime */
+#define PROFILENUMPHASES 5
+#define PROFILEEVALUATION 0
+#define PROFILEACTIVENODES 1
+#define PROFILECOPY 2
+#define PROFILEMUTATION 3
+#define PROFILEDE 4
+
+/* the run functions which save checkpoints, see setCheckpoint */
+#define CHECKPOINTCGP 0
+#define CHECKPOINTCGPDE_IN 1
+#define CHECKPOINTCGPDE_OUT 2
+#define BOUNDEDFITNESSBLOCKSIZE 256
+#define DATASETALIGNMENT 64
+#define DATASETVALUELENGTH 128
+#define BINARYFORMATVERSION 1
+#define BINARYBYTEORDER 0x01020304
+#define NODECACHESLOTS 2
+#define CHROMOSOMEALIGNMENT 16
+#define EXPERIMENTNUMALGORITHMS 3
+#define MIGRATIONRING 0
+#define MIGRATIONCOMPLETE 1
+#define ACTIVATIONNONE 0
+#define ACTIVATIONSIGMOID 1
+#define ACTIVATIONHYPERBOLICTANGENT 2
+#define ACTIVATIONSOFTSIGN 3
+#define ACTIVATIONGAUSSIAN 4
+/* the value of pi given by the pi node function rather than that of math.h */
+#undef M_PI
 #define M_PI 3.14159265359
 
 /*
@@ -46,17 +96,38 @@ struct parameters {
 	int numOutputs;
 	int arity;
 	double targetFitness;
+	int maxStallGenerations;
+	double timeBudget;
 	struct functionSet *funcSet;
 	int shortcutConnections;
 	void (*mutationType)(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed);
 	char mutationTypeName[MUTATIONTYPENAMELENGTH];
 	double (*fitnessFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *dat);
 	char fitnessFunctionName[FITNESSFUNCTIONNAMELENGTH];
+	double (*boundedFitnessFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *dat, double cutoff);
 	void (*selectionScheme)(struct parameters *params, struct chromosome **parents, struct chromosome **candidateChromos, int numParents, int numCandidateChromos);
 	char selectionSchemeName[SELECTIONSCHEMENAMELENGTH];
 	void (*reproductionScheme)(struct parameters *params, struct chromosome **parents, struct chromosome **children, int numParents, int numChildren, int type, unsigned int * seed);
 	char reproductionSchemeName[REPRODUCTIONSCHEMENAMELENGTH];
 	int numThreads;
+	int fitnessMemoisation;
+	int nodeCacheSize;
+	int fastActivation;
+	int offloadEvaluation;
+	int miniBatchSize;
+	int fullEvaluationInterval;
+	int migrationInterval;
+	int numMigrants;
+	int migrationTopology;
+	int island;
+	int numIslands;
+	void (*migrationTransport)(void *context, int destination, const char *sendBuffer, size_t sendSize, int source, char **receiveBuffer, size_t *receiveSize);
+	void *migrationContext;
+	struct profile *profile;
+	int profileLogInterval;
+	void (*profileLog)(struct parameters *params, struct profile *prof, int generation);
+	int checkpointInterval;
+	char checkpointFile[CHECKPOINTFILENAMELENGTH];
 
 	// DE Parameters
 	int NP_IN;       // DE population size: NP >= 4 (CGPDE-IN)
@@ -65,6 +136,11 @@ struct parameters {
 	int maxIter_OUT; // number of DE iterations (CGPDE-OUT)
 	double CR;       // crossover rate: [0,1]
 	double F;        // differential scale factor: [0,2]
+	int synchronousDE; // 1: evaluate the trial vectors of each DE iteration together
+	int activeWeightsDE; // 1: the DE weights vector only holds the weights of active connections
+	int recycleDEPopulation; // 1: CGPDE-IN reuses one DE population across its generations
+	double minDiversityDE; // DE stops once the mean deviation of its weights is below this
+	int topologyCacheSize; // number of DE-tuned topologies CGPDE-IN remembers, 0: none
 };
 
 struct chromosome {
@@ -76,12 +152,61 @@ struct chromosome {
 	struct node **nodes;
 	int *outputNodes;
 	int *activeNodes;
+	int activeNodesDirty;
 	double fitness;
 	double fitnessValidation;
 	double *outputValues;
 	struct functionSet *funcSet;
 	double *nodeInputsHold;
 	int generation;
+
+	/* flat execution plan of the active nodes, built by compileChromosome */
+	int *planFunctions;
+	int *planArity;
+	int *planSlots;
+	int *planInputs;
+	double *planWeights;
+	double *nodeValues;
+	int planRecurrent;
+
+	/* the depth of each node, used by getChromosomeDepth */
+	int *nodeDepths;
+
+	/* the activation shared by every step of the plan, used when fastActivation is set */
+	int fastActivation;
+	int planActivation;
+
+	/* node values of a block of samples, used by executeChromosomeBatch */
+	double *blockValues;
+
+	/* outputs of every sample of one dataSet computed by executeChromosomesOffload, offloadDataSetId being 0 when not in use */
+	double *offloadOutputs;
+	int offloadNumSamples;
+	unsigned long offloadDataSetId;
+
+	/* the profile counting the work of the chromosome, NULL if not profiled */
+	struct profile *profile;
+
+	/* node values of every sample of recently used dataSets, see getNodeCache */
+	size_t nodeCacheSize;
+	struct nodeCache *nodeCache;
+	int *nodeRecompute;
+	unsigned long nodeCacheClock;
+};
+
+/*
+	the value of every node for every sample of one dataSet. A row is
+	valid when it holds the values of the node's current genes
+*/
+struct nodeCache {
+	unsigned long dataSetId;
+	unsigned long dataSetsOrder;
+	int numSamples;
+	unsigned long lastUsed;
+	double *values;
+	int *valid;
+	/* samples executed in order since the valid rows last changed, see executeChromosomeSamples */
+	int numFilledSamples;
 };
 
 struct node {
@@ -89,7 +214,6 @@ struct node {
 	int *inputs;
 	double *weights;
 	int active;
-	double output;
 	int maxArity;
 	int actArity;
 };
@@ -99,6 +223,9 @@ struct functionSet {
 	char functionNames[FUNCTIONSETSIZE][FUNCTIONNAMELENGTH];
 	int maxNumInputs[FUNCTIONSETSIZE];
 	double (*functions[FUNCTIONSETSIZE])(const int numInputs, const double *inputs, const double *connectionWeights);
+
+	/* the number of parameters and chromosomes referencing the function set, see retainFunctionSet */
+	int refCount;
 };
 
 struct dataSet {
@@ -107,6 +234,76 @@ struct dataSet {
 	int numOutputs;
 	double **inputData;
 	double **outputData;
+
+	/* contiguous row-major storage of the samples, indexed by inputData and outputData.
+	NULL for views, whose rows belong to other dataSets */
+	double *inputBlock;
+	double *outputBlock;
+
+	/* optional column-major copy of the inputs, built by getDataSetInputColumns
+	when dataSetsOrder was inputColumnsOrder */
+	double *inputColumns;
+	unsigned long inputColumnsOrder;
+
+	/* 1 once inputColumns is mapped to the offload device, see executeChromosomesOffload */
+	int offloadMapped;
+
+	/* unique to the samples held, used to key the chromosome node caches */
+	unsigned long id;
+
+	/* the mapped binary file of a streamed dataSet, whose samples are not
+	held in inputData and outputData but read a chunk at a time. NULL for
+	dataSets held in memory, see initialiseDataSetStreamFromBinaryFile */
+	struct dataStream *stream;
+};
+
+/*
+	the binary file of a streamed dataSet. The inputs and outputs of all
+	the samples are contiguous in the mapping and split into chunks of
+	chunkSize samples, each keyed in the node caches by its own id
+*/
+struct dataStream {
+	char *contents;
+	size_t size;
+	double *inputValues;
+	double *outputValues;
+	int chunkSize;
+	int numChunks;
+	unsigned long firstChunkId;
+};
+
+/*
+	the stratified mini-batches of a training dataSet, views of its
+	samples used in turn by runCGP and DE, see getMiniBatch
+*/
+struct miniBatches {
+	int numBatches;
+	struct dataSet **batches;
+};
+
+/*
+	what the stopping policies of a run have seen so far, see isRunStopped.
+	startTime is that of getProfileClock and lastImprovement is the
+	generation in which the best validation fitness last decreased
+*/
+struct stoppingState {
+	double startTime;
+	double bestFitnessValidation;
+	int lastImprovement;
+};
+
+/*
+	the chromosomes whose weights were evolved by DE in earlier generations
+	of CGPDE-IN, found by the hash of their active nodes. When full, the
+	least recently used chromosome is replaced, see addTopologyCache
+*/
+struct topologyCache {
+	int size;
+	int numChromos;
+	int clock;
+	unsigned long *hashes;
+	int *lastUses;
+	struct chromosome **chromos;
 };
 
 struct results {
@@ -114,30 +311,213 @@ struct results {
 	struct chromosome **bestChromosomes;
 };
 
+/*
+	the work counted while profiling, see setProfile. The times of the
+	phases are summed over the threads and the phases nest i.e. the time
+	of evaluation includes that of activeNodes and the time of DE includes
+	the evaluations of its trial vectors.
+*/
+struct profile {
+	unsigned long fitnessEvaluations;
+	unsigned long samplesExecuted;
+	unsigned long activeNodes;
+	unsigned long activeNodesUpdates;
+	unsigned long copies;
+	unsigned long mutations;
+	unsigned long DETrials;
+	unsigned long DETrialsAccepted;
+	double times[PROFILENUMPHASES];
+};
+
+/* the random number generators, see setRandomNumberGenerator */
+#define RANDOMGENERATORRANDR 0
+#define RANDOMGENERATORPCG 1
+
+/* the generator used by randDecimal and randInt, shared by every thread and so only set between runs */
+static int randomNumberGenerator = RANDOMGENERATORRANDR;
+
+/*
+	the number of times the samples of any dataSet have been reordered, see
+	shuffleData. The views of a dataSet share its rows and so a node cache
+	or column copy is only used while this is the same as when it was built
+*/
+static unsigned long dataSetsOrder = 0;
+
+/* the names of the phases of a profile, indexed by PROFILEEVALUATION etc. */
+static const char *profilePhaseNames[PROFILENUMPHASES] = {"evaluation", "activeNodes", "copy", "mutation", "DE"};
+
+/*
+	the folds of each round of an experiment and the training, validation
+	and testing sets and seed of each of its runs, one run per fold
+*/
+struct experiment {
+	struct parameters *params;
+	int numRounds;
+	struct dataSet ***folds;
+	struct dataSet **trainingData;
+	struct dataSet **validationData;
+	struct dataSet **testingData;
+	unsigned int *seeds;
+	int numAlgorithms;
+	int algorithms[EXPERIMENTNUMALGORITHMS];
+	int numGens[EXPERIMENTNUMALGORITHMS];
+	int saveDataSets;
+	double (*scoreFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *data);
+	char scoreName[FITNESSFUNCTIONNAMELENGTH];
+};
+
+/*
+	one (round, fold, algorithm) job of an experiment and its estimated cost
+*/
+struct experimentJob {
+	int run;
+	int algorithm;
+	double cost;
+};
+
 struct DEChromosome {
 	struct chromosome *chromo;
 	double *weightsVector;
 };
 
+/*
+	the start of the binary dataSet and chromosome files. The byte order
+	and version must match those of the CGP-Library reading the file
+*/
+struct binaryFileHeader {
+	char magic[8];
+	uint32_t byteOrder;
+	uint32_t version;
+	int32_t numRecords;
+	int32_t reserved;
+};
+
+/*
+	the dimensions of a binary dataSet, followed by the inputs and then
+	the outputs of every sample
+*/
+struct binaryDataSetRecord {
+	int32_t numInputs;
+	int32_t numOutputs;
+	int32_t numSamples;
+	int32_t reserved;
+};
+
+/*
+	the dimensions of a binary chromosome, followed by its function names,
+	connection weights, node functions, node inputs and outputs
+*/
+struct binaryChromosomeRecord {
+	int32_t numInputs;
+	int32_t numNodes;
+	int32_t numOutputs;
+	int32_t arity;
+	int32_t numFunctions;
+	int32_t generation;
+	double fitness;
+	double fitnessValidation;
+};
+
+/*
+	the state of a run saved by setCheckpoint, followed by its chromosomes
+	in the binary chromosome format. generation is the number of generations
+	completed and iteration the number of DE iterations of CGPDE-OUT
+	completed, -1 before its DE begins. lastImprovement is that of the
+	stoppingState of the generations, whose best validation fitness is
+	that of the saved best chromosome
+*/
+struct binaryCheckpointRecord {
+	int32_t algorithm;
+	int32_t generation;
+	int32_t iteration;
+	uint32_t seed;
+	int32_t lastImprovement;
+	int32_t reserved;
+};
+
 /*
 	Prototypes of functions used internally to CGP-Library
 */
 
 /* DE functions */
 static void transferWeightsVectorToChromo(struct parameters *params, struct DEChromosome *DEChromo);
-static int getNumChromosomeWeights(struct chromosome *chromo);
+static void transferChromoToWeightsVector(struct parameters *params, struct DEChromosome *DEChromo);
+static int getNumChromosomeWeights(struct parameters *params, struct chromosome *chromo);
+static void setDEChromosomeFitness(struct parameters *params, struct DEChromosome *DEChromo, struct dataSet *data, double cutoff);
+static void setDETrialVector(struct parameters *params, struct DEChromosome **DEChromos, int NP, int i, int numWeights, double *trialVector, unsigned int * seed);
+static struct DEChromosome *allocateDEChromosome(struct chromosome *chromo, int numWeights, unsigned int * seed);
+static void setDEPopulationWeights(struct parameters *params, struct DEChromosome **DEChromos, int NP, int numWeights, struct dataSet *data, unsigned int * seed);
+static void evolveDEPopulation(struct parameters *params, struct DEChromosome **DEChromos, struct DEChromosome **DEChromos_u, int NP, int firstIter, int maxIter, int numWeights, struct dataSet *dataTrain, struct chromosome *checkpointChromo, struct stoppingState *stopping, unsigned int * seed);
+static struct chromosome **runDEFromCheckpoint(struct parameters *params, struct chromosome *chromo, struct dataSet *dataTrain, struct dataSet *dataValid, int type, int checkpoint, char const *checkpointFile, struct stoppingState *stopping, unsigned int * seed);
+static int isDEPopulationConverged(struct parameters *params, struct DEChromosome **DEChromos, int NP, int numWeights);
+static struct topologyCache *initialiseTopologyCache(struct parameters *params);
+static void freeTopologyCache(struct topologyCache *cache);
+static unsigned long getChromosomeTopologyHash(struct chromosome *chromo);
+static struct chromosome *getTopologyCache(struct topologyCache *cache, struct chromosome *chromo);
+static void addTopologyCache(struct topologyCache *cache, struct chromosome *chromo);
+static void copyChromosomeActiveWeights(struct chromosome *chromoDest, struct chromosome *chromoSrc);
+static void setDEPopulationFitness(struct parameters *params, struct DEChromosome **DEChromos, int NP, struct dataSet *data);
 
 /* chromosome functions */
 static void setChromosomeActiveNodes(struct chromosome *chromo);
-static void recursivelySetActiveNodes(struct chromosome *chromo, int nodeIndex);
-static int recursivelySearchDepth(struct chromosome *chromo, int nodeIndex, int currentDepth, int *maxDepth, int * depthPerNode, int * buffer);
+static void compileChromosome(struct chromosome *chromo);
+static int getActivation(double (*function)(const int numInputs, const double *inputs, const double *connectionWeights));
+static struct chromosome *allocateChromosome(int numInputs, int numNodes, int numOutputs, int arity);
+static size_t getChromosomePartOffset(size_t *size, size_t partSize);
+static void executeChromosomeBlock(struct chromosome *chromo, struct dataSet *data, int firstSample, int numSamples, void (**blockFunctions)(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs), struct nodeCache *cache, double *outputs);
+static void setBlockFunctions(struct functionSet *funcSet, void (**blockFunctions)(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs));
+static struct nodeCache *getNodeCache(struct chromosome *chromo, struct dataSet *data);
+static void initialiseNodeCache(struct chromosome *chromo);
+static void freeNodeCache(struct chromosome *chromo);
+static void setNodeCacheDirty(struct chromosome *chromo, int nodeIndex);
+static void clearNodeCache(struct chromosome *chromo);
+static void copyNodeCache(struct chromosome *chromoDest, struct chromosome *chromoSrc);
 static void sortChromosomeArray(struct chromosome **chromoArray, int numChromos);
 static void getBestChromosome(struct chromosome **parents, struct chromosome **children, int numParents, int numChildren, struct chromosome *best);
+static void setChromosomesFitness(struct parameters *params, struct chromosome **chromos, int numChromos, struct chromosome **parents, int numParents, struct dataSet *dataTrain, struct dataSet *dataValid, int validation, double cutoff);
+static void setChromosomeFitnessBounded(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff);
+static double getChildrenFitnessCutoff(struct parameters *params, struct chromosome **parents);
+static struct miniBatches *initialiseMiniBatches(struct parameters *params, struct dataSet *data);
+static void freeMiniBatches(struct miniBatches *batches);
+static struct dataSet *getMiniBatch(struct parameters *params, struct miniBatches *batches, struct dataSet *data, int iteration);
+static void initialiseStoppingState(struct stoppingState *stopping, struct chromosome *best, int generation);
+static int isRunStopped(struct parameters *params, struct stoppingState *stopping, struct chromosome **parents, struct chromosome *best, struct dataSet *batchTrain, struct dataSet *dataTrain, int generation);
+static int isTimeBudgetSpent(struct parameters *params, struct stoppingState *stopping);
+static int getIdenticalChromosome(struct chromosome *chromo, struct chromosome **chromos, int numChromos);
+static void executeChromosomesOffload(struct parameters *params, struct chromosome **chromos, int numChromos, struct dataSet *data);
+static void clearOffloadOutputs(struct chromosome **chromos, int numChromos);
+static void runSteadyStateTask(struct parameters *params, struct chromosome **parents, struct chromosome *best, struct dataSet *dataTrain, struct dataSet *dataValid, int typeCGP, unsigned int taskSeed);
+static void runSteadyStateDETask(struct parameters *params, struct chromosome **parents, struct chromosome *best, struct chromosome *child, struct dataSet *dataTrain, struct dataSet *dataValid, unsigned int taskSeed);
+static void insertSteadyStateChild(struct parameters *params, struct chromosome **parents, struct chromosome *best, struct chromosome *child);
+static void migrateChromosomes(struct parameters *params, struct chromosome **parents, struct dataSet *dataTrain, struct dataSet *dataValid, unsigned int * seed);
+#ifdef CGPDE_MPI
+static void mpiMigrationTransport(void *context, int destination, const char *sendBuffer, size_t sendSize, int source, char **receiveBuffer, size_t *receiveSize);
+#endif
+static double getExperimentJobCost(struct parameters *params, int algorithm, int numGens);
+static int cmpExperimentJob(const void *a, const void *b);
+static void runExperimentJob(struct experiment *experiment, struct experimentJob *job, FILE **resultsFiles);
+static struct chromosome* runCGPFromCheckpoint(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, char const *checkpointFile, unsigned int * seed);
+static struct chromosome* runCGPDE_INFromCheckpoint(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, char const *checkpointFile, unsigned int * seed);
+static struct chromosome** runCGPDE_OUTFromCheckpoint(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, char const *checkpointFile, unsigned int * seed);
+static void saveExperimentDataSet(struct dataSet *data, char const *directory, char const *set, int round, int fold);
 static void saveChromosomeLatexRecursive(struct chromosome *chromo, int index, FILE *fp);
+static int saveChromosomeCNode(struct chromosome *chromo, int step, char const *functionName, FILE *fp);
+static void saveChromosomeCInputs(struct chromosome *chromo, const int *slots, int numSlots, char const *format, char const *separator, FILE *fp);
+static char *getBinaryChromosomes(struct chromosome **chromos, int numChromos, size_t *bufferSize);
+static void setBinaryChromosomeGenes(struct chromosome *chromo, const char *record);
+static size_t getBinaryChromosomeSize(struct binaryChromosomeRecord *record, size_t *weightsOffset, size_t *functionsOffset, size_t *inputsOffset, size_t *outputsOffset);
+static int isBinaryChromosomeFunctionSet(const char *record, struct functionSet *funcSet);
+static const char *getBinaryFileRecords(char const *file, const char *contents, size_t size, const char *magic, int *numRecords);
+static const char *getBinaryDataSetValues(char const *file, const char *contents, size_t size, struct binaryDataSetRecord *record);
+static void saveCheckpoint(struct parameters *params, struct binaryCheckpointRecord *checkpointRecord, struct chromosome **chromos, int numChromos);
+static void loadCheckpoint(struct parameters *params, char const *file, int algorithm, struct binaryCheckpointRecord *checkpointRecord, struct chromosome **chromos, int numChromos);
+static void saveCGPCheckpoint(struct parameters *params, int algorithm, int generation, struct chromosome **parents, struct chromosome **children, struct chromosome *best, struct stoppingState *stopping, unsigned int * seed);
+static int loadCGPCheckpoint(struct parameters *params, char const *file, int algorithm, struct chromosome **parents, struct chromosome **children, struct chromosome *best, struct stoppingState *stopping, unsigned int * seed);
+static void saveDECheckpoint(struct parameters *params, int iteration, struct chromosome *chromo, struct DEChromosome **DEChromos, int NP, unsigned int * seed);
+static int loadDECheckpoint(struct parameters *params, char const *file, struct chromosome *chromo, struct DEChromosome **DEChromos, int NP, unsigned int * seed);
 
 /* node functions */
-static struct node *initialiseNode(int numInputs, int numNodes, int arity, int numFunctions, double connectionWeightRange, double recurrentConnectionProbability, int nodePosition, unsigned int * seed);
-static void freeNode(struct node *n);
+static void initialiseNode(struct node *n, int numInputs, int numNodes, int arity, int numFunctions, double connectionWeightRange, double recurrentConnectionProbability, int nodePosition, unsigned int * seed);
 static void copyNode(struct node *nodeDest, struct node *nodeSrc);
 
 /* getting gene value functions  */
@@ -149,8 +529,33 @@ static int getRandomChromosomeOutput(int numInputs, int numNodes, int shortcutCo
 /* function set functions */
 static int addPresetFunctionToFunctionSet(struct parameters *params, char const *functionName);
 static void copyFunctionSet(struct functionSet *funcSetDest, struct functionSet *funcSetSrc);
+static struct functionSet *retainFunctionSet(struct functionSet *funcSet);
+static void releaseFunctionSet(struct functionSet *funcSet);
+static struct functionSet *getWritableFunctionSet(struct parameters *params);
 static void printFunctionSet(struct parameters *params);
 
+/* dataSet functions */
+static struct dataSet *allocateDataSet(int numInputs, int numOutputs, int numSamples);
+static struct dataSet *allocateDataSetView(int numInputs, int numOutputs, int numSamples);
+static void copyDataSetSamples(struct dataSet *dataDest, int firstSample, struct dataSet *dataSrc);
+static struct dataSet *initialiseDataSetViewFromFolds(struct dataSet **folds, const int *foldIndexes, int numFolds);
+static void freeDataSetColumns(struct dataSet *data);
+static char *mapFileContents(char const *file, size_t *size);
+static void unmapFileContents(char *contents, size_t size);
+static int isDataSetSeparator(char c);
+static int isDataSetLineBlank(const char *pos, const char *lineEnd);
+static const char *getDataSetLineStart(const char *pos, const char *end);
+static const char *parseDataSetValue(const char *pos, const char *lineEnd, double *value);
+static int parseDataSetLine(const char *pos, const char *lineEnd, double *inputs, int numInputs, double *outputs, int numOutputs);
+static unsigned long getNewDataSetId(void);
+static unsigned long getNewDataSetIds(int numIds);
+static void checkDataSetInMemory(struct dataSet *data, char const *functionName);
+static int *getStratifiedSampleOrder(struct dataSet *data);
+static void adviseDataStreamChunk(struct dataStream *stream, int numInputs, int numOutputs, int chunk, int needed);
+static void executeChromosomeStreamSamples(struct chromosome *chromo, struct dataSet *data, int firstSample, int numSamples, double *outputs);
+static double *alignedMalloc(size_t size);
+static void alignedFree(double *ptr);
+
 /* results functions */
 struct results* initialiseResults(struct parameters *params, int numRuns);
 
@@ -158,17 +563,20 @@ struct results* initialiseResults(struct parameters *params, int numRuns);
 static void probabilisticMutation(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed);
 static void pointMutation(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed);
 static void pointMutationANN(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed);
+static void probabilisticMutationSkip(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed);
 static void probabilisticMutationOnlyActive(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed);
 static void singleMutation(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed);
 
 /* selection scheme functions */
 static void selectFittest(struct parameters *params, struct chromosome **parents, struct chromosome **candidateChromos, int numParents, int numCandidateChromos);
+static void selectParents(struct parameters *params, struct chromosome **parents, struct chromosome **children, struct chromosome **candidateChromos, struct chromosome **rankedChromos, int numCandidateChromos);
 
 /* reproduction scheme functions */
 static void mutateRandomParent(struct parameters *params, struct chromosome **parents, struct chromosome **children, int numParents, int numChildren, int type, unsigned int * seed);
 
 /* fitness function */
 static double supervisedLearning(struct parameters *params, struct chromosome *chromo, struct dataSet *data);
+static double supervisedLearningBounded(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff);
 
 /* node functions defines in CGP-Library */
 static double _add(const int numInputs, const double *inputs, const double *connectionWeights);
@@ -202,9 +610,36 @@ static double _step(const int numInputs, const double *inputs, const double *con
 static double _softsign(const int numInputs, const double *inputs, const double *connectionWeights);
 static double _hyperbolicTangent(const int numInputs, const double *inputs, const double *connectionWeights);
 
+/* node functions evaluated over a block of samples */
+static void sumWeigtedInputsBlock(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs);
+static void _sigmoidBlock(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs);
+static void _gaussianBlock(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs);
+static void _stepBlock(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs);
+static void _softsignBlock(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs);
+static void _hyperbolicTangentBlock(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs);
+
+/* activations computed by the fast evaluator, which are also executed on the offload device */
+#pragma omp declare target
+static double getFastActivation(const int activation, const double weightedInputSum);
+static inline double fastExp(double x);
+static void executeOffloadSample(const int numInputs, const int numOutputs, const int arity, const int numActive, const int activation, const int *planArity, const int *planSlots, const int *planInputs, const double *planWeights, const int *outputNodes, const double *columns, const int numSamples, double *values, double *outputs);
+#pragma omp end declare target
+static void getFastActivationBlock(const int activation, const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs);
+
+/* profile functions */
+static double getProfileClock(void);
+static void addProfileTime(struct profile *prof, int phase, double start);
+static void addProfileCount(unsigned long *counter, unsigned long n);
+static void addProfileEvaluation(struct profile *prof, struct chromosome *chromo, double start);
+static void logProfile(struct parameters *params, int generation);
+
 /* other */
 static double randDecimal(unsigned int * seed);
+static void randDecimals(double *decimals, int n, unsigned int * seed);
 static int randInt(int n, unsigned int * seed);
+static unsigned int randSeed(unsigned int * seed);
+static unsigned int randPCG(unsigned int * state);
+static int getRandomGeneSkip(double mutationRate, int numGenes, unsigned int * seed);
 static double sumWeigtedInputs(const int numInputs, const double *inputs, const double *connectionWeights);
 static void sortIntArray(int *array, const int length);
 static void sortDoubleArray(double *array, const int length);
@@ -238,7 +673,9 @@ DLL_EXPORT struct parameters *initialiseParameters(const int numInputs, const in
 	params->connectionWeightRange = 1;
 	params->shortcutConnections = 1;
 
-	params->targetFitness = 0.0;
+	params->targetFitness = -DBL_MAX;
+	params->maxStallGenerations = 0;
+	params->timeBudget = 0.0;
 
 	setNumInputs(params, numInputs);
 	setNumNodes(params, numNodes);
@@ -252,15 +689,22 @@ DLL_EXPORT struct parameters *initialiseParameters(const int numInputs, const in
 	params->maxIter_OUT = 100;
 	params->CR = 0.50;
 	params->F = 1.0;
+	params->synchronousDE = 0;
+	params->activeWeightsDE = 0;
+	params->recycleDEPopulation = 0;
+	params->minDiversityDE = 0.0;
+	params->topologyCacheSize = 0;
 
 	params->mutationType = probabilisticMutation;
 	strncpy(params->mutationTypeName, "probabilistic", MUTATIONTYPENAMELENGTH);
 
 	params->funcSet = (struct functionSet*)malloc(sizeof(struct functionSet));
 	params->funcSet->numFunctions = 0;
+	params->funcSet->refCount = 1;
 
 	params->fitnessFunction = supervisedLearning;
 	strncpy(params->fitnessFunctionName, "supervisedLearning", FITNESSFUNCTIONNAMELENGTH);
+	params->boundedFitnessFunction = supervisedLearningBounded;
 
 	params->selectionScheme = selectFittest;
 	strncpy(params->selectionSchemeName, "selectFittest", SELECTIONSCHEMENAMELENGTH);
@@ -270,6 +714,32 @@ DLL_EXPORT struct parameters *initialiseParameters(const int numInputs, const in
 
 	params->numThreads = 1;
 
+	params->fitnessMemoisation = 1;
+
+	params->nodeCacheSize = 0;
+
+	params->fastActivation = 0;
+
+	params->offloadEvaluation = 0;
+
+	params->miniBatchSize = 0;
+	params->fullEvaluationInterval = 10;
+
+	params->migrationInterval = 0;
+	params->numMigrants = 1;
+	params->migrationTopology = MIGRATIONRING;
+	params->island = 0;
+	params->numIslands = 1;
+	params->migrationTransport = NULL;
+	params->migrationContext = NULL;
+
+	params->profile = NULL;
+	params->profileLogInterval = 0;
+	params->profileLog = NULL;
+
+	params->checkpointInterval = 0;
+	params->checkpointFile[0] = '\0';
+
 	return params;
 }
 
@@ -285,7 +755,7 @@ DLL_EXPORT void freeParameters(struct parameters *params) {
 		return;
 	}
 
-	free(params->funcSet);
+	releaseFunctionSet(params->funcSet);
 	free(params);
 }
 
@@ -312,10 +782,36 @@ DLL_EXPORT void printParameters(struct parameters *params) {
 	printf("Mutation rate:\t\t\t\t%f\n", params->mutationRate);
 	printf("Recurrent Connection Probability:\t%f\n", params->recurrentConnectionProbability);
 	printf("Shortcut Connections:\t\t\t%d\n", params->shortcutConnections);
+	if (params->targetFitness == -DBL_MAX) {
+		printf("Target Fitness:\t\t\t\tnone\n");
+	}
+	else {
+		printf("Target Fitness:\t\t\t\t%g\n", params->targetFitness);
+	}
+	printf("Max Stall Generations:\t\t\t%d\n", params->maxStallGenerations);
+	printf("Time Budget:\t\t\t\t%f s\n", params->timeBudget);
 	printf("Fitness Function:\t\t\t%s\n", params->fitnessFunctionName);
+	printf("Bounded Fitness Function:\t\t%d\n", params->boundedFitnessFunction != NULL);
 	printf("Selection scheme:\t\t\t%s\n", params->selectionSchemeName);
 	printf("Reproduction scheme:\t\t\t%s\n", params->reproductionSchemeName);
 	printf("Threads:\t\t\t\t%d\n", params->numThreads);
+	printf("Fitness Memoisation:\t\t\t%d\n", params->fitnessMemoisation);
+	printf("Node Cache Size:\t\t\t%d MB\n", params->nodeCacheSize);
+	printf("Fast Activation:\t\t\t%d\n", params->fastActivation);
+	printf("Offload Evaluation:\t\t\t%d\n", params->offloadEvaluation);
+	printf("Mini-Batch Size:\t\t\t%d\n", params->miniBatchSize);
+	printf("Full Evaluation Interval:\t\t%d\n", params->fullEvaluationInterval);
+	printf("Island:\t\t\t\t\t%d of %d\n", params->island, params->numIslands);
+	printf("Migration Interval:\t\t\t%d\n", params->migrationInterval);
+	printf("Migrants:\t\t\t\t%d\n", params->numMigrants);
+	printf("Migration Topology:\t\t\t%s\n", params->migrationTopology == MIGRATIONRING ? "ring" : "complete");
+	printf("Synchronous DE:\t\t\t\t%d\n", params->synchronousDE);
+	printf("Active Weights DE:\t\t\t%d\n", params->activeWeightsDE);
+	printf("Recycle DE Population:\t\t\t%d\n", params->recycleDEPopulation);
+	printf("Min Diversity DE:\t\t\t%f\n", params->minDiversityDE);
+	printf("Topology Cache Size:\t\t\t%d\n", params->topologyCacheSize);
+	printf("Profile:\t\t\t\t%d\n", params->profile != NULL);
+	printf("Checkpoint Interval:\t\t\t%d\n", params->checkpointInterval);
 	printFunctionSet(params);
 	printf("-----------------------------------------------------------\n\n");
 }
@@ -360,21 +856,26 @@ DLL_EXPORT void addNodeFunction(struct parameters *params, char const *functionN
 */
 DLL_EXPORT void addCustomNodeFunction(struct parameters *params, double (*function)(const int numInputs, const double *inputs, const double *weights), char const *functionName, int maxNumInputs) {
 
+	struct functionSet *funcSet;
+
 	if (params->funcSet->numFunctions >= FUNCTIONSETSIZE) {
 		printf("Warning: functions set has reached maximum capacity (%d). Function '%s' not added.\n", FUNCTIONSETSIZE, functionName);
 		return;
 	}
 
+	/* chromosomes sharing the function set keep it unchanged */
+	funcSet = getWritableFunctionSet(params);
+
 	/* set the function name as the given function name */
-	strncpy(params->funcSet->functionNames[params->funcSet->numFunctions], functionName, FUNCTIONNAMELENGTH);
+	strncpy(funcSet->functionNames[funcSet->numFunctions], functionName, FUNCTIONNAMELENGTH);
 
 	/* set the number of function inputs as the given number of function inputs */
-	params->funcSet->maxNumInputs[params->funcSet->numFunctions] = maxNumInputs;
+	funcSet->maxNumInputs[funcSet->numFunctions] = maxNumInputs;
 
 	/* add the given function to the function set */
-	params->funcSet->functions[params->funcSet->numFunctions] = function;
+	funcSet->functions[funcSet->numFunctions] = function;
 
-	params->funcSet->numFunctions++;
+	funcSet->numFunctions++;
 }
 
 
@@ -502,7 +1003,7 @@ static int addPresetFunctionToFunctionSet(struct parameters *params, char const
 	clears the given function set of functions
 */
 DLL_EXPORT void clearFunctionSet(struct parameters *params) {
-	params->funcSet->numFunctions = 0;
+	getWritableFunctionSet(params)->numFunctions = 0;
 }
 
 
@@ -613,13 +1114,40 @@ DLL_EXPORT void setEvolutionaryStrategy(struct parameters *params, char evolutio
 }
 
 /*
-	Sets the target fitness
+	Sets the target fitness, the runs stop once a parent is at least as fit
 */
 DLL_EXPORT void setTargetFitness(struct parameters *params, double targetFitness) {
 
 	params->targetFitness = targetFitness;
 }
 
+/*
+	Sets the number of generations without a decrease of the best
+	validation fitness after which the runs stop, 0 to never stop
+*/
+DLL_EXPORT void setMaxStallGenerations(struct parameters *params, int maxStallGenerations) {
+
+	if (maxStallGenerations < 0) {
+		printf("\nWarning: max stall generations of %d is invalid. The max stall generations must be >= 0. The max stall generations has been left unchanged as %d.\n", maxStallGenerations, params->maxStallGenerations);
+		return;
+	}
+
+	params->maxStallGenerations = maxStallGenerations;
+}
+
+/*
+	Sets the wall-clock seconds after which the runs stop, 0 for no budget
+*/
+DLL_EXPORT void setTimeBudget(struct parameters *params, double timeBudget) {
+
+	if (timeBudget < 0) {
+		printf("\nWarning: time budget of %f is invalid. The time budget must be >= 0. The time budget has been left unchanged as %f.\n", timeBudget, params->timeBudget);
+		return;
+	}
+
+	params->timeBudget = timeBudget;
+}
+
 /*
 	Sets the mutation rate given in parameters. If an invalid mutation
 	rate is given a warning is displayed and the mutation rate is left
@@ -684,14 +1212,28 @@ DLL_EXPORT void setCustomFitnessFunction(struct parameters *params, double (*fit
 	if (fitnessFunction == NULL) {
 		params->fitnessFunction = supervisedLearning;
 		strncpy(params->fitnessFunctionName, "supervisedLearning", FITNESSFUNCTIONNAMELENGTH);
+		params->boundedFitnessFunction = supervisedLearningBounded;
 	}
 	else {
 		params->fitnessFunction = fitnessFunction;
 		strncpy(params->fitnessFunctionName, fitnessFunctionName, FITNESSFUNCTIONNAMELENGTH);
+		params->boundedFitnessFunction = NULL;
 	}
 }
 
 
+/*
+	sets the bounded form of the current fitness function. It must give the
+	same fitness as the fitness function whenever that fitness is not greater
+	than the cutoff and otherwise any fitness greater than the cutoff.
+	If the boundedFitnessFunction is NULL the fitness function is always used.
+*/
+DLL_EXPORT void setCustomBoundedFitnessFunction(struct parameters *params, double (*boundedFitnessFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff)) {
+
+	params->boundedFitnessFunction = boundedFitnessFunction;
+}
+
+
 
 /*
 	sets the selection scheme used to select the parents from the candidate chromosomes. If the selectionScheme is NULL
@@ -784,6 +1326,208 @@ DLL_EXPORT void setNumThreads(struct parameters *params, int numThreads) {
 	params->numThreads = numThreads;
 }
 
+/*
+	sets whether children identical to a parent reuse its fitness in parameters
+*/
+DLL_EXPORT void setFitnessMemoisation(struct parameters *params, int fitnessMemoisation) {
+
+	/* error checking */
+	if (fitnessMemoisation != 0 && fitnessMemoisation != 1) {
+		printf("Warning: fitness memoisation must be 0 or 1; %d is invalid. Fitness memoisation is left unchanged as %d.\n", fitnessMemoisation, params->fitnessMemoisation);
+		return;
+	}
+
+	params->fitnessMemoisation = fitnessMemoisation;
+}
+
+/*
+	sets the memory in megabytes each chromosome may use to cache node values in parameters
+*/
+DLL_EXPORT void setNodeCacheSize(struct parameters *params, int nodeCacheSize) {
+
+	/* error checking */
+	if (nodeCacheSize < 0) {
+		printf("Warning: node cache size cannot be less than zero; %d is invalid. The node cache size is left unchanged as %d.\n", nodeCacheSize, params->nodeCacheSize);
+		return;
+	}
+
+	params->nodeCacheSize = nodeCacheSize;
+}
+
+/*
+	sets whether chromosomes whose active nodes share one activation function are evaluated by the fast evaluator in parameters
+	0: every node is evaluated by its node function
+	1: sig, tanh, softsign and gauss chromosomes are evaluated with the activation inlined and an approximate exp
+*/
+DLL_EXPORT void setFastActivation(struct parameters *params, int fastActivation) {
+
+	/* error checking */
+	if (fastActivation != 0 && fastActivation != 1) {
+		printf("Warning: fast activation must be 0 or 1; %d is invalid.\nTerminating CGP-Library.\n", fastActivation);
+		exit(0);
+	}
+
+	params->fastActivation = fastActivation;
+}
+
+/*
+	sets whether populations are evaluated together on the offload device in parameters
+	0: every chromosome is executed on its own
+	1: the fast evaluator chromosomes of a population are executed together by executeChromosomesOffload
+*/
+DLL_EXPORT void setOffloadEvaluation(struct parameters *params, int offloadEvaluation) {
+
+	/* error checking */
+	if (offloadEvaluation != 0 && offloadEvaluation != 1) {
+		printf("Warning: offload evaluation must be 0 or 1; %d is invalid.\nTerminating CGP-Library.\n", offloadEvaluation);
+		exit(0);
+	}
+
+	params->offloadEvaluation = offloadEvaluation;
+}
+
+/*
+	sets the number of training samples each mini-batch holds in parameters
+	0: every candidate is evaluated on all the training samples
+*/
+DLL_EXPORT void setMiniBatchSize(struct parameters *params, int miniBatchSize) {
+
+	/* error checking */
+	if (miniBatchSize < 0) {
+		printf("Warning: mini-batch size cannot be less than zero; %d is invalid. The mini-batch size is left unchanged as %d.\n", miniBatchSize, params->miniBatchSize);
+		return;
+	}
+
+	params->miniBatchSize = miniBatchSize;
+}
+
+/*
+	sets the number of generations or DE iterations between those evaluated on all the training samples in parameters
+*/
+DLL_EXPORT void setFullEvaluationInterval(struct parameters *params, int fullEvaluationInterval) {
+
+	/* error checking */
+	if (fullEvaluationInterval < 1) {
+		printf("Warning: full evaluation interval cannot be less than one; %d is invalid. The full evaluation interval is left unchanged as %d.\n", fullEvaluationInterval, params->fullEvaluationInterval);
+		return;
+	}
+
+	params->fullEvaluationInterval = fullEvaluationInterval;
+}
+
+/*
+	sets the number of generations between migrations of the island model in parameters
+*/
+DLL_EXPORT void setMigrationInterval(struct parameters *params, int migrationInterval) {
+
+	/* error checking */
+	if (migrationInterval < 0) {
+		printf("Warning: migration interval cannot be less than zero; %d is invalid. The migration interval is left unchanged as %d.\n", migrationInterval, params->migrationInterval);
+		return;
+	}
+
+	params->migrationInterval = migrationInterval;
+}
+
+/*
+	sets the number of chromosomes each island sends to each of its neighbours in parameters
+*/
+DLL_EXPORT void setNumMigrants(struct parameters *params, int numMigrants) {
+
+	/* error checking */
+	if (numMigrants < 1) {
+		printf("Warning: number of migrants cannot be less than one; %d is invalid. The number of migrants is left unchanged as %d.\n", numMigrants, params->numMigrants);
+		return;
+	}
+
+	params->numMigrants = numMigrants;
+}
+
+/*
+	sets the neighbours of each island, "ring" or "complete", in parameters
+*/
+DLL_EXPORT void setMigrationTopology(struct parameters *params, char const *migrationTopology) {
+
+	if (strcmp(migrationTopology, "ring") == 0) {
+		params->migrationTopology = MIGRATIONRING;
+	}
+
+	else if (strcmp(migrationTopology, "complete") == 0) {
+		params->migrationTopology = MIGRATIONCOMPLETE;
+	}
+
+	else {
+		printf("Warning: migration topology '%s' is invalid. The migration topology must be 'ring' or 'complete'. The migration topology has been left unchanged as '%s'.\n", migrationTopology, params->migrationTopology == MIGRATIONRING ? "ring" : "complete");
+	}
+}
+
+/*
+	sets the island of the calling process and the transport used to exchange
+	migrants with the other islands in parameters. If the transport is NULL
+	no migrants are exchanged
+*/
+DLL_EXPORT void setCustomMigrationTransport(struct parameters *params, int island, int numIslands, void (*migrationTransport)(void *context, int destination, const char *sendBuffer, size_t sendSize, int source, char **receiveBuffer, size_t *receiveSize), void *context) {
+
+	/* error checking */
+	if (numIslands < 1 || island < 0 || island >= numIslands) {
+		printf("Error: island %d of %d islands is invalid.\nTerminating CGP-Library.\n", island, numIslands);
+		exit(0);
+	}
+
+	if (migrationTransport == NULL) {
+		params->island = 0;
+		params->numIslands = 1;
+		params->migrationTransport = NULL;
+		params->migrationContext = NULL;
+	}
+	else {
+		params->island = island;
+		params->numIslands = numIslands;
+		params->migrationTransport = migrationTransport;
+		params->migrationContext = context;
+	}
+}
+
+#ifdef CGPDE_MPI
+/*
+	sets the island of the calling process to its rank in MPI_COMM_WORLD and
+	exchanges the migrants using MPI. MPI must already be initialised
+*/
+DLL_EXPORT void setMPIMigrationTransport(struct parameters *params) {
+
+	int rank, size;
+
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	setCustomMigrationTransport(params, rank, size, mpiMigrationTransport, NULL);
+}
+#endif
+
+/*
+	sets the number of generations between the checkpoints of runCGP,
+	runCGPDE_IN and runCGPDE_OUT, and the file they are saved to, in parameters
+*/
+DLL_EXPORT void setCheckpoint(struct parameters *params, int checkpointInterval, char const *fileName) {
+
+	/* error checking */
+	if (checkpointInterval < 0) {
+		printf("Warning: checkpoint interval cannot be less than zero; %d is invalid. The checkpoint interval is left unchanged as %d.\n", checkpointInterval, params->checkpointInterval);
+		return;
+	}
+
+	if (checkpointInterval > 0 && (fileName == NULL || strlen(fileName) == 0 || strlen(fileName) >= CHECKPOINTFILENAMELENGTH)) {
+		printf("Warning: the checkpoint file name must have between 1 and %d characters. The checkpoint interval is left unchanged as %d.\n", CHECKPOINTFILENAMELENGTH - 1, params->checkpointInterval);
+		return;
+	}
+
+	params->checkpointInterval = checkpointInterval;
+
+	if (checkpointInterval > 0) {
+		strcpy(params->checkpointFile, fileName);
+	}
+}
+
 /*
 	sets d.e. population size in parameters (CGPDE-IN)
 */
@@ -869,54 +1613,115 @@ DLL_EXPORT void setF(struct parameters *params, double f) {
 }
 
 /*
-	chromosome function definitions
+	sets whether the d.e. population is updated synchronously in parameters
+	0: each trial vector replaces its target as soon as it is evaluated
+	1: the trial vectors of each iteration are built and evaluated together
 */
+DLL_EXPORT void setSynchronousDE(struct parameters *params, int synchronousDE) {
+
+	/* error checking */
+	if (synchronousDE != 0 && synchronousDE != 1) {
+		printf("Warning: synchronous de must be 0 or 1; %d is invalid.\nTerminating CGP-Library.\n", synchronousDE);
+		exit(0);
+	}
 
+	params->synchronousDE = synchronousDE;
+}
 
 /*
-	Returns a pointer to an initialised chromosome with values obeying the given parameters.
+	sets whether the d.e. weights vector is restricted to the active connections in parameters
+	0: the weights of every node input
+	1: only the weights of the used inputs of the active nodes
 */
-DLL_EXPORT struct chromosome *initialiseChromosome(struct parameters *params, unsigned int * seed) {
-
-	struct chromosome *chromo;
-	int i;
+DLL_EXPORT void setActiveWeightsDE(struct parameters *params, int activeWeightsDE) {
 
-	/* check that funcSet contains functions */
-	if (params->funcSet->numFunctions < 1) {
-		printf("Error: chromosome not initialised due to empty functionSet.\nTerminating CGP-Library.\n");
+	/* error checking */
+	if (activeWeightsDE != 0 && activeWeightsDE != 1) {
+		printf("Warning: active weights de must be 0 or 1; %d is invalid.\nTerminating CGP-Library.\n", activeWeightsDE);
 		exit(0);
 	}
 
-	/* allocate memory for chromosome */
-	chromo = (struct chromosome*)malloc(sizeof(struct chromosome));
-
-	/* allocate memory for nodes */
-	chromo->nodes = (struct node**)malloc(params->numNodes * sizeof(struct node*));
+	params->activeWeightsDE = activeWeightsDE;
+}
 
-	/* allocate memory for outputNodes matrix */
-	chromo->outputNodes = (int*)malloc(params->numOutputs * sizeof(int));
+/*
+	sets whether CGPDE-IN recycles its d.e. population across generations in parameters
+	0: a new d.e. population is allocated by every generation
+	1: one d.e. population is allocated and reset by every generation
+*/
+DLL_EXPORT void setRecycleDEPopulation(struct parameters *params, int recycleDEPopulation) {
 
-	/* allocate memory for active nodes matrix */
-	chromo->activeNodes = (int*)malloc(params->numNodes * sizeof(int));
+	/* error checking */
+	if (recycleDEPopulation != 0 && recycleDEPopulation != 1) {
+		printf("Warning: recycle de population must be 0 or 1; %d is invalid.\nTerminating CGP-Library.\n", recycleDEPopulation);
+		exit(0);
+	}
 
-	/* allocate memory for chromosome outputValues */
-	chromo->outputValues = (double*)malloc(params->numOutputs * sizeof(double));
+	params->recycleDEPopulation = recycleDEPopulation;
+}
 
-	/* Initialise each of the chromosomes nodes */
-	for (i = 0; i < params->numNodes; i++) {
-		chromo->nodes[i] = initialiseNode(params->numInputs, params->numNodes, params->arity, params->funcSet->numFunctions, params->connectionWeightRange, params->recurrentConnectionProbability, i, seed);
-	}
+/*
+	sets the diversity of the d.e. population below which d.e. stops in parameters,
+	the mean over the weights of their standard deviation in the population.
+	0 never stops d.e. early
+*/
+DLL_EXPORT void setMinDiversityDE(struct parameters *params, double minDiversityDE) {
 
-	/* set each of the chromosomes outputs */
-	for (i = 0; i < params->numOutputs; i++) {
-		chromo->outputNodes[i] = getRandomChromosomeOutput(params->numInputs, params->numNodes, params->shortcutConnections, seed);
+	/* error checking */
+	if (minDiversityDE < 0) {
+		printf("\nWarning: min diversity de of %f is invalid. The min diversity de must be >= 0. The min diversity de has been left unchanged as %f.\n", minDiversityDE, params->minDiversityDE);
+		return;
 	}
 
-	/* set the number of inputs, nodes and outputs */
-	chromo->numInputs = params->numInputs;
-	chromo->numNodes = params->numNodes;
-	chromo->numOutputs = params->numOutputs;
-	chromo->arity = params->arity;
+	params->minDiversityDE = minDiversityDE;
+}
+
+/*
+	sets the number of topologies, with the weights evolved for them by d.e.,
+	which CGPDE-IN remembers in parameters. 0 remembers none
+*/
+DLL_EXPORT void setTopologyCacheSize(struct parameters *params, int topologyCacheSize) {
+
+	/* error checking */
+	if (topologyCacheSize < 0) {
+		printf("\nWarning: topology cache size of %d is invalid. The topology cache size must be >= 0. The topology cache size has been left unchanged as %d.\n", topologyCacheSize, params->topologyCacheSize);
+		return;
+	}
+
+	params->topologyCacheSize = topologyCacheSize;
+}
+
+/*
+	chromosome function definitions
+*/
+
+
+/*
+	Returns a pointer to an initialised chromosome with values obeying the given parameters.
+*/
+DLL_EXPORT struct chromosome *initialiseChromosome(struct parameters *params, unsigned int * seed) {
+
+	struct chromosome *chromo;
+	int i;
+
+	/* check that funcSet contains functions */
+	if (params->funcSet->numFunctions < 1) {
+		printf("Error: chromosome not initialised due to empty functionSet.\nTerminating CGP-Library.\n");
+		exit(0);
+	}
+
+	/* allocate memory for chromosome, its nodes and its execution plan */
+	chromo = allocateChromosome(params->numInputs, params->numNodes, params->numOutputs, params->arity);
+
+	/* Initialise each of the chromosomes nodes */
+	for (i = 0; i < params->numNodes; i++) {
+		initialiseNode(chromo->nodes[i], params->numInputs, params->numNodes, params->arity, params->funcSet->numFunctions, params->connectionWeightRange, params->recurrentConnectionProbability, i, seed);
+	}
+
+	/* set each of the chromosomes outputs */
+	for (i = 0; i < params->numOutputs; i++) {
+		chromo->outputNodes[i] = getRandomChromosomeOutput(params->numInputs, params->numNodes, params->shortcutConnections, seed);
+	}
 
 	/* set the number of active node to the number of nodes (all active) */
 	chromo->numActiveNodes = params->numNodes;
@@ -925,16 +1730,17 @@ DLL_EXPORT struct chromosome *initialiseChromosome(struct parameters *params, un
 	chromo->fitness = 0;
 	chromo->fitnessValidation = 0;
 
-	/* copy the function set from the parameters to the chromosome */
-	chromo->funcSet = (struct functionSet*)malloc(sizeof(struct functionSet));
-	copyFunctionSet(chromo->funcSet, params->funcSet);
+	/* share the function set of the parameters */
+	chromo->funcSet = retainFunctionSet(params->funcSet);
+
+	resetChromosome(chromo);
+	chromo->nodeCacheSize = (size_t)params->nodeCacheSize * 1024 * 1024;
+	chromo->fastActivation = params->fastActivation;
+	chromo->profile = params->profile;
 
 	/* set the active nodes in the newly generated chromosome */
 	setChromosomeActiveNodes(chromo);
 
-	/* used interally when exicuting chromosome */
-	chromo->nodeInputsHold = (double*)malloc(params->arity * sizeof(double));
-
 	return chromo;
 }
 
@@ -1048,7 +1854,11 @@ DLL_EXPORT struct chromosome* initialiseChromosomeFromFile(char const *file, uns
 	fclose(fp);
 	freeParameters(params);
 
-	/* set the active nodes in the copied chromosome */
+	/* the cached node values were those of the random genes */
+	clearNodeCache(chromo);
+
+	/* set the active nodes of the loaded genes */
+	chromo->activeNodesDirty = 1;
 	setChromosomeActiveNodes(chromo);
 
 	return chromo;
@@ -1069,24 +1879,12 @@ DLL_EXPORT struct chromosome *initialiseChromosomeFromChromosome(struct chromoso
 		exit(0);
 	}
 
-	/* allocate memory for chromosome */
-	chromoNew = (struct chromosome*)malloc(sizeof(struct chromosome));
-
-	/* allocate memory for nodes */
-	chromoNew->nodes = (struct node**)malloc(chromo->numNodes * sizeof(struct node*));
-
-	/* allocate memory for outputNodes matrix */
-	chromoNew->outputNodes = (int*)malloc(chromo->numOutputs * sizeof(int));
-
-	/* allocate memory for active nodes matrix */
-	chromoNew->activeNodes = (int*)malloc(chromo->numNodes * sizeof(int));
-
-	/* allocate memory for chromosome outputValues */
-	chromoNew->outputValues = (double*)malloc(chromo->numOutputs * sizeof(double));
+	/* allocate memory for chromosome, its nodes and its execution plan */
+	chromoNew = allocateChromosome(chromo->numInputs, chromo->numNodes, chromo->numOutputs, chromo->arity);
 
 	/* Initialise each of the chromosomes nodes */
 	for (i = 0; i < chromo->numNodes; i++) {
-		chromoNew->nodes[i] = initialiseNode(chromo->numInputs, chromo->numNodes, chromo->arity, chromo->funcSet->numFunctions, 0, 0, i, seed);
+		initialiseNode(chromoNew->nodes[i], chromo->numInputs, chromo->numNodes, chromo->arity, chromo->funcSet->numFunctions, 0, 0, i, seed);
 		copyNode(chromoNew->nodes[i], chromo->nodes[i]);
 	}
 
@@ -1095,13 +1893,6 @@ DLL_EXPORT struct chromosome *initialiseChromosomeFromChromosome(struct chromoso
 		chromoNew->outputNodes[i] = chromo->outputNodes[i];
 	}
 
-	/* set the number of inputs, nodes and outputs */
-	chromoNew->numInputs = chromo->numInputs;
-	chromoNew->numNodes = chromo->numNodes;
-	chromoNew->numOutputs = chromo->numOutputs;
-	chromoNew->arity = chromo->arity;
-
-
 	/* copy over the chromsosme fitness */
 	chromoNew->fitness = chromo->fitness;
 	chromoNew->fitnessValidation = chromo->fitnessValidation;
@@ -1109,16 +1900,17 @@ DLL_EXPORT struct chromosome *initialiseChromosomeFromChromosome(struct chromoso
 	/* copy over the number of gnerations to find a solution */
 	chromoNew->generation = chromo->generation;
 
-	/* copy over the functionset */
-	chromoNew->funcSet = (struct functionSet*)malloc(sizeof(struct functionSet));
-	copyFunctionSet(chromoNew->funcSet, chromo->funcSet);
+	/* share the functionset */
+	chromoNew->funcSet = retainFunctionSet(chromo->funcSet);
+
+	resetChromosome(chromoNew);
+	chromoNew->nodeCacheSize = chromo->nodeCacheSize;
+	chromoNew->fastActivation = chromo->fastActivation;
+	chromoNew->profile = chromo->profile;
 
 	/* set the active nodes in the newly generated chromosome */
 	setChromosomeActiveNodes(chromoNew);
 
-	/* used internally by exicute chromosome */
-	chromoNew->nodeInputsHold = (double*)malloc(chromo->arity * sizeof(double));
-
 	return chromoNew;
 }
 
@@ -1128,24 +1920,17 @@ DLL_EXPORT struct chromosome *initialiseChromosomeFromChromosome(struct chromoso
 */
 DLL_EXPORT void freeChromosome(struct chromosome *chromo) {
 
-	int i;
-
 	/* attempt to prevent user double freeing */
 	if (chromo == NULL) {
 		printf("Warning: double freeing of chromosome prevented.\n");
 		return;
 	}
 
-	for (i = 0; i < chromo->numNodes; i++) {
-		freeNode(chromo->nodes[i]);
-	}
-
-	free(chromo->nodeInputsHold);
-	free(chromo->funcSet);
-	free(chromo->outputValues);
-	free(chromo->nodes);
-	free(chromo->outputNodes);
-	free(chromo->activeNodes);
+	/* only the lazily allocated buffers and the shared function set live outside the chromosome's block */
+	free(chromo->blockValues);
+	free(chromo->offloadOutputs);
+	freeNodeCache(chromo);
+	releaseFunctionSet(chromo->funcSet);
 	free(chromo);
 }
 
@@ -1154,26 +1939,13 @@ DLL_EXPORT void freeChromosome(struct chromosome *chromo) {
 */
 DLL_EXPORT void freeDEChromosome(struct DEChromosome *DEChromo) 
 {
-	int i;
-
 	/* attempt to prevent user double freeing */
 	if (DEChromo == NULL) {
 		printf("Warning: double freeing of DEChromosome prevented.\n");
 		return;
 	}
 
-	for (i = 0; i < DEChromo->chromo->numNodes; i++) {
-		freeNode(DEChromo->chromo->nodes[i]);
-	}
-
-	free(DEChromo->chromo->nodeInputsHold);
-	free(DEChromo->chromo->funcSet);
-	free(DEChromo->chromo->outputValues);
-	free(DEChromo->chromo->nodes);
-	free(DEChromo->chromo->outputNodes);
-	free(DEChromo->chromo->activeNodes);
-	free(DEChromo->chromo);
-	free(DEChromo->weightsVector);
+	freeChromosome(DEChromo->chromo);
 	free(DEChromo);
 }
 
@@ -1238,19 +2010,17 @@ DLL_EXPORT void printChromosome(struct chromosome *chromo, int weights) {
 
 
 /*
-	Executes the given chromosome
+	Executes the given chromosome using its compiled execution plan
 */
 DLL_EXPORT void executeChromosome(struct chromosome *chromo, const double *inputs) {
 
 	int i, j;
-	int nodeInputLocation;
-	int currentActiveNode;
-	int currentActiveNodeFunction;
 	int nodeArity;
+	double nodeOutput;
 
-	const int numInputs = chromo->numInputs;
-	const int numActiveNodes = chromo->numActiveNodes;
-	const int numOutputs = chromo->numOutputs;
+	const int *nodeInputs;
+	const double *nodeWeights;
+	double *nodeValues;
 
 	/* error checking */
 	if (chromo == NULL) {
@@ -1258,3445 +2028,8166 @@ DLL_EXPORT void executeChromosome(struct chromosome *chromo, const double *input
 		exit(0);
 	}
 
-	/* for all of the active nodes */
-	for (i = 0; i < numActiveNodes; i++) {
+	if (chromo->profile != NULL) {
+		addProfileCount(&chromo->profile->samplesExecuted, 1);
+	}
 
-		/* get the index of the current active node */
-		currentActiveNode = chromo->activeNodes[i];
+	nodeValues = chromo->nodeValues;
 
-		/* get the arity of the current node */
-		nodeArity = chromo->nodes[currentActiveNode]->actArity;
+	/* the chromosome inputs occupy the first slots of the node values */
+	memcpy(nodeValues, inputs, chromo->numInputs * sizeof(double));
 
-		/* for each of the active nodes inputs */
-		for (j = 0; j < nodeArity; j++) {
+	/* for each step of the plan (the active nodes in order) */
+	for (i = 0; i < chromo->numActiveNodes; i++) {
 
-			/* gather the nodes input locations */
-			nodeInputLocation = chromo->nodes[currentActiveNode]->inputs[j];
+		nodeArity = chromo->planArity[i];
+		nodeInputs = chromo->planInputs + (i * chromo->arity);
+		nodeWeights = chromo->planWeights + (i * chromo->arity);
 
-			if (nodeInputLocation < numInputs) {
-				chromo->nodeInputsHold[j] = inputs[nodeInputLocation];
-			}
-			else {
-				chromo->nodeInputsHold[j] = chromo->nodes[nodeInputLocation - numInputs]->output;
+		/* the fast evaluator computes the shared activation directly */
+		if (chromo->planActivation != ACTIVATIONNONE) {
+
+			nodeOutput = 0;
+
+			for (j = 0; j < nodeArity; j++) {
+				nodeOutput += (nodeValues[nodeInputs[j]] * nodeWeights[j]);
 			}
+
+			nodeValues[chromo->planSlots[i]] = getFastActivation(chromo->planActivation, nodeOutput);
+			continue;
 		}
 
-		/* get the functionality of the active node under evaluation */
-		currentActiveNodeFunction = chromo->nodes[currentActiveNode]->function;
+		/* gather the nodes inputs */
+		for (j = 0; j < nodeArity; j++) {
+			chromo->nodeInputsHold[j] = nodeValues[nodeInputs[j]];
+		}
 
 		/* calculate the output of the active node under evaluation */
-		chromo->nodes[currentActiveNode]->output = chromo->funcSet->functions[currentActiveNodeFunction](nodeArity, chromo->nodeInputsHold, chromo->nodes[currentActiveNode]->weights);
-
+		nodeOutput = chromo->funcSet->functions[chromo->planFunctions[i]](nodeArity, chromo->nodeInputsHold, nodeWeights);
 
 		/* deal with doubles becoming NAN */
-		if (isnan(chromo->nodes[currentActiveNode]->output) != 0) {
-			chromo->nodes[currentActiveNode]->output = 0;
+		if (isnan(nodeOutput) != 0) {
+			nodeOutput = 0;
 		}
 
 		/* prevent double form going to inf and -inf */
-		else if (isinf(chromo->nodes[currentActiveNode]->output) != 0 ) {
+		else if (isinf(nodeOutput) != 0 ) {
 
-			if (chromo->nodes[currentActiveNode]->output > 0) {
-				chromo->nodes[currentActiveNode]->output = DBL_MAX;
+			if (nodeOutput > 0) {
+				nodeOutput = DBL_MAX;
 			}
 			else {
-				chromo->nodes[currentActiveNode]->output = DBL_MIN;
+				nodeOutput = DBL_MIN;
 			}
 		}
+
+		nodeValues[chromo->planSlots[i]] = nodeOutput;
 	}
 
 	/* Set the chromosome outputs */
-	for (i = 0; i < numOutputs; i++) {
-
-		if (chromo->outputNodes[i] < numInputs) {
-			chromo->outputValues[i] = inputs[chromo->outputNodes[i]];
-		}
-		else {
-			chromo->outputValues[i] = chromo->nodes[chromo->outputNodes[i] - numInputs]->output;
-		}
+	for (i = 0; i < chromo->numOutputs; i++) {
+		chromo->outputValues[i] = nodeValues[chromo->outputNodes[i]];
 	}
 }
 
 /*
-	used to access the chromosome outputs after executeChromosome
-	has been called
+	Executes the given chromosome for every sample in the given dataSet
+	evaluating each active node over blocks of samples at a time
 */
-DLL_EXPORT double getChromosomeOutput(struct chromosome *chromo, int output) {
-
-	if (output < 0 || output > chromo->numOutputs) {
-		printf("Error: output less than or greater than the number of chromosome outputs. Called from getChromosomeOutput.\n");
-		exit(0);
-	}
+DLL_EXPORT void executeChromosomeBatch(struct chromosome *chromo, struct dataSet *data, double *outputs) {
 
-	return chromo->outputValues[output];
+	executeChromosomeSamples(chromo, data, 0, data->numSamples, outputs);
 }
 
 
-
 /*
-	used to access the chromosome node values after executeChromosome
-	has been called
+	Executes the given chromosome for numSamples samples of the given dataSet
+	starting at firstSample, storing the outputs from the start of outputs
 */
-DLL_EXPORT double getChromosomeNodeValue(struct chromosome *chromo, int node) {
-	if (node < 0 || node > chromo->numNodes) {
-		printf("Error: node less than or greater than the number of nodes  in chromosome. Called from getChromosomeNodeValue.\n");
-		exit(0);
-	}
+DLL_EXPORT void executeChromosomeSamples(struct chromosome *chromo, struct dataSet *data, int firstSample, int numSamples, double *outputs) {
 
-	return chromo->nodes[node]->output;
-}
+	int i, j;
+	int blockSamples;
+	int node, input;
+	struct nodeCache *cache;
+	void (*blockFunctions[FUNCTIONSETSIZE])(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs);
 
+	/* error checking */
+	if (chromo == NULL) {
+		printf("Error: cannot execute uninitialised chromosome.\n Terminating CGP-Library.\n");
+		exit(0);
+	}
 
-/*
-	returns whether the specified node is active in the given chromosome
-*/
-DLL_EXPORT int isNodeActive(struct chromosome *chromo, int node) {
+	if (chromo->numInputs != data->numInputs || chromo->numOutputs != data->numOutputs) {
+		printf("Error: the number of chromosome inputs and outputs must match the number of inputs and outputs specified in the dataSet.\nTerminating CGP-Library.\n");
+		exit(0);
+	}
 
-	if (node < 0 || node > chromo->numNodes) {
-		printf("Error: node less than or greater than the number of nodes  in chromosome. Called from isNodeActive.\n");
+	if (firstSample < 0 || numSamples < 0 || firstSample + numSamples > data->numSamples) {
+		printf("Error: the samples %d to %d are not within the %d samples of the dataSet.\nTerminating CGP-Library.\n", firstSample, firstSample + numSamples - 1, data->numSamples);
 		exit(0);
 	}
 
-	return chromo->nodes[node]->active;
-}
+	if (numSamples == 0) {
+		return;
+	}
 
+	/* the samples of streamed dataSets are only held a chunk at a time */
+	if (data->stream != NULL) {
+		executeChromosomeStreamSamples(chromo, data, firstSample, numSamples, outputs);
+		return;
+	}
 
-/*
-	Saves the given chromosome in a form which can be read in later
-*/
-DLL_EXPORT void saveChromosome(struct chromosome *chromo, char const *fileName) {
+	/* the outputs were already computed with those of the rest of the population, see executeChromosomesOffload */
+	if (chromo->offloadDataSetId != 0 && chromo->offloadDataSetId == data->id) {
 
-	int i, j;
-	FILE *fp;
+		memcpy(outputs, chromo->offloadOutputs + (firstSample * chromo->numOutputs), numSamples * chromo->numOutputs * sizeof(double));
 
-	/* create the chromosome file */
-	fp = fopen(fileName, "w");
+		/* executeChromosome counts the last sample */
+		if (chromo->profile != NULL) {
+			addProfileCount(&chromo->profile->samplesExecuted, numSamples - 1);
+		}
 
-	/* ensure that the file was created correctly */
-	if (fp == NULL) {
-		printf("Warning: cannot save chromosome to '%s'. Chromosome was not saved.\n", fileName);
+		/* leave the node and output values as if the samples were executed */
+		executeChromosome(chromo, data->inputData[firstSample + numSamples - 1]);
 		return;
 	}
 
-	/* save meta information */
-	fprintf(fp, "numInputs,%d\n", chromo->numInputs);
-	fprintf(fp, "numNodes,%d\n", chromo->numNodes);
-	fprintf(fp, "numOutputs,%d\n", chromo->numOutputs);
-	fprintf(fp, "arity,%d\n", chromo->arity);
+	/* recurrent chromosomes depend on the previous sample and so are executed in order */
+	if (chromo->planRecurrent == 1) {
 
-	fprintf(fp, "functionSet");
+		for (i = 0; i < numSamples; i++) {
+			executeChromosome(chromo, data->inputData[firstSample + i]);
+			memcpy(outputs + (i * chromo->numOutputs), chromo->outputValues, chromo->numOutputs * sizeof(double));
+		}
 
-	for (i = 0; i < chromo->funcSet->numFunctions; i++) {
-		fprintf(fp, ",%s", chromo->funcSet->functionNames[i]);
+		return;
 	}
-	fprintf(fp, "\n");
-
-	/* save the chromosome structure */
-	for (i = 0; i < chromo->numNodes; i++) {
-
-		fprintf(fp, "%d\n", chromo->nodes[i]->function);
 
-		for (j = 0; j < chromo->arity; j++) {
-			fprintf(fp, "%d,%f\n", chromo->nodes[i]->inputs[j], chromo->nodes[i]->weights[j]);
-		}
+	if (chromo->profile != NULL) {
+		addProfileCount(&chromo->profile->samplesExecuted, numSamples);
 	}
 
-	for (i = 0; i < chromo->numOutputs; i++) {
-		fprintf(fp, "%d,", chromo->outputNodes[i]);
+	if (chromo->blockValues == NULL) {
+		chromo->blockValues = (double*)malloc((chromo->numInputs + chromo->numNodes) * BATCHBLOCKSIZE * sizeof(double));
 	}
 
-	fclose(fp);
-}
+	setBlockFunctions(chromo->funcSet, blockFunctions);
 
+	/* the cached node values for data, NULL if node caching is not used */
+	cache = getNodeCache(chromo, data);
 
-/*
-	save the given chromosome to a graphviz .dot file
-	(www.graphviz.org/‎)
-*/
-DLL_EXPORT void saveChromosomeDot(struct chromosome *chromo, int weights, char const *fileName) {
+	/*
+		a node is recomputed when its row is not valid or one of its inputs
+		is recomputed i.e. the nodes downstream of changed genes
+	*/
+	if (cache != NULL) {
 
-	int i, j;
-	FILE *fp;
+		for (i = 0; i < chromo->numActiveNodes; i++) {
 
-	char colour[20];
-	char weight[20];
+			node = chromo->planSlots[i] - chromo->numInputs;
+			chromo->nodeRecompute[node] = (cache->valid[node] == 0);
 
-	fp = fopen(fileName, "w");
+			for (j = 0; j < chromo->planArity[i] && chromo->nodeRecompute[node] == 0; j++) {
 
-	if (fp == NULL) {
-		return;
+				input = chromo->planInputs[(i * chromo->arity) + j];
+
+				if (input >= chromo->numInputs && chromo->nodeRecompute[input - chromo->numInputs] == 1) {
+					chromo->nodeRecompute[node] = 1;
+				}
+			}
+		}
 	}
 
-	/* */
-	fprintf(fp, "digraph NeuralNetwork {\n");
+	/* for each block of samples */
+	for (i = 0; i < numSamples; i += BATCHBLOCKSIZE) {
 
-	/* landscape, square and centre */
-	fprintf(fp, "rankdir=LR;\n");
-	fprintf(fp, "size=\"4,3\";\n");
-	fprintf(fp, "center = true;\n");
+		blockSamples = numSamples - i;
 
-	/* for all the inputs */
-	for (i = 0; i < getNumChromosomeInputs(chromo); i++) {
+		if (blockSamples > BATCHBLOCKSIZE) {
+			blockSamples = BATCHBLOCKSIZE;
+		}
 
-		fprintf(fp, "node%d [label=\"(%d) Input\", color=black, labelfontcolor=black, fontcolor=black];\n", i, i);
+		executeChromosomeBlock(chromo, data, firstSample + i, blockSamples, blockFunctions, cache, outputs + (i * chromo->numOutputs));
 	}
 
-	/* for all nodes */
-	for (i = 0; i < getNumChromosomeNodes(chromo); i++) {
+	if (cache == NULL) {
+		return;
+	}
 
-		if (chromo->nodes[i]->active == 1) {
-			strncpy(colour, "black", 20);
-		}
-		else {
-			strncpy(colour, "lightgrey", 20);
+	/*
+		the recomputed rows only become valid once every sample has been
+		executed in order without the valid rows changing in between
+	*/
+	if (firstSample == 0) {
+		cache->numFilledSamples = numSamples;
+	}
+	else if (firstSample == cache->numFilledSamples) {
+		cache->numFilledSamples += numSamples;
+	}
+	else {
+		cache->numFilledSamples = -1;
+	}
+
+	/*
+		the rows of the active nodes now hold their values. The rows of the
+		inactive nodes were not updated and so may no longer match their inputs
+	*/
+	if (cache->numFilledSamples == data->numSamples) {
+		for (i = 0; i < chromo->numNodes; i++) {
+			cache->valid[i] = chromo->nodes[i]->active;
 		}
+	}
+}
 
-		fprintf(fp, "node%d [label=\"(%d) %s\", color=%s, labelfontcolor=%s, fontcolor=%s];\n", i + getNumChromosomeInputs(chromo), i + getNumChromosomeInputs(chromo), chromo->funcSet->functionNames[chromo->nodes[i]->function], colour, colour, colour);
+/*
+	Executes the given chromosome for numSamples samples of the given
+	streamed dataSet starting at firstSample, one chunk at a time
+*/
+static void executeChromosomeStreamSamples(struct chromosome *chromo, struct dataSet *data, int firstSample, int numSamples, double *outputs) {
 
-		/* for each node input */
-		for (j = 0; j < getChromosomeNodeArity(chromo, i); j++) {
+	int chunk;
+	int chunkFirstSample, chunkNumSamples;
+	struct dataSet *chunkData;
 
-			if (weights == 1) {
-				snprintf(weight, 20, "%.2f", chromo->nodes[i]->weights[j]);
-			}
-			else {
-				snprintf(weight, 20, " (%d)", j);
-			}
+	for (chunk = firstSample / data->stream->chunkSize; chunk < data->stream->numChunks && chunk * data->stream->chunkSize < firstSample + numSamples; chunk++) {
 
+		chunkData = initialiseDataSetChunk(data, chunk);
 
-			fprintf(fp, "node%d -> node%d [label=\"%s\", labelfontcolor=%s, fontcolor=%s, bold=true, color=%s];\n", chromo->nodes[i]->inputs[j], i + getNumChromosomeInputs(chromo), weight, colour, colour, colour);
-		}
-	}
+		/* the samples of the chunk within those to be executed */
+		chunkFirstSample = firstSample - (chunk * data->stream->chunkSize);
+		chunkFirstSample = chunkFirstSample > 0 ? chunkFirstSample : 0;
 
-	for (i = 0; i < getNumChromosomeOutputs(chromo); i++) {
+		chunkNumSamples = firstSample + numSamples - (chunk * data->stream->chunkSize);
+		chunkNumSamples = chunkNumSamples < chunkData->numSamples ? chunkNumSamples : chunkData->numSamples;
+		chunkNumSamples -= chunkFirstSample;
 
-		fprintf(fp, "node%d [label=\"Output %d\", color=black, labelfontcolor=black, fontcolor=black];\n", i + getNumChromosomeInputs(chromo) + getNumChromosomeNodes(chromo), i);
+		executeChromosomeSamples(chromo, chunkData, chunkFirstSample, chunkNumSamples, outputs);
+		outputs += chunkNumSamples * chromo->numOutputs;
 
-		fprintf(fp, "node%d -> node%d [labelfontcolor=black, fontcolor=black, bold=true, color=black];\n", chromo->outputNodes[i], i + getNumChromosomeInputs(chromo) + getNumChromosomeNodes(chromo));
+		freeDataSet(chunkData);
 	}
+}
 
 
-	/* place inputs  on same line */
-	fprintf(fp, "{ rank = source;");
+/*
+	Executes the given chromosome for a block of at most BATCHBLOCKSIZE samples.
 
-	for (i = 0; i < getNumChromosomeInputs(chromo); i++) {
-		fprintf(fp, " \"node%d\";", i);
-	}
-	fprintf(fp, " }\n");
+	blockValues holds one row of BATCHBLOCKSIZE values for each chromosome
+	input and node, numbered in the same way as nodeValues. So that the
+	node values and outputs can still be read using getChromosomeNodeValue
+	and getChromosomeOutput the values for the last sample of the block
+	are also stored in nodeValues and outputValues. The outputs of the
+	block are stored from the start of outputs.
+*/
+static void executeChromosomeBlock(struct chromosome *chromo, struct dataSet *data, int firstSample, int numSamples, void (**blockFunctions)(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs), struct nodeCache *cache, double *outputs) {
 
+	int i, j, s;
+	int nodeArity;
+	int function;
 
-	/* place outputs  on same line */
-	fprintf(fp, "{ rank = max;");
+	const int *nodeInputs;
+	const double *nodeWeights;
+	double *blockValues = chromo->blockValues;
+	double *blockOutputs;
 
-	for (i = 0; i < getNumChromosomeOutputs(chromo); i++) {
-		fprintf(fp, "\"node%d\";", i + getNumChromosomeInputs(chromo) + getNumChromosomeNodes(chromo));
+	/* copy the inputs of the block of samples into the input rows */
+	if (data->inputColumns != NULL && data->inputColumnsOrder == dataSetsOrder) {
+		for (j = 0; j < chromo->numInputs; j++) {
+			memcpy(blockValues + (j * BATCHBLOCKSIZE), data->inputColumns + (j * data->numSamples) + firstSample, numSamples * sizeof(double));
+		}
+	}
+	else {
+		for (s = 0; s < numSamples; s++) {
+			for (j = 0; j < chromo->numInputs; j++) {
+				blockValues[(j * BATCHBLOCKSIZE) + s] = data->inputData[firstSample + s][j];
+			}
+		}
 	}
-	fprintf(fp, " }\n");
 
+	/* for each step of the plan (the active nodes in order) */
+	for (i = 0; i < chromo->numActiveNodes; i++) {
 
-	/* last line of dot file */
-	fprintf(fp, "}");
+		nodeArity = chromo->planArity[i];
+		nodeInputs = chromo->planInputs + (i * chromo->arity);
+		nodeWeights = chromo->planWeights + (i * chromo->arity);
+		function = chromo->planFunctions[i];
+		blockOutputs = blockValues + (chromo->planSlots[i] * BATCHBLOCKSIZE);
 
-	fclose(fp);
-}
+		/* nodes whose values are unchanged are read from the cache */
+		if (cache != NULL && chromo->nodeRecompute[chromo->planSlots[i] - chromo->numInputs] == 0) {
+			memcpy(blockOutputs, cache->values + ((chromo->planSlots[i] - chromo->numInputs) * cache->numSamples) + firstSample, numSamples * sizeof(double));
+			chromo->nodeValues[chromo->planSlots[i]] = blockOutputs[numSamples - 1];
+			continue;
+		}
 
+		/* the fast evaluator computes the shared activation directly */
+		if (chromo->planActivation != ACTIVATIONNONE) {
 
-/*
-	save the given chromosome as a latex equation
+			getFastActivationBlock(chromo->planActivation, numSamples, nodeArity, nodeInputs, nodeWeights, blockValues, blockOutputs);
 
-	Only compatible with feed-forward networks
-	Only fully compatible with custom node functions
-*/
-DLL_EXPORT void saveChromosomeLatex(struct chromosome *chromo, int weights, char const *fileName) {
+			if (cache != NULL) {
+				memcpy(cache->values + ((chromo->planSlots[i] - chromo->numInputs) * cache->numSamples) + firstSample, blockOutputs, numSamples * sizeof(double));
+			}
 
-	int output;
-	int i;
-	FILE *fp;
+			chromo->nodeValues[chromo->planSlots[i]] = blockOutputs[numSamples - 1];
+			continue;
+		}
 
-	fp = fopen(fileName, "w");
-
-	if (fp == NULL) {
-		return;
-	}
+		/* node functions with a block form are evaluated over the block at once */
+		if (blockFunctions[function] != NULL) {
+			blockFunctions[function](numSamples, nodeArity, nodeInputs, nodeWeights, blockValues, blockOutputs);
+		}
 
-	/* document header */
-	fprintf(fp, "\\documentclass{article}\n");
-	fprintf(fp, "\\begin{document}\n");
+		/* otherwise call the node function for each sample */
+		else {
 
-	for (output = 0; output < chromo->numOutputs; output++) {
+			for (s = 0; s < numSamples; s++) {
 
-		fprintf(fp, "\\begin{equation}\n");
+				for (j = 0; j < nodeArity; j++) {
+					chromo->nodeInputsHold[j] = blockValues[(nodeInputs[j] * BATCHBLOCKSIZE) + s];
+				}
 
-		/* function inputs */
-		if (chromo->numInputs == 0) {
-			fprintf(fp, "f()=");
+				blockOutputs[s] = chromo->funcSet->functions[function](nodeArity, chromo->nodeInputsHold, nodeWeights);
+			}
 		}
-		else {
-
-			fprintf(fp, "f_%d(x_0", output);
 
-			for (i = 1; i < chromo->numInputs; i++) {
+		/* deal with doubles becoming NAN and prevent double form going to inf and -inf */
+		for (s = 0; s < numSamples; s++) {
 
-				fprintf(fp, ",x_%d", i);
+			if (isnan(blockOutputs[s]) != 0) {
+				blockOutputs[s] = 0;
 			}
+			else if (isinf(blockOutputs[s]) != 0 ) {
 
-			fprintf(fp, ")=");
+				if (blockOutputs[s] > 0) {
+					blockOutputs[s] = DBL_MAX;
+				}
+				else {
+					blockOutputs[s] = DBL_MIN;
+				}
+			}
 		}
 
-		saveChromosomeLatexRecursive(chromo, chromo->outputNodes[output], fp);
+		if (cache != NULL) {
+			memcpy(cache->values + ((chromo->planSlots[i] - chromo->numInputs) * cache->numSamples) + firstSample, blockOutputs, numSamples * sizeof(double));
+		}
 
-		fprintf(fp, "\n\\end{equation}");
+		chromo->nodeValues[chromo->planSlots[i]] = blockOutputs[numSamples - 1];
 	}
 
+	/* Set the chromosome outputs of each sample */
+	for (s = 0; s < numSamples; s++) {
+		for (j = 0; j < chromo->numOutputs; j++) {
+			outputs[(s * chromo->numOutputs) + j] = blockValues[(chromo->outputNodes[j] * BATCHBLOCKSIZE) + s];
+		}
+	}
 
-	/* document footer */
-	fprintf(fp, "\n\\end{document}");
+	/* keep the inputs and outputs of the last sample */
+	for (j = 0; j < chromo->numInputs; j++) {
+		chromo->nodeValues[j] = blockValues[(j * BATCHBLOCKSIZE) + numSamples - 1];
+	}
 
-	fclose(fp);
+	memcpy(chromo->outputValues, outputs + ((numSamples - 1) * chromo->numOutputs), chromo->numOutputs * sizeof(double));
 }
 
+
 /*
-	used by saveChromosomeLatex
+	Returns the node cache of the given chromosome for the given dataSet,
+	or NULL if node caching is not used. If the dataSet is not cached
+	the least recently used cache is given to it with no valid rows.
+
+	Each cache holds numNodes * numSamples values and is only used when
+	all NODECACHESLOTS caches fit within the chromosome nodeCacheSize.
 */
-static void saveChromosomeLatexRecursive(struct chromosome *chromo, int index, FILE *fp) {
+static struct nodeCache *getNodeCache(struct chromosome *chromo, struct dataSet *data) {
 
 	int i;
+	struct nodeCache *cache = NULL;
 
-	if (index < chromo->numInputs) {
-		fprintf(fp, "x_%d", index);
-		return;
+	if (chromo->nodeCacheSize == 0 || chromo->planRecurrent == 1) {
+		return NULL;
 	}
 
-	/* add */
-	if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "add", FUNCTIONNAMELENGTH) == 0 ) {
-
-		fprintf(fp, "\\left(");
+	if ((size_t)chromo->numNodes * data->numSamples * sizeof(double) * NODECACHESLOTS > chromo->nodeCacheSize) {
+		return NULL;
+	}
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+	if (chromo->nodeCache == NULL) {
+		initialiseNodeCache(chromo);
+	}
 
-		for (i = 1; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+	chromo->nodeCacheClock++;
 
-			fprintf(fp, " + ");
+	/* search for the cache of the given dataSet, in the current order of its samples */
+	for (i = 0; i < NODECACHESLOTS; i++) {
+		if (chromo->nodeCache[i].dataSetId == data->id && chromo->nodeCache[i].dataSetsOrder == dataSetsOrder) {
+			chromo->nodeCache[i].lastUsed = chromo->nodeCacheClock;
+			return &chromo->nodeCache[i];
+		}
+	}
 
-			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
+	/* otherwise replace the least recently used cache */
+	for (i = 0; i < NODECACHESLOTS; i++) {
+		if (cache == NULL || chromo->nodeCache[i].lastUsed < cache->lastUsed) {
+			cache = &chromo->nodeCache[i];
 		}
+	}
 
-		fprintf(fp, "\\right)");
+	if (cache->values == NULL || cache->numSamples != data->numSamples) {
+		free(cache->values);
+		cache->values = (double*)malloc(chromo->numNodes * data->numSamples * sizeof(double));
 	}
 
+	for (i = 0; i < chromo->numNodes; i++) {
+		cache->valid[i] = 0;
+	}
 
-	/* sub */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "sub", FUNCTIONNAMELENGTH) == 0 ) {
+	cache->numFilledSamples = 0;
+	cache->dataSetId = data->id;
+	cache->dataSetsOrder = dataSetsOrder;
+	cache->numSamples = data->numSamples;
+	cache->lastUsed = chromo->nodeCacheClock;
 
-		fprintf(fp, "\\left(");
+	return cache;
+}
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-		for (i = 1; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+/*
+	allocates the node caches of the given chromosome, all empty
+*/
+static void initialiseNodeCache(struct chromosome *chromo) {
 
-			fprintf(fp, " - ");
+	int i;
 
-			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
-		}
+	chromo->nodeCache = (struct nodeCache*)malloc(NODECACHESLOTS * sizeof(struct nodeCache));
+	chromo->nodeRecompute = (int*)malloc(chromo->numNodes * sizeof(int));
+	chromo->nodeCacheClock = 0;
 
-		fprintf(fp, "\\right)");
+	for (i = 0; i < NODECACHESLOTS; i++) {
+		chromo->nodeCache[i].dataSetId = 0;
+		chromo->nodeCache[i].dataSetsOrder = 0;
+		chromo->nodeCache[i].numSamples = 0;
+		chromo->nodeCache[i].lastUsed = 0;
+		chromo->nodeCache[i].numFilledSamples = 0;
+		chromo->nodeCache[i].values = NULL;
+		chromo->nodeCache[i].valid = (int*)calloc(chromo->numNodes, sizeof(int));
 	}
+}
 
-	/* mul */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "mul", FUNCTIONNAMELENGTH) == 0 ) {
-
-		fprintf(fp, "\\left(");
-
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-		for (i = 1; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+/*
+	frees the node caches of the given chromosome if allocated
+*/
+static void freeNodeCache(struct chromosome *chromo) {
 
-			fprintf(fp, " \\times ");
+	int i;
 
-			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
-		}
+	if (chromo->nodeCache == NULL) {
+		return;
+	}
 
-		fprintf(fp, "\\right)");
+	for (i = 0; i < NODECACHESLOTS; i++) {
+		free(chromo->nodeCache[i].values);
+		free(chromo->nodeCache[i].valid);
 	}
 
-	/* div (change to frac)*/
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "div", FUNCTIONNAMELENGTH) == 0 ) {
+	free(chromo->nodeCache);
+	free(chromo->nodeRecompute);
+	chromo->nodeCache = NULL;
+	chromo->nodeRecompute = NULL;
+}
 
-		if (getChromosomeNodeArity(chromo, index - chromo->numInputs) == 1) {
-			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
-		}
-		else {
 
-			for (i = 0; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+/*
+	marks the cached values of the given node as no longer valid
+*/
+static void setNodeCacheDirty(struct chromosome *chromo, int nodeIndex) {
 
-				if (i + 1 < getChromosomeNodeArity(chromo, index - chromo->numInputs)) {
-					fprintf(fp, "\\frac{");
-					saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
-					fprintf(fp, "}{");
-				}
-				else if (i + 1 == getChromosomeNodeArity(chromo, index - chromo->numInputs) && getChromosomeNodeArity(chromo, index - chromo->numInputs) > 2) {
-					saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
-					fprintf(fp, "}}");
-				}
-				else {
-					saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
-					fprintf(fp, "}");
-				}
-			}
-		}
+	int i;
+
+	if (chromo->nodeCache == NULL) {
+		return;
 	}
 
-	/* abs */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "abs", FUNCTIONNAMELENGTH) == 0 ) {
+	for (i = 0; i < NODECACHESLOTS; i++) {
+		chromo->nodeCache[i].valid[nodeIndex] = 0;
+		chromo->nodeCache[i].numFilledSamples = -1;
+	}
+}
 
-		fprintf(fp, " \\left|");
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+/*
+	marks the cached values of every node as no longer valid
+*/
+static void clearNodeCache(struct chromosome *chromo) {
 
-		fprintf(fp, " \\right|");
+	int i;
 
+	for (i = 0; i < chromo->numNodes; i++) {
+		setNodeCacheDirty(chromo, i);
 	}
+}
 
-	/* sqrt */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "sqrt", FUNCTIONNAMELENGTH) == 0 ) {
 
-		fprintf(fp, " \\sqrt{");
+/*
+	copies the valid rows of the node caches of chromoSrc to chromoDest,
+	which must already hold a copy of the nodes of chromoSrc
+*/
+static void copyNodeCache(struct chromosome *chromoDest, struct chromosome *chromoSrc) {
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+	int i, j;
+	struct nodeCache *cacheDest;
+	struct nodeCache *cacheSrc;
 
-		fprintf(fp, " }");
+	if (chromoSrc->nodeCache == NULL || chromoDest->nodeCacheSize == 0) {
+		clearNodeCache(chromoDest);
+		return;
+	}
 
+	if (chromoDest->nodeCache == NULL) {
+		initialiseNodeCache(chromoDest);
 	}
 
+	chromoDest->nodeCacheClock = chromoSrc->nodeCacheClock;
 
-	/* sq */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "sq", FUNCTIONNAMELENGTH) == 0 ) {
+	for (i = 0; i < NODECACHESLOTS; i++) {
 
-		fprintf(fp, " (");
+		cacheDest = &chromoDest->nodeCache[i];
+		cacheSrc = &chromoSrc->nodeCache[i];
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+		cacheDest->dataSetId = cacheSrc->dataSetId;
+		cacheDest->lastUsed = cacheSrc->lastUsed;
+		cacheDest->numFilledSamples = -1;
 
-		fprintf(fp, " )^2");
+		if (cacheSrc->values == NULL) {
 
-	}
+			for (j = 0; j < chromoDest->numNodes; j++) {
+				cacheDest->valid[j] = 0;
+			}
 
-	/* cube */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "cube", FUNCTIONNAMELENGTH) == 0 ) {
+			continue;
+		}
 
-		fprintf(fp, " (");
+		if (cacheDest->values == NULL || cacheDest->numSamples != cacheSrc->numSamples) {
+			free(cacheDest->values);
+			cacheDest->values = (double*)malloc(chromoDest->numNodes * cacheSrc->numSamples * sizeof(double));
+		}
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+		cacheDest->numSamples = cacheSrc->numSamples;
 
-		fprintf(fp, " )^3");
+		/* only the valid rows hold values worth copying */
+		for (j = 0; j < chromoDest->numNodes; j++) {
 
+			cacheDest->valid[j] = cacheSrc->valid[j];
+
+			if (cacheSrc->valid[j] == 1) {
+				memcpy(cacheDest->values + (j * cacheSrc->numSamples), cacheSrc->values + (j * cacheSrc->numSamples), cacheSrc->numSamples * sizeof(double));
+			}
+		}
 	}
+}
 
-	/* exp */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "exp", FUNCTIONNAMELENGTH) == 0 ) {
 
-		fprintf(fp, " e^{");
+/*
+	sets the block form of each function in the given function set, or
+	NULL where the function has no block form
+*/
+static void setBlockFunctions(struct functionSet *funcSet, void (**blockFunctions)(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs)) {
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+	int i;
 
-		fprintf(fp, " }");
+	for (i = 0; i < funcSet->numFunctions; i++) {
 
+		if (funcSet->functions[i] == _sigmoid) {
+			blockFunctions[i] = _sigmoidBlock;
+		}
+		else if (funcSet->functions[i] == _gaussian) {
+			blockFunctions[i] = _gaussianBlock;
+		}
+		else if (funcSet->functions[i] == _step) {
+			blockFunctions[i] = _stepBlock;
+		}
+		else if (funcSet->functions[i] == _softsign) {
+			blockFunctions[i] = _softsignBlock;
+		}
+		else if (funcSet->functions[i] == _hyperbolicTangent) {
+			blockFunctions[i] = _hyperbolicTangentBlock;
+		}
+		else {
+			blockFunctions[i] = NULL;
+		}
 	}
+}
 
-	/* sin */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "sin", FUNCTIONNAMELENGTH) == 0 ) {
-
-		fprintf(fp, "\\sin(");
-
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-		fprintf(fp, " )");
+/*
+	used to access the chromosome outputs after executeChromosome
+	has been called
+*/
+DLL_EXPORT double getChromosomeOutput(struct chromosome *chromo, int output) {
 
+	if (output < 0 || output > chromo->numOutputs) {
+		printf("Error: output less than or greater than the number of chromosome outputs. Called from getChromosomeOutput.\n");
+		exit(0);
 	}
 
-	/* cos */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "cos", FUNCTIONNAMELENGTH) == 0 ) {
-
-		fprintf(fp, " \\cos(");
+	return chromo->outputValues[output];
+}
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-		fprintf(fp, " )");
 
+/*
+	used to access the chromosome node values after executeChromosome
+	has been called
+*/
+DLL_EXPORT double getChromosomeNodeValue(struct chromosome *chromo, int node) {
+	if (node < 0 || node > chromo->numNodes) {
+		printf("Error: node less than or greater than the number of nodes  in chromosome. Called from getChromosomeNodeValue.\n");
+		exit(0);
 	}
 
-	/* tan */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "tan", FUNCTIONNAMELENGTH) == 0 ) {
-
-		fprintf(fp, " \\tan(");
+	return chromo->nodeValues[chromo->numInputs + node];
+}
 
-		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-		fprintf(fp, " )");
+/*
+	returns whether the specified node is active in the given chromosome
+*/
+DLL_EXPORT int isNodeActive(struct chromosome *chromo, int node) {
 
+	if (node < 0 || node > chromo->numNodes) {
+		printf("Error: node less than or greater than the number of nodes  in chromosome. Called from isNodeActive.\n");
+		exit(0);
 	}
 
-	/* rand */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "rand", FUNCTIONNAMELENGTH) == 0 ) {
+	return chromo->nodes[node]->active;
+}
 
-		fprintf(fp, " rand()");
-	}
 
-	/* pi */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "pi", FUNCTIONNAMELENGTH) == 0 ) {
+/*
+	Saves the given chromosome in a form which can be read in later
+*/
+DLL_EXPORT void saveChromosome(struct chromosome *chromo, char const *fileName) {
 
-		fprintf(fp, "\\pi");
-	}
+	int i, j;
+	FILE *fp;
 
-	/* 0 */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "0", FUNCTIONNAMELENGTH) == 0 ) {
+	/* create the chromosome file */
+	fp = fopen(fileName, "w");
 
-		fprintf(fp, " 0");
+	/* ensure that the file was created correctly */
+	if (fp == NULL) {
+		printf("Warning: cannot save chromosome to '%s'. Chromosome was not saved.\n", fileName);
+		return;
 	}
 
-	/* 1 */
-	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "1", FUNCTIONNAMELENGTH) == 0 ) {
+	/* save meta information */
+	fprintf(fp, "numInputs,%d\n", chromo->numInputs);
+	fprintf(fp, "numNodes,%d\n", chromo->numNodes);
+	fprintf(fp, "numOutputs,%d\n", chromo->numOutputs);
+	fprintf(fp, "arity,%d\n", chromo->arity);
 
-		fprintf(fp, " 1");
-	}
+	fprintf(fp, "functionSet");
 
-	/* other */
-	else {
-
-		fprintf(fp, "%s(", chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function]);
+	for (i = 0; i < chromo->funcSet->numFunctions; i++) {
+		fprintf(fp, ",%s", chromo->funcSet->functionNames[i]);
+	}
+	fprintf(fp, "\n");
 
-		for (i = 0; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+	/* save the chromosome structure */
+	for (i = 0; i < chromo->numNodes; i++) {
 
-			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
+		fprintf(fp, "%d\n", chromo->nodes[i]->function);
 
-			if (i < getChromosomeNodeArity(chromo, index - chromo->numInputs) - 1)
-				fprintf(fp, ", ");
+		for (j = 0; j < chromo->arity; j++) {
+			fprintf(fp, "%d,%f\n", chromo->nodes[i]->inputs[j], chromo->nodes[i]->weights[j]);
 		}
+	}
 
-		fprintf(fp, ")");
+	for (i = 0; i < chromo->numOutputs; i++) {
+		fprintf(fp, "%d,", chromo->outputNodes[i]);
 	}
 
+	fclose(fp);
 }
 
-DLL_EXPORT int compareChromosomes(struct chromosome *chromoA, struct chromosome *chromoB) {
-
-	int i, j;
-
-	/* ensure that the chromosomes don't point to NULL */
-	if (chromoA == NULL || chromoB == NULL) {
-		return 0;
-	}
 
-	/* Check the high level parameters */
-	if (chromoA->numInputs != chromoB->numInputs) {
-		return 0;
-	}
+/*
+	saves the given chromosome to a binary file, see saveChromosomesBinary
+*/
+DLL_EXPORT void saveChromosomeBinary(struct chromosome *chromo, char const *fileName) {
 
-	if (chromoA->numNodes != chromoB->numNodes) {
-		return 0;
-	}
+	saveChromosomesBinary(&chromo, 1, fileName);
+}
 
-	if (chromoA->numOutputs != chromoB->numOutputs) {
-		return 0;
-	}
 
-	if (chromoA->arity != chromoB->arity) {
-		return 0;
-	}
+/*
+	saves the given chromosomes to a binary file. The chromosomes are
+	serialised into one buffer which is written at once.
+*/
+DLL_EXPORT void saveChromosomesBinary(struct chromosome **chromos, int numChromos, char const *fileName) {
 
-	/* for each node*/
-	for (i = 0; i < chromoA->numNodes; i++) {
+	FILE *fp;
+	char *buffer;
+	size_t size;
 
-		/* Check the function genes */
-		if (chromoA->nodes[i]->function != chromoB->nodes[i]->function) {
-			return 0;
-		}
+	buffer = getBinaryChromosomes(chromos, numChromos, &size);
 
-		/* for each node input */
-		for (j = 0; j < chromoA->arity; j++) {
+	fp = fopen(fileName, "wb");
 
-			/* Check the node inputs */
-			if (chromoA->nodes[i]->inputs[j] != chromoB->nodes[i]->inputs[j]) {
-				return 0;
-			}
-		}
+	if (fp == NULL || fwrite(buffer, 1, size, fp) != size) {
+		printf("Warning: cannot save chromosome to '%s'. Chromosome was not saved.\n", fileName);
 	}
 
-	/* for all of the outputs */
-	for (i = 0; i < chromoA->numOutputs; i++) {
-
-		/* Check the outputs */
-		if (chromoA->outputNodes[i] != chromoB->outputNodes[i] ) {
-			return 0;
-		}
+	if (fp != NULL) {
+		fclose(fp);
 	}
 
-	return 1;
+	free(buffer);
 }
 
 
-DLL_EXPORT int compareChromosomesANN(struct chromosome *chromoA, struct chromosome *chromoB) {
+/*
+	serialises the given chromosomes, with the header of a binary file, into
+	one buffer of the returned size. The buffer should be free'd
+*/
+static char *getBinaryChromosomes(struct chromosome **chromos, int numChromos, size_t *bufferSize) {
 
-	int i, j;
+	int i, j, k;
+	char *buffer;
+	char *record;
+	double *weights;
+	int32_t *functions, *inputs, *outputs;
+	size_t size;
+	size_t weightsOffset, functionsOffset, inputsOffset, outputsOffset;
+	struct binaryFileHeader header;
+	struct binaryChromosomeRecord chromoRecord;
 
-	/* ensure that the chromosomes don't point to NULL */
-	if (chromoA == NULL || chromoB == NULL) {
-		return 0;
-	}
+	/* the size of the file */
+	size = sizeof(struct binaryFileHeader);
 
-	/* Check the high level parameters */
-	if (chromoA->numInputs != chromoB->numInputs) {
-		return 0;
-	}
+	for (i = 0; i < numChromos; i++) {
 
-	if (chromoA->numNodes != chromoB->numNodes) {
-		return 0;
-	}
+		chromoRecord.numNodes = chromos[i]->numNodes;
+		chromoRecord.arity = chromos[i]->arity;
+		chromoRecord.numOutputs = chromos[i]->numOutputs;
+		chromoRecord.numFunctions = chromos[i]->funcSet->numFunctions;
 
-	if (chromoA->numOutputs != chromoB->numOutputs) {
-		return 0;
+		size += getBinaryChromosomeSize(&chromoRecord, &weightsOffset, &functionsOffset, &inputsOffset, &outputsOffset);
 	}
 
-	if (chromoA->arity != chromoB->arity) {
-		return 0;
-	}
+	buffer = (char*)calloc(size, 1);
 
-	/* for each node*/
-	for (i = 0; i < chromoA->numNodes; i++) {
+	memset(&header, 0, sizeof(struct binaryFileHeader));
+	memcpy(header.magic, "CGPDECH", 8);
+	header.byteOrder = BINARYBYTEORDER;
+	header.version = BINARYFORMATVERSION;
+	header.numRecords = numChromos;
 
-		/* Check the function genes */
-		if (chromoA->nodes[i]->function != chromoB->nodes[i]->function) {
-			return 0;
+	memcpy(buffer, &header, sizeof(struct binaryFileHeader));
+	record = buffer + sizeof(struct binaryFileHeader);
+
+	for (i = 0; i < numChromos; i++) {
+
+		chromoRecord.numInputs = chromos[i]->numInputs;
+		chromoRecord.numNodes = chromos[i]->numNodes;
+		chromoRecord.numOutputs = chromos[i]->numOutputs;
+		chromoRecord.arity = chromos[i]->arity;
+		chromoRecord.numFunctions = chromos[i]->funcSet->numFunctions;
+		chromoRecord.generation = chromos[i]->generation;
+		chromoRecord.fitness = chromos[i]->fitness;
+		chromoRecord.fitnessValidation = chromos[i]->fitnessValidation;
+
+		memcpy(record, &chromoRecord, sizeof(struct binaryChromosomeRecord));
+
+		for (j = 0; j < chromoRecord.numFunctions; j++) {
+			strncpy(record + sizeof(struct binaryChromosomeRecord) + (j * FUNCTIONNAMELENGTH), chromos[i]->funcSet->functionNames[j], FUNCTIONNAMELENGTH - 1);
 		}
 
-		/* for each node input */
-		for (j = 0; j < chromoA->arity; j++) {
+		/* the parts of the record are aligned to CHROMOSOMEALIGNMENT bytes */
+		weights = (double*)(record + weightsOffset);
+		functions = (int32_t*)(record + functionsOffset);
+		inputs = (int32_t*)(record + inputsOffset);
+		outputs = (int32_t*)(record + outputsOffset);
 
-			/* Check the node inputs */
-			if (chromoA->nodes[i]->inputs[j] != chromoB->nodes[i]->inputs[j]) {
-				return 0;
-			}
+		for (j = 0; j < chromoRecord.numNodes; j++) {
 
-			/* Check the connection weights inputs */
-			if (chromoA->nodes[i]->weights[j] != chromoB->nodes[i]->weights[j]) {
-				return 0;
+			memcpy(weights + (j * chromoRecord.arity), chromos[i]->nodes[j]->weights, chromoRecord.arity * sizeof(double));
+			functions[j] = chromos[i]->nodes[j]->function;
+
+			for (k = 0; k < chromoRecord.arity; k++) {
+				inputs[(j * chromoRecord.arity) + k] = chromos[i]->nodes[j]->inputs[k];
 			}
 		}
-	}
-
-	/* for all of the outputs */
-	for (i = 0; i < chromoA->numOutputs; i++) {
 
-		/* Check the outputs */
-		if (chromoA->outputNodes[i] != chromoB->outputNodes[i] ) {
-			return 0;
+		for (j = 0; j < chromoRecord.numOutputs; j++) {
+			outputs[j] = chromos[i]->outputNodes[j];
 		}
+
+		record += getBinaryChromosomeSize(&chromoRecord, &weightsOffset, &functionsOffset, &inputsOffset, &outputsOffset);
 	}
 
-	return 1;
+	*bufferSize = size;
+
+	return buffer;
 }
 
 
-DLL_EXPORT int compareChromosomesActiveNodes(struct chromosome *chromoA, struct chromosome *chromoB) {
+/*
+	returns the size of the binary record of a chromosome of the given
+	dimensions and the offsets of its parts from the start of the record
+*/
+static size_t getBinaryChromosomeSize(struct binaryChromosomeRecord *record, size_t *weightsOffset, size_t *functionsOffset, size_t *inputsOffset, size_t *outputsOffset) {
 
-	int i, j;
+	size_t size = 0;
 
-	/* ensure that the chromosomes don't point to NULL */
-	if (chromoA == NULL || chromoB == NULL) {
-		return 0;
-	}
+	getChromosomePartOffset(&size, sizeof(struct binaryChromosomeRecord) + (record->numFunctions * FUNCTIONNAMELENGTH));
+	*weightsOffset = getChromosomePartOffset(&size, (size_t)record->numNodes * record->arity * sizeof(double));
+	*functionsOffset = getChromosomePartOffset(&size, (size_t)record->numNodes * sizeof(int32_t));
+	*inputsOffset = getChromosomePartOffset(&size, (size_t)record->numNodes * record->arity * sizeof(int32_t));
+	*outputsOffset = getChromosomePartOffset(&size, (size_t)record->numOutputs * sizeof(int32_t));
 
-	/* Check the high level parameters */
-	if (chromoA->numInputs != chromoB->numInputs) {
-		return 0;
-	}
+	return size;
+}
 
-	if (chromoA->numNodes != chromoB->numNodes) {
-		return 0;
-	}
 
-	if (chromoA->numOutputs != chromoB->numOutputs) {
+/*
+	returns 1 if the function names of the given binary chromosome record
+	are those of the given function set, in the same order, otherwise 0
+*/
+static int isBinaryChromosomeFunctionSet(const char *record, struct functionSet *funcSet) {
+
+	int i;
+	struct binaryChromosomeRecord chromoRecord;
+
+	memcpy(&chromoRecord, record, sizeof(struct binaryChromosomeRecord));
+
+	if (chromoRecord.numFunctions != funcSet->numFunctions) {
 		return 0;
 	}
 
-	if (chromoA->arity != chromoB->arity) {
-		return 0;
+	for (i = 0; i < chromoRecord.numFunctions; i++) {
+		if (strncmp(record + sizeof(struct binaryChromosomeRecord) + (i * FUNCTIONNAMELENGTH), funcSet->functionNames[i], FUNCTIONNAMELENGTH - 1) != 0) {
+			return 0;
+		}
 	}
 
-	/* for each node*/
-	for (i = 0; i < chromoA->numNodes; i++) {
+	return 1;
+}
 
-		/* if the node is active in both chromosomes */
-		if (chromoA->nodes[i]->active == 1 && chromoB->nodes[i]->active == 1) {
 
-			/* Check the function genes */
-			if (chromoA->nodes[i]->function != chromoB->nodes[i]->function) {
-				return 0;
-			}
+/*
+	Reads in a chromosome saved by saveChromosomeBinary
+*/
+DLL_EXPORT struct chromosome *initialiseChromosomeFromBinaryFile(char const *file) {
 
-			/* for each node input */
-			for (j = 0; j < chromoA->arity; j++) {
+	int numChromos;
+	struct chromosome **chromos;
+	struct chromosome *chromo;
 
-				/* Check the node inputs */
-				if (chromoA->nodes[i]->inputs[j] != chromoB->nodes[i]->inputs[j]) {
-					return 0;
-				}
-			}
-		}
-		/* if the node is active in one chromosome */
-		else if (chromoA->nodes[i]->active != chromoB->nodes[i]->active ) {
-			return 0;
-		}
+	chromos = initialiseChromosomesFromBinaryFile(file, &numChromos);
 
-		/* The node is inactive in both chromosomes */
-		else {
-			/* do nothing */
-		}
+	if (numChromos != 1) {
+		printf("Error: file '%s' holds %d chromosomes rather than one.\nTerminating CGP-Library.\n", file, numChromos);
+		exit(0);
 	}
 
-	/* for all of the outputs */
-	for (i = 0; i < chromoA->numOutputs; i++) {
-
-		/* Check the outputs */
-		if (chromoA->outputNodes[i] != chromoB->outputNodes[i] ) {
-			return 0;
-		}
-	}
+	chromo = chromos[0];
+	free(chromos);
 
-	return 1;
+	return chromo;
 }
 
 
-DLL_EXPORT int compareChromosomesActiveNodesANN(struct chromosome *chromoA, struct chromosome *chromoB) {
+/*
+	Reads in the chromosomes saved by saveChromosomesBinary. The file is
+	memory mapped and the genes are copied straight into each chromosome.
+*/
+DLL_EXPORT struct chromosome **initialiseChromosomesFromBinaryFile(char const *file, int *numChromos) {
 
 	int i, j;
+	char *contents;
+	const char *record;
+	char funcName[FUNCTIONNAMELENGTH];
+	size_t size, recordSize;
+	size_t weightsOffset, functionsOffset, inputsOffset, outputsOffset;
+	struct binaryChromosomeRecord chromoRecord;
+	struct parameters *params;
+	struct chromosome **chromos;
 
-	/* ensure that the chromosomes don't point to NULL */
-	if (chromoA == NULL || chromoB == NULL) {
-		return 0;
-	}
+	contents = mapFileContents(file, &size);
+	record = getBinaryFileRecords(file, contents, size, "CGPDECH", numChromos);
 
-	/* Check the high level parameters */
-	if (chromoA->numInputs != chromoB->numInputs) {
-		return 0;
-	}
+	chromos = (struct chromosome**)malloc(*numChromos * sizeof(struct chromosome*));
 
-	if (chromoA->numNodes != chromoB->numNodes) {
-		return 0;
-	}
+	for (i = 0; i < *numChromos; i++) {
 
-	if (chromoA->numOutputs != chromoB->numOutputs) {
-		return 0;
-	}
+		if ((size_t)(contents + size - record) < sizeof(struct binaryChromosomeRecord)) {
+			printf("Error: file '%s' is too short to hold %d chromosomes.\nTerminating CGP-Library.\n", file, *numChromos);
+			exit(0);
+		}
 
-	if (chromoA->arity != chromoB->arity) {
-		return 0;
-	}
+		memcpy(&chromoRecord, record, sizeof(struct binaryChromosomeRecord));
 
-	/* for each node*/
-	for (i = 0; i < chromoA->numNodes; i++) {
+		if (chromoRecord.numInputs < 1 || chromoRecord.numNodes < 1 || chromoRecord.numOutputs < 1 || chromoRecord.arity < 1 || chromoRecord.numFunctions < 1 || chromoRecord.numFunctions > FUNCTIONSETSIZE) {
+			printf("Error: chromosome %d of file '%s' is not valid.\nTerminating CGP-Library.\n", i, file);
+			exit(0);
+		}
 
-		/* if the node is active in both chromosomes */
-		if (chromoA->nodes[i]->active == 1 && chromoB->nodes[i]->active == 1) {
+		recordSize = getBinaryChromosomeSize(&chromoRecord, &weightsOffset, &functionsOffset, &inputsOffset, &outputsOffset);
 
-			/* Check the function genes */
-			if (chromoA->nodes[i]->function != chromoB->nodes[i]->function) {
-				return 0;
-			}
+		if ((size_t)(contents + size - record) < recordSize) {
+			printf("Error: file '%s' is too short to hold %d chromosomes.\nTerminating CGP-Library.\n", file, *numChromos);
+			exit(0);
+		}
 
-			/* for each node input */
-			for (j = 0; j < chromoA->arity; j++) {
+		/* the function set is built as for initialiseChromosomeFromFile */
+		params = initialiseParameters(chromoRecord.numInputs, chromoRecord.numNodes, chromoRecord.numOutputs, chromoRecord.arity);
 
-				/* Check the node inputs */
-				if (chromoA->nodes[i]->inputs[j] != chromoB->nodes[i]->inputs[j]) {
-					return 0;
-				}
+		for (j = 0; j < chromoRecord.numFunctions; j++) {
 
-				/* Check the connection weights inputs */
-				if (chromoA->nodes[i]->weights[j] != chromoB->nodes[i]->weights[j]) {
-					return 0;
-				}
+			memcpy(funcName, record + sizeof(struct binaryChromosomeRecord) + (j * FUNCTIONNAMELENGTH), FUNCTIONNAMELENGTH);
+			funcName[FUNCTIONNAMELENGTH - 1] = '\0';
+
+			/* can only load functions defined within CGP-Library */
+			if (addPresetFunctionToFunctionSet(params, funcName) == 0) {
+				printf("Error: cannot load chromosome which contains custom node functions.\n");
+				printf("Terminating CGP-Library.\n");
+				freeParameters(params);
+				exit(0);
 			}
 		}
-		/* if the node is active in one chromosome */
-		else if (chromoA->nodes[i]->active != chromoB->nodes[i]->active ) {
-			return 0;
-		}
 
-		/* The node is inactive in both chromosomes */
-		else {
-			/* do nothing */
-		}
-	}
+		chromos[i] = allocateChromosome(chromoRecord.numInputs, chromoRecord.numNodes, chromoRecord.numOutputs, chromoRecord.arity);
 
-	/* for all of the outputs */
-	for (i = 0; i < chromoA->numOutputs; i++) {
+		/* share the function set of the parameters */
+		chromos[i]->funcSet = retainFunctionSet(params->funcSet);
+		freeParameters(params);
 
-		/* Check the outputs */
-		if (chromoA->outputNodes[i] != chromoB->outputNodes[i] ) {
-			return 0;
-		}
+		setBinaryChromosomeGenes(chromos[i], record);
+
+		record += recordSize;
 	}
 
-	return 1;
+	unmapFileContents(contents, size);
+
+	return chromos;
 }
 
 
 /*
-	Mutates the given chromosome using the mutation method described in parameters
+	copies the genes, fitness and generation of the given binary record into
+	a chromosome of the same dimensions and sets its active nodes
 */
-DLL_EXPORT void mutateChromosome(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed) {
+static void setBinaryChromosomeGenes(struct chromosome *chromo, const char *record) {
 
-	params->mutationType(params, chromo, type, seed);
+	int j, k;
+	const double *weights;
+	const int32_t *functions, *inputs, *outputs;
+	size_t weightsOffset, functionsOffset, inputsOffset, outputsOffset;
+	struct binaryChromosomeRecord chromoRecord;
 
-	setChromosomeActiveNodes(chromo);
-}
+	memcpy(&chromoRecord, record, sizeof(struct binaryChromosomeRecord));
+	getBinaryChromosomeSize(&chromoRecord, &weightsOffset, &functionsOffset, &inputsOffset, &outputsOffset);
 
+	weights = (const double*)(record + weightsOffset);
+	functions = (const int32_t*)(record + functionsOffset);
+	inputs = (const int32_t*)(record + inputsOffset);
+	outputs = (const int32_t*)(record + outputsOffset);
 
-/*
-	removes the inactive nodes from the given chromosome
-*/
-DLL_EXPORT void removeInactiveNodes(struct chromosome *chromo) {
+	for (j = 0; j < chromoRecord.numNodes; j++) {
 
-	int i, j, k;
+		memcpy(chromo->nodes[j]->weights, weights + (j * chromoRecord.arity), chromoRecord.arity * sizeof(double));
+		chromo->nodes[j]->function = functions[j];
+		chromo->nodes[j]->maxArity = chromoRecord.arity;
 
-	int originalNumNodes = chromo->numNodes;
+		for (k = 0; k < chromoRecord.arity; k++) {
+			chromo->nodes[j]->inputs[k] = inputs[(j * chromoRecord.arity) + k];
+		}
+	}
 
-	/* set the active nodes */
-	setChromosomeActiveNodes(chromo);
+	for (j = 0; j < chromoRecord.numOutputs; j++) {
+		chromo->outputNodes[j] = outputs[j];
+	}
 
-	/* for all nodes */
-	for (i = 0; i < chromo->numNodes - 1; i++) {
+	chromo->numActiveNodes = chromoRecord.numNodes;
+	chromo->fitness = chromoRecord.fitness;
+	chromo->fitnessValidation = chromoRecord.fitnessValidation;
+	chromo->generation = chromoRecord.generation;
 
-		/* if the node is inactive */
-		if (chromo->nodes[i]->active == 0) {
+	resetChromosome(chromo);
 
-			/* set the node to be the next node */
-			for (j = i; j < chromo->numNodes - 1; j++) {
-				copyNode(chromo->nodes[j], chromo->nodes[j + 1]);
-			}
+	/* the cached node values were those of the previous genes */
+	clearNodeCache(chromo);
 
-			/* */
-			for (j = 0; j < chromo->numNodes; j++) {
-				for (k = 0; k < chromo->arity; k++) {
+	/* set the active nodes in the loaded chromosome */
+	chromo->activeNodesDirty = 1;
+	setChromosomeActiveNodes(chromo);
+}
 
-					if (chromo->nodes[j]->inputs[k] >= i + chromo->numInputs) {
-						chromo->nodes[j]->inputs[k]--;
-					}
-				}
-			}
 
-			/* for the number of chromosome outputs */
-			for (j = 0; j < chromo->numOutputs; j++) {
+/*
+	checks the header of the given binary file contents and returns the
+	start of its records
+*/
+static const char *getBinaryFileRecords(char const *file, const char *contents, size_t size, const char *magic, int *numRecords) {
 
-				if (chromo->outputNodes[j] >= i + chromo->numInputs) {
-					chromo->outputNodes[j]--;
-				}
-			}
+	struct binaryFileHeader header;
 
-			/* de-increment the number of nodes */
-			chromo->numNodes--;
+	if (size < sizeof(struct binaryFileHeader)) {
+		printf("Error: file '%s' is not a CGP-Library binary file.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
 
-			/* made the newly assigned node be evaluated */
-			i--;
-		}
+	memcpy(&header, contents, sizeof(struct binaryFileHeader));
+
+	if (memcmp(header.magic, magic, 8) != 0) {
+		printf("Error: file '%s' is not a CGP-Library binary %s file.\nTerminating CGP-Library.\n", file, strcmp(magic, "CGPDEDS") == 0 ? "dataSet" : strcmp(magic, "CGPDECK") == 0 ? "checkpoint" : "chromosome");
+		exit(0);
 	}
 
-	for (i = chromo->numNodes; i < originalNumNodes; i++) {
-		freeNode(chromo->nodes[i]);
+	if (header.byteOrder != BINARYBYTEORDER || header.version != BINARYFORMATVERSION) {
+		printf("Error: file '%s' was saved with byte order %x and format version %u but only byte order %x and version %d can be read.\nTerminating CGP-Library.\n", file, (unsigned int)header.byteOrder, (unsigned int)header.version, BINARYBYTEORDER, BINARYFORMATVERSION);
+		exit(0);
 	}
 
-	if (chromo->nodes[chromo->numNodes - 1]->active == 0) {
-		freeNode(chromo->nodes[chromo->numNodes - 1]);
-		chromo->numNodes--;
+	if (header.numRecords < 0) {
+		printf("Error: file '%s' is not valid.\nTerminating CGP-Library.\n", file);
+		exit(0);
 	}
 
-	/* reallocate the memory associated with the chromosome */
-	chromo->nodes = (struct node**)realloc(chromo->nodes, chromo->numNodes * sizeof(struct node*));
-	chromo->activeNodes = (int*)realloc(chromo->activeNodes, chromo->numNodes * sizeof(int));
+	*numRecords = header.numRecords;
 
-	/* set the active nodes */
-	setChromosomeActiveNodes(chromo);
+	return contents + sizeof(struct binaryFileHeader);
 }
 
 
 /*
-	sets the fitness of the given chromosome
+	saves the given record and chromosomes to the checkpoint file of the
+	parameters. The file is written under a temporary name and then renamed,
+	so a run stopped while saving leaves the previous checkpoint whole.
 */
-DLL_EXPORT void setChromosomeFitness(struct parameters *params, struct chromosome *chromo, struct dataSet *data) {
-
-	double fitness;
+static void saveCheckpoint(struct parameters *params, struct binaryCheckpointRecord *checkpointRecord, struct chromosome **chromos, int numChromos) {
 
-	setChromosomeActiveNodes(chromo);
+	FILE *fp;
+	char *buffer;
+	char tempFile[CHECKPOINTFILENAMELENGTH + 4];
+	int saved;
+	size_t size;
+	struct binaryFileHeader header;
 
-	resetChromosome(chromo);
+	/* the chromosomes are held as a binary chromosome file following the record */
+	buffer = getBinaryChromosomes(chromos, numChromos, &size);
 
-	fitness = params->fitnessFunction(params, chromo, data);
+	memset(&header, 0, sizeof(struct binaryFileHeader));
+	memcpy(header.magic, "CGPDECK", 8);
+	header.byteOrder = BINARYBYTEORDER;
+	header.version = BINARYFORMATVERSION;
+	header.numRecords = 1;
 
-	chromo->fitness = fitness;
-}
+	snprintf(tempFile, sizeof(tempFile), "%s.tmp", params->checkpointFile);
 
-/*
-	sets the fitness of the given chromosome - ideally to evaluate the validation set 
-*/
-DLL_EXPORT void setChromosomeFitnessValidation(struct parameters *params, struct chromosome *chromo, struct dataSet *data) {
+	fp = fopen(tempFile, "wb");
 
-	double fitness;
+	saved = fp != NULL;
+	saved = saved && fwrite(&header, sizeof(struct binaryFileHeader), 1, fp) == 1;
+	saved = saved && fwrite(checkpointRecord, sizeof(struct binaryCheckpointRecord), 1, fp) == 1;
+	saved = saved && fwrite(buffer, 1, size, fp) == size;
 
-	setChromosomeActiveNodes(chromo);
+	if (fp != NULL && fclose(fp) != 0) {
+		saved = 0;
+	}
 
-	resetChromosome(chromo);
+#if defined(_WIN32)
+	/* rename does not replace an existing file */
+	if (saved) {
+		remove(params->checkpointFile);
+	}
+#endif
 
-	fitness = params->fitnessFunction(params, chromo, data);
+	if (saved == 0 || rename(tempFile, params->checkpointFile) != 0) {
+		printf("Warning: cannot save checkpoint to '%s'. Checkpoint was not saved.\n", params->checkpointFile);
+	}
 
-	chromo->fitnessValidation = fitness;
+	free(buffer);
 }
 
 
 /*
-	reset the output values of all chromosome nodes to zero
+	reads the record of the given checkpoint file, which must have been saved
+	by the given algorithm, and sets the genes, fitness and generation of
+	chromos to those of its first numChromos chromosomes
 */
-DLL_EXPORT void resetChromosome(struct chromosome *chromo) {
+static void loadCheckpoint(struct parameters *params, char const *file, int algorithm, struct binaryCheckpointRecord *checkpointRecord, struct chromosome **chromos, int numChromos) {
 
 	int i;
-
-	for (i = 0; i < chromo->numNodes; i++) {
-		chromo->nodes[i]->output = 0;
+	int numRecords;
+	char *contents;
+	const char *record;
+	size_t size, recordSize;
+	size_t weightsOffset, functionsOffset, inputsOffset, outputsOffset;
+	struct binaryChromosomeRecord chromoRecord;
+	const char *algorithmNames[] = {"runCGP", "runCGPDE_IN", "runCGPDE_OUT"};
+
+	contents = mapFileContents(file, &size);
+	record = getBinaryFileRecords(file, contents, size, "CGPDECK", &numRecords);
+
+	if (numRecords != 1 || (size_t)(contents + size - record) < sizeof(struct binaryCheckpointRecord)) {
+		printf("Error: file '%s' is not a valid checkpoint.\nTerminating CGP-Library.\n", file);
+		exit(0);
 	}
-}
-
-/*
-	copies the contents of one chromosome to another. Provided the number of inputs, nodes, outputs and node arity are the same.
-*/
-DLL_EXPORT void copyChromosome(struct chromosome *chromoDest, struct chromosome *chromoSrc) {
 
-	int i;
+	memcpy(checkpointRecord, record, sizeof(struct binaryCheckpointRecord));
 
-	/* error checking  */
-	if (chromoDest->numInputs != chromoSrc->numInputs) {
-		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The number of chromosome inputs do not match.\n");
-		printf("Terminating CGP-Library.\n");
+	if (checkpointRecord->algorithm < CHECKPOINTCGP || checkpointRecord->algorithm > CHECKPOINTCGPDE_OUT) {
+		printf("Error: file '%s' is not a valid checkpoint.\nTerminating CGP-Library.\n", file);
 		exit(0);
 	}
 
-	if (chromoDest->numNodes != chromoSrc->numNodes) {
-		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The number of chromosome nodes do not match.\n");
-		printf("Terminating CGP-Library.\n");
+	if (checkpointRecord->algorithm != algorithm) {
+		printf("Error: checkpoint '%s' was saved by %s and so cannot be resumed by %s.\nTerminating CGP-Library.\n", file, algorithmNames[checkpointRecord->algorithm], algorithmNames[algorithm]);
 		exit(0);
 	}
 
-	if (chromoDest->numOutputs != chromoSrc->numOutputs) {
-		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The number of chromosome outputs do not match.\n");
-		printf("Terminating CGP-Library.\n");
-		exit(0);
-	}
+	/* the chromosomes follow as a binary chromosome file */
+	record += sizeof(struct binaryCheckpointRecord);
+	record = getBinaryFileRecords(file, record, contents + size - record, "CGPDECH", &numRecords);
 
-	if (chromoDest->arity != chromoSrc->arity) {
-		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The arity of the chromosome nodes do not match.\n");
-		printf("Terminating CGP-Library.\n");
+	if (numRecords < numChromos) {
+		printf("Error: checkpoint '%s' holds %d chromosomes rather than %d.\nTerminating CGP-Library.\n", file, numRecords, numChromos);
 		exit(0);
 	}
 
-	/* copy nodes and which are active */
-	for (i = 0; i < chromoSrc->numNodes; i++) {
-		copyNode(chromoDest->nodes[i],  chromoSrc->nodes[i]);
-		chromoDest->activeNodes[i] = chromoSrc->activeNodes[i];
-	}
+	for (i = 0; i < numChromos; i++) {
 
-	/* copy functionset */
-	copyFunctionSet(chromoDest->funcSet, chromoSrc->funcSet);
+		if ((size_t)(contents + size - record) < sizeof(struct binaryChromosomeRecord)) {
+			printf("Error: checkpoint '%s' is too short to hold %d chromosomes.\nTerminating CGP-Library.\n", file, numRecords);
+			exit(0);
+		}
 
-	/* copy each of the chromosomes outputs */
-	for (i = 0; i < chromoSrc->numOutputs; i++) {
-		chromoDest->outputNodes[i] = chromoSrc->outputNodes[i];
-	}
+		memcpy(&chromoRecord, record, sizeof(struct binaryChromosomeRecord));
 
-	/* copy the number of active node */
-	chromoDest->numActiveNodes = chromoSrc->numActiveNodes;
+		if (chromoRecord.numInputs != params->numInputs || chromoRecord.numNodes != params->numNodes || chromoRecord.numOutputs != params->numOutputs || chromoRecord.arity != params->arity || chromoRecord.numFunctions != chromos[i]->funcSet->numFunctions) {
+			printf("Error: the chromosomes of checkpoint '%s' do not have the dimensions and function set given by the parameters.\nTerminating CGP-Library.\n", file);
+			exit(0);
+		}
 
-	/* copy the fitness */
-	chromoDest->fitness = chromoSrc->fitness;
-	chromoDest->fitnessValidation = chromoSrc->fitnessValidation;
+		recordSize = getBinaryChromosomeSize(&chromoRecord, &weightsOffset, &functionsOffset, &inputsOffset, &outputsOffset);
 
-	/* copy generation */
-	chromoDest->generation = chromoSrc->generation;
-}
+		if ((size_t)(contents + size - record) < recordSize) {
+			printf("Error: checkpoint '%s' is too short to hold %d chromosomes.\nTerminating CGP-Library.\n", file, numRecords);
+			exit(0);
+		}
 
-/*
-	Gets the number of chromosome inputs
-*/
-DLL_EXPORT int getNumChromosomeInputs(struct chromosome *chromo) {
-	return chromo->numInputs;
-}
+		/* the function genes index the function set, which must be the same as that of the parameters */
+		if (isBinaryChromosomeFunctionSet(record, chromos[i]->funcSet) == 0) {
+			printf("Error: the chromosomes of checkpoint '%s' do not have the function set given by the parameters.\nTerminating CGP-Library.\n", file);
+			exit(0);
+		}
 
-/*
-	Gets the number of chromosome nodes
-*/
-DLL_EXPORT int getNumChromosomeNodes(struct chromosome *chromo) {
-	return chromo->numNodes;
-}
+		setBinaryChromosomeGenes(chromos[i], record);
 
-/*
-	Gets the number of chromosome active nodes
-*/
-DLL_EXPORT int getNumChromosomeActiveNodes(struct chromosome *chromo) {
-	return chromo->numActiveNodes;
-}
+		record += recordSize;
+	}
 
-/*
-	Gets the number of chromosome outputs
-*/
-DLL_EXPORT int getNumChromosomeOutputs(struct chromosome *chromo) {
-	return chromo->numOutputs;
+	unmapFileContents(contents, size);
 }
 
+
 /*
-	Gets the chromosome node arity
+	saves the parents, children, best chromosome and stopping state of the
+	given completed generation of runCGP, runCGPDE_IN or runCGPDE_OUT when
+	a checkpoint is due
 */
-DLL_EXPORT int getChromosomeNodeArity(struct chromosome *chromo, int index) {
+static void saveCGPCheckpoint(struct parameters *params, int algorithm, int generation, struct chromosome **parents, struct chromosome **children, struct chromosome *best, struct stoppingState *stopping, unsigned int * seed) {
 
-	int chromoArity = chromo->arity;
-	int maxArity = chromo->funcSet->maxNumInputs[chromo->nodes[index]->function];
+	struct chromosome **chromos;
+	struct binaryCheckpointRecord checkpointRecord;
 
-	if (maxArity == -1) {
-		return chromoArity;
-	}
-	else if (maxArity < chromoArity) {
-		return maxArity;
-	}
-	else {
-		return chromoArity;
+	if (params->checkpointInterval == 0 || generation % params->checkpointInterval != 0) {
+		return;
 	}
-}
-
-/*
-	Gets the chromosome fitness
-*/
-DLL_EXPORT double getChromosomeFitness(struct chromosome *chromo) {
-	return chromo->fitness;
-}
 
-/*
-	Gets the number of active connections in the given chromosome
-*/
-DLL_EXPORT int getNumChromosomeActiveConnections(struct chromosome *chromo) {
+	chromos = (struct chromosome**)malloc((params->mu + params->lambda + 1) * sizeof(struct chromosome*));
 
-	int i;
-	int complexity = 0;
+	memcpy(chromos, parents, params->mu * sizeof(struct chromosome*));
+	memcpy(chromos + params->mu, children, params->lambda * sizeof(struct chromosome*));
+	chromos[params->mu + params->lambda] = best;
 
-	for (i = 0; i < chromo->numActiveNodes; i++) {
-		complexity += chromo->nodes[chromo->activeNodes[i]]->actArity;
-	}
+	memset(&checkpointRecord, 0, sizeof(struct binaryCheckpointRecord));
+	checkpointRecord.algorithm = algorithm;
+	checkpointRecord.generation = generation;
+	checkpointRecord.iteration = -1;
+	checkpointRecord.seed = *seed;
+	checkpointRecord.lastImprovement = stopping->lastImprovement;
 
-	return complexity;
-}
+	saveCheckpoint(params, &checkpointRecord, chromos, params->mu + params->lambda + 1);
 
-/*
-	Gets the number of generations required to find the given chromosome
-*/
-DLL_EXPORT int getChromosomeGenerations(struct chromosome *chromo) {
-	return chromo->generation;
+	free(chromos);
 }
 
 
 /*
-	set the active nodes in the given chromosome
+	sets the parents, children, best chromosome, stopping state and seed to
+	those saved by saveCGPCheckpoint, returning the number of generations
+	completed. The start time of the stopping state is left unchanged
 */
-static void setChromosomeActiveNodes(struct chromosome *chromo) {
+static int loadCGPCheckpoint(struct parameters *params, char const *file, int algorithm, struct chromosome **parents, struct chromosome **children, struct chromosome *best, struct stoppingState *stopping, unsigned int * seed) {
 
-	int i;
+	struct chromosome **chromos;
+	struct binaryCheckpointRecord checkpointRecord;
 
-	/* error checking */
-	if (chromo == NULL) {
-		printf("Error: chromosome has not been initialised and so the active nodes cannot be set.\n");
-		return;
-	}
+	chromos = (struct chromosome**)malloc((params->mu + params->lambda + 1) * sizeof(struct chromosome*));
 
-	/* set the number of active nodes to zero */
-	chromo->numActiveNodes = 0;
+	memcpy(chromos, parents, params->mu * sizeof(struct chromosome*));
+	memcpy(chromos + params->mu, children, params->lambda * sizeof(struct chromosome*));
+	chromos[params->mu + params->lambda] = best;
 
-	/* reset the active nodes */
-	for (i = 0; i < chromo->numNodes; i++) {
-		chromo->nodes[i]->active = 0;
-	}
+	loadCheckpoint(params, file, algorithm, &checkpointRecord, chromos, params->mu + params->lambda + 1);
 
-	/* start the recursive search for active nodes from the output nodes for the number of output nodes */
-	for (i = 0; i < chromo->numOutputs; i++) {
+	free(chromos);
 
-		/* if the output connects to a chromosome input, skip */
-		if (chromo->outputNodes[i] < chromo->numInputs) {
-			continue;
-		}
+	stopping->bestFitnessValidation = best->fitnessValidation;
+	stopping->lastImprovement = checkpointRecord.lastImprovement;
 
-		/* begin a recursive search for active nodes */
-		recursivelySetActiveNodes(chromo, chromo->outputNodes[i]);
-	}
+	*seed = checkpointRecord.seed;
 
-	/* place active nodes in order */
-	sortIntArray(chromo->activeNodes, chromo->numActiveNodes);
+	return checkpointRecord.generation;
 }
 
 
 /*
-	used by setActiveNodes to recursively search for active nodes
+	saves the chromosome whose weights are evolved by the DE of CGPDE-OUT and
+	the DE population after the given completed iteration when a checkpoint is due
 */
-static void recursivelySetActiveNodes(struct chromosome *chromo, int nodeIndex) {
+static void saveDECheckpoint(struct parameters *params, int iteration, struct chromosome *chromo, struct DEChromosome **DEChromos, int NP, unsigned int * seed) {
 
 	int i;
+	struct chromosome **chromos;
+	struct binaryCheckpointRecord checkpointRecord;
 
-	/* if the given node is an input, stop */
-	if (nodeIndex < chromo->numInputs) {
+	if (params->checkpointInterval == 0 || iteration % params->checkpointInterval != 0) {
 		return;
 	}
 
-	/* if the given node has already been flagged as active */
-	if (chromo->nodes[nodeIndex - chromo->numInputs]->active == 1) {
-		return;
+	chromos = (struct chromosome**)malloc((NP + 1) * sizeof(struct chromosome*));
+
+	chromos[0] = chromo;
+
+	for (i = 0; i < NP; i++) {
+		chromos[i + 1] = DEChromos[i]->chromo;
 	}
 
-	/* log the node as active */
-	chromo->nodes[nodeIndex - chromo->numInputs]->active = 1;
-	chromo->activeNodes[chromo->numActiveNodes] = nodeIndex - chromo->numInputs;
-	chromo->numActiveNodes++;
+	memset(&checkpointRecord, 0, sizeof(struct binaryCheckpointRecord));
+	checkpointRecord.algorithm = CHECKPOINTCGPDE_OUT;
+	checkpointRecord.generation = -1;
+	checkpointRecord.iteration = iteration;
+	checkpointRecord.seed = *seed;
 
-	/* set the nodes actual arity*/
-	chromo->nodes[nodeIndex - chromo->numInputs]->actArity = getChromosomeNodeArity(chromo, nodeIndex - chromo->numInputs);
+	saveCheckpoint(params, &checkpointRecord, chromos, NP + 1);
 
-	/* recursively log all the nodes to which the current nodes connect as active */
-	for (i = 0; i < chromo->nodes[nodeIndex - chromo->numInputs]->actArity; i++) {
-		recursivelySetActiveNodes(chromo, chromo->nodes[nodeIndex - chromo->numInputs]->inputs[i]);
-	}
+	free(chromos);
 }
 
-static int recursivelySearchDepth(struct chromosome *chromo, int nodeIndex, int currentDepth, int *maxDepth, int * depthPerNode, int * buffer)
-{
-	/* if the given node is an input, stop */
-	if (nodeIndex < chromo->numInputs) 
-	{
-		if( currentDepth > (*maxDepth) )
-		{
-			(*maxDepth) = currentDepth;
-		}
-		return 0;
-	}
 
-	if ( depthPerNode[nodeIndex - chromo->numInputs] > 0 )
-	{
-		if( depthPerNode[nodeIndex - chromo->numInputs] + currentDepth > (*maxDepth) )
-		{			
-			(*maxDepth) = depthPerNode[nodeIndex - chromo->numInputs] + currentDepth;
-		}
-		return (depthPerNode[nodeIndex - chromo->numInputs]);
-	}
+/*
+	sets the chromosome, DE population and seed to those saved by
+	saveDECheckpoint, returning the number of DE iterations completed
+*/
+static int loadDECheckpoint(struct parameters *params, char const *file, struct chromosome *chromo, struct DEChromosome **DEChromos, int NP, unsigned int * seed) {
 
-	buffer[nodeIndex - chromo->numInputs] = 1;
+	int i;
+	struct chromosome **chromos;
+	struct binaryCheckpointRecord checkpointRecord;
 
-	int i, j;	
+	chromos = (struct chromosome**)malloc((NP + 1) * sizeof(struct chromosome*));
 
-	currentDepth++;
+	chromos[0] = chromo;
 
-	/* recursively log all the nodes to which the current nodes connect as active */
-	for (i = 0; i < chromo->nodes[nodeIndex - chromo->numInputs]->actArity; i++) 
-	{
-		int res = recursivelySearchDepth(chromo, chromo->nodes[nodeIndex - chromo->numInputs]->inputs[i], currentDepth, maxDepth, depthPerNode, buffer);
-		
-		int sum = 1 + res;
+	for (i = 0; i < NP; i++) {
+		chromos[i + 1] = DEChromos[i]->chromo;
+	}
 
-		for(j = 0; j < nodeIndex - chromo->numInputs; j++)
-		{
-			sum += buffer[j];
-			buffer[j] = 0;
-		}
+	loadCheckpoint(params, file, CHECKPOINTCGPDE_OUT, &checkpointRecord, chromos, NP + 1);
 
-		if( sum > -depthPerNode[nodeIndex - chromo->numInputs] )
-		{
-			depthPerNode[nodeIndex - chromo->numInputs] = -sum;
-			buffer[nodeIndex - chromo->numInputs] = sum;
-		}
+	free(chromos);
+
+	/* the weights vectors are those of the loaded chromosomes */
+	for (i = 0; i < NP; i++) {
+		transferChromoToWeightsVector(params, DEChromos[i]);
 	}
 
-	depthPerNode[nodeIndex - chromo->numInputs] = -depthPerNode[nodeIndex - chromo->numInputs];
-	return 0;
+	*seed = checkpointRecord.seed;
+
+	return checkpointRecord.iteration;
 }
 
+
 /*
-	get the depth of the given chromosome
-	depth is defined as the largest number of active nodes between the input and output
+	save the given chromosome to a graphviz .dot file
+	(www.graphviz.org/‎)
 */
-DLL_EXPORT int getChromosomeDepth(struct chromosome *chromo)
-{
-	int i;
-	int maxDepth = -1, currentDepth = 0;
+DLL_EXPORT void saveChromosomeDot(struct chromosome *chromo, int weights, char const *fileName) {
 
-	removeInactiveNodes(chromo);
+	int i, j;
+	FILE *fp;
 
-	int * depthPerNode = (int*)malloc(chromo->numActiveNodes * sizeof(int));
-	memset(depthPerNode, 0, chromo->numActiveNodes * sizeof(int));
+	char colour[20];
+	char weight[20];
 
-	int * buffer = (int*)malloc(chromo->numActiveNodes * sizeof(int));
-	
-	for(i = 0; i < chromo->numOutputs; i++)
-	{
-		currentDepth = 0;
-		memset(buffer, 0, chromo->numActiveNodes * sizeof(int));
+	fp = fopen(fileName, "w");
 
-		// begin a recursive search the maximum depth
-		recursivelySearchDepth(chromo, chromo->outputNodes[i], currentDepth, &maxDepth, depthPerNode, buffer);
+	if (fp == NULL) {
+		return;
 	}
 
-	return maxDepth;
-}
+	/* */
+	fprintf(fp, "digraph NeuralNetwork {\n");
 
-/*
-	Sorts the given array of chromosomes by fitness, lowest to highest
-	uses insertion sort (quickish and stable)
-*/
-static void sortChromosomeArray(struct chromosome **chromoArray, int numChromos) {
+	/* landscape, square and centre */
+	fprintf(fp, "rankdir=LR;\n");
+	fprintf(fp, "size=\"4,3\";\n");
+	fprintf(fp, "center = true;\n");
 
-	int i, j;
-	struct chromosome *chromoTmp;
+	/* for all the inputs */
+	for (i = 0; i < getNumChromosomeInputs(chromo); i++) {
 
-	for (i = 0; i < numChromos; i++) {
-		for (j = i; j < numChromos; j++) {
+		fprintf(fp, "node%d [label=\"(%d) Input\", color=black, labelfontcolor=black, fontcolor=black];\n", i, i);
+	}
 
-			if (chromoArray[i]->fitness > chromoArray[j]->fitness) {
-				chromoTmp = chromoArray[i];
-				chromoArray[i] = chromoArray[j];
-				chromoArray[j] = chromoTmp;
-			}
+	/* for all nodes */
+	for (i = 0; i < getNumChromosomeNodes(chromo); i++) {
+
+		if (chromo->nodes[i]->active == 1) {
+			strncpy(colour, "black", 20);
+		}
+		else {
+			strncpy(colour, "lightgrey", 20);
 		}
-	}
-}
 
+		fprintf(fp, "node%d [label=\"(%d) %s\", color=%s, labelfontcolor=%s, fontcolor=%s];\n", i + getNumChromosomeInputs(chromo), i + getNumChromosomeInputs(chromo), chromo->funcSet->functionNames[chromo->nodes[i]->function], colour, colour, colour);
 
+		/* for each node input */
+		for (j = 0; j < getChromosomeNodeArity(chromo, i); j++) {
 
-/*
-	Dataset functions
-*/
+			if (weights == 1) {
+				snprintf(weight, 20, "%.2f", chromo->nodes[i]->weights[j]);
+			}
+			else {
+				snprintf(weight, 20, " (%d)", j);
+			}
 
 
-/*
-	Initialises data structure and assigns values for given arrays
-	arrays must take the form
-	inputs[numSamples][numInputs]
-	outputs[numSamples][numOutputs]
-*/
-DLL_EXPORT struct dataSet *initialiseDataSetFromArrays(int numInputs, int numOutputs, int numSamples, double *inputs, double *outputs) {
+			fprintf(fp, "node%d -> node%d [label=\"%s\", labelfontcolor=%s, fontcolor=%s, bold=true, color=%s];\n", chromo->nodes[i]->inputs[j], i + getNumChromosomeInputs(chromo), weight, colour, colour, colour);
+		}
+	}
 
-	int i, j;
-	struct dataSet *data;
+	for (i = 0; i < getNumChromosomeOutputs(chromo); i++) {
 
-	/* initialise memory for data structure */
-	data = (struct dataSet*)malloc(sizeof(struct dataSet));
+		fprintf(fp, "node%d [label=\"Output %d\", color=black, labelfontcolor=black, fontcolor=black];\n", i + getNumChromosomeInputs(chromo) + getNumChromosomeNodes(chromo), i);
 
-	data->numInputs = numInputs;
-	data->numOutputs = numOutputs;
-	data->numSamples = numSamples;
+		fprintf(fp, "node%d -> node%d [labelfontcolor=black, fontcolor=black, bold=true, color=black];\n", chromo->outputNodes[i], i + getNumChromosomeInputs(chromo) + getNumChromosomeNodes(chromo));
+	}
 
-	data->inputData = (double**)malloc(data->numSamples * sizeof(double*));
-	data->outputData = (double**)malloc(data->numSamples * sizeof(double*));
 
-	for (i = 0; i < data->numSamples; i++) {
+	/* place inputs  on same line */
+	fprintf(fp, "{ rank = source;");
 
-		data->inputData[i] = (double*)malloc(data->numInputs * sizeof(double));
-		data->outputData[i] = (double*)malloc(data->numOutputs * sizeof(double));
+	for (i = 0; i < getNumChromosomeInputs(chromo); i++) {
+		fprintf(fp, " \"node%d\";", i);
+	}
+	fprintf(fp, " }\n");
 
-		for (j = 0; j < data->numInputs; j++) {
-			data->inputData[i][j] = inputs[(i * data->numInputs) + j];
-		}
 
-		for (j = 0; j < data->numOutputs; j++) {
-			data->outputData[i][j] = outputs[(i * data->numOutputs) + j];
-		}
+	/* place outputs  on same line */
+	fprintf(fp, "{ rank = max;");
+
+	for (i = 0; i < getNumChromosomeOutputs(chromo); i++) {
+		fprintf(fp, "\"node%d\";", i + getNumChromosomeInputs(chromo) + getNumChromosomeNodes(chromo));
 	}
+	fprintf(fp, " }\n");
 
-	return data;
+
+	/* last line of dot file */
+	fprintf(fp, "}");
+
+	fclose(fp);
 }
 
 
 /*
-	Initialises data structure and assigns values of given file
+	save the given chromosome as a latex equation
+
+	Only compatible with feed-forward networks
+	Only fully compatible with custom node functions
 */
-DLL_EXPORT struct dataSet *initialiseDataSetFromFile(char const *file) {
+DLL_EXPORT void saveChromosomeLatex(struct chromosome *chromo, int weights, char const *fileName) {
 
+	int output;
 	int i;
-	struct dataSet *data;
 	FILE *fp;
-	char *line, *record;
-	char buffer[1024];
-	int lineNum = -1;
-	int col;
 
-	/* attempt to open the given file */
-	fp = fopen(file, "r");
+	fp = fopen(fileName, "w");
 
-	/* if the file cannot be found */
 	if (fp == NULL) {
-		printf("Error: file '%s' cannot be found.\nTerminating CGP-Library.\n", file);
-		exit(0);
+		return;
 	}
 
-	/* initialise memory for data structure */
-	data = (struct dataSet*)malloc(sizeof(struct dataSet));
-
-	/* for every line in the given file */
-	while ( (line = fgets(buffer, sizeof(buffer), fp)) != NULL) {
-
-		/* deal with the first line containing meta data */
-		if (lineNum == -1) {
+	/* document header */
+	fprintf(fp, "\\documentclass{article}\n");
+	fprintf(fp, "\\begin{document}\n");
 
-			sscanf(line, "%d,%d,%d", &(data->numInputs), &(data->numOutputs), &(data->numSamples));
+	for (output = 0; output < chromo->numOutputs; output++) {
 
-			data->inputData = (double**)malloc(data->numSamples * sizeof(double*));
-			data->outputData = (double**)malloc(data->numSamples * sizeof(double*));
+		fprintf(fp, "\\begin{equation}\n");
 
-			for (i = 0; i < data->numSamples; i++) {
-				data->inputData[i] = (double*)malloc(data->numInputs * sizeof(double));
-				data->outputData[i] = (double*)malloc(data->numOutputs * sizeof(double));
-			}
+		/* function inputs */
+		if (chromo->numInputs == 0) {
+			fprintf(fp, "f()=");
 		}
-		/* the other lines contain input output pairs */
 		else {
 
-			/* get the first value on the given line */
-			record = strtok(line, " ,\n");
-			col = 0;
+			fprintf(fp, "f_%d(x_0", output);
 
-			/* until end of line */
-			while (record != NULL) {
+			for (i = 1; i < chromo->numInputs; i++) {
 
-				/* if its an input value */
-				if (col < data->numInputs) {
-					data->inputData[lineNum][col] = atof(record);
-				}
+				fprintf(fp, ",x_%d", i);
+			}
 
-				/* if its an output value */
-				else {
+			fprintf(fp, ")=");
+		}
 
-					data->outputData[lineNum][col - data->numInputs] = atof(record);
-				}
+		saveChromosomeLatexRecursive(chromo, chromo->outputNodes[output], fp);
 
-				/* get the next value on the given line */
-				record = strtok(NULL, " ,\n");
+		fprintf(fp, "\n\\end{equation}");
+	}
 
-				/* increment the current col index */
-				col++;
-			}
-		}
 
-		/* increment the current line index */
-		lineNum++;
-	}
+	/* document footer */
+	fprintf(fp, "\n\\end{document}");
 
 	fclose(fp);
-
-	return data;
 }
 
-/* 
-	Cross-validation functions 
+/*
+	used by saveChromosomeLatex
 */
+static void saveChromosomeLatexRecursive(struct chromosome *chromo, int index, FILE *fp) {
 
-/* Shuffle the rows of a given dataset */
-
-DLL_EXPORT void shuffleData(struct dataSet *data, unsigned int * seed)
-{
 	int i;
-	for(i = 0; i < data->numSamples; i++)
-	{
-		int rnd1 = randInt(data->numSamples, seed);  
-		int rnd2 = randInt(data->numSamples, seed); 
-
-		double * row1_input = (double*)malloc(data->numInputs * sizeof(double));
-		double * row1_output = (double*)malloc(data->numOutputs * sizeof(double));
 
-		double * row2_input = (double*)malloc(data->numInputs * sizeof(double));
-		double * row2_output = (double*)malloc(data->numOutputs * sizeof(double));
+	if (index < chromo->numInputs) {
+		fprintf(fp, "x_%d", index);
+		return;
+	}
 
-		memcpy(row1_input, data->inputData[rnd1], data->numInputs * sizeof(double));
-		memcpy(row1_output, data->outputData[rnd1], data->numOutputs * sizeof(double));
+	/* add */
+	if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "add", FUNCTIONNAMELENGTH) == 0 ) {
 
-		memcpy(row2_input, data->inputData[rnd2], data->numInputs * sizeof(double));
-		memcpy(row2_output, data->outputData[rnd2], data->numOutputs * sizeof(double));
+		fprintf(fp, "\\left(");
 
-		memcpy(data->inputData[rnd1], row2_input, data->numInputs * sizeof(double));
-		memcpy(data->outputData[rnd1], row2_output, data->numOutputs * sizeof(double));
+		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-		memcpy(data->inputData[rnd2], row1_input, data->numInputs * sizeof(double));
-		memcpy(data->outputData[rnd2], row1_output, data->numOutputs * sizeof(double));
+		for (i = 1; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
 
-		free(row1_input);
-		free(row1_output);
-		free(row2_input);
-		free(row2_output);
-	}
-}
+			fprintf(fp, " + ");
 
-/* Create 10 folds of approximately the same size, keeping the same class proportion in each fold */
+			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
+		}
 
-DLL_EXPORT struct dataSet ** generateFolds(struct dataSet * data)
-{
-	int i, j, k, l;
-	int count;
-	struct dataSet ** folds = (struct dataSet**)malloc(10 * sizeof(struct dataSet*));
-	for (i = 0; i < 10; i++) 
-	{
-		folds[i] = (struct dataSet*)malloc(sizeof(struct dataSet));
-		folds[i]->numInputs = data->numInputs;
-		folds[i]->numOutputs = data->numOutputs;
-		folds[i]->numSamples = 0;
+		fprintf(fp, "\\right)");
 	}
 
-	i = 0;
-	count = 0;
-	while(1) // set the size of each fold
-	{
-		folds[i]->numSamples = folds[i]->numSamples + 1;
-		count++;
-		if(count == data->numSamples)
-			break;
-		if(i == 9)
-			i = 0;
-		else
-			i++;
-	}
 
-	// allocate memory for the folds data
-	for(i = 0; i < 10; i++) // for each fold
-	{
-		folds[i]->inputData = (double**)malloc(folds[i]->numSamples * sizeof(double*));
-		folds[i]->outputData = (double**)malloc(folds[i]->numSamples * sizeof(double*));
+	/* sub */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "sub", FUNCTIONNAMELENGTH) == 0 ) {
 
-		for(j = 0; j < folds[i]->numSamples; j++) // for each instance of each fold
-		{
-			folds[i]->inputData[j] = (double*)malloc(folds[i]->numInputs * sizeof(double));
-			folds[i]->outputData[j] = (double*)malloc(folds[i]->numOutputs * sizeof(double));
-		}
-	}
+		fprintf(fp, "\\left(");
 
-	// keep the same class proportion in each fold
-	int * counter = (int*)malloc(10*sizeof(int));
-	for(i = 0; i < 10; i++)
-	{
-		counter[i] = 0;
-	} 
+		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-	k = 0;
-	for(i = 0; i < data->numOutputs; i++) // for each class
-	{
-		for(j = 0; j < data->numSamples; j++) // for each instance
-		{
-			if(data->outputData[j][i] == 1.0)
-			{
-				for (l = 0; l < data->numInputs; l++) 
-				{
-					folds[k]->inputData[counter[k]][l] = data->inputData[j][l];
-				}
+		for (i = 1; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
 
-				for (l = 0; l < data->numOutputs; l++) 
-				{
-					folds[k]->outputData[counter[k]][l] = data->outputData[j][l];
-				}
+			fprintf(fp, " - ");
 
-				counter[k] = counter[k] + 1;
-				if(k == 9)
-					k = 0;
-				else
-					k++;				
-			}
+			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
 		}
+
+		fprintf(fp, "\\right)");
 	}
 
-	return folds;
-}
+	/* mul */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "mul", FUNCTIONNAMELENGTH) == 0 ) {
 
-/* 
-	Reduce the sample size of the dataset 
-	Utilizes only a percentage of the dataset sample size
-*/
-DLL_EXPORT struct dataSet * reduceSampleSize(struct dataSet * data, double percentage)
-{
-	if(percentage <= 0.001 || percentage >= 0.999)
-	{
-		return data;
-	}
+		fprintf(fp, "\\left(");
 
-	int i, j, l;
-	struct dataSet * reducedData = (struct dataSet *)malloc(sizeof(struct dataSet));
+		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-	reducedData->numInputs = data->numInputs;
-	reducedData->numOutputs = data->numOutputs;
-	reducedData->numSamples = (int) (percentage * data->numSamples);
+		for (i = 1; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
 
-	// allocate memory for the data
-	reducedData->inputData = (double**)malloc(reducedData->numSamples * sizeof(double*));
-	reducedData->outputData = (double**)malloc(reducedData->numSamples * sizeof(double*));
+			fprintf(fp, " \\times ");
 
-	for (i = 0; i < reducedData->numSamples; i++) 
-	{
-		reducedData->inputData[i] = (double*)malloc(reducedData->numInputs * sizeof(double));
-		reducedData->outputData[i] = (double*)malloc(reducedData->numOutputs * sizeof(double));
-	}	
+			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
+		}
 
-	// count the number of instances of each class
-	int * class_size = (int *)malloc(data->numOutputs * sizeof(int));
-	for(i = 0; i < data->numOutputs; i++)
-	{
-		class_size[i] = 0;
+		fprintf(fp, "\\right)");
 	}
 
-	for(i = 0; i < data->numOutputs; i++) // for each class
-	{
-		for(j = 0; j < data->numSamples; j++) // for each instance
-		{
-			if(data->outputData[j][i] == 1.0)
-			{
-				class_size[i] = class_size[i] + 1;
-			}
-		}		
-	}	
-
-	// apply the percentage reduction to each class size
-	for(i = 0; i < data->numOutputs; i++)
-	{
-		class_size[i] = (int) (percentage * class_size[i]);
-	}	
-
-	// adjust the differences between the class_size and the reducedData->numSamples
-	int sum = 0;
-	for(i = 0; i < data->numOutputs; i++)
-	{
-		sum += class_size[i];
-	}
-	
-	int diff = reducedData->numSamples - sum;
-	
-	int counter = 0;
-	for(i = 0; i < diff; i++)
-	{
-		class_size[counter] = class_size[counter] + 1;
+	/* div (change to frac)*/
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "div", FUNCTIONNAMELENGTH) == 0 ) {
 
-		counter++;
-		if(counter == reducedData->numOutputs)
-		{
-			counter = 0;
+		if (getChromosomeNodeArity(chromo, index - chromo->numInputs) == 1) {
+			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 		}
-	}
-
-	// keep the same class proportion during the reduction
-	int class_counter = 0;
-	int sample_counter = 0;
-	int flag_sample_max = 0;
+		else {
 
-	for(i = 0; i < data->numOutputs; i++) // for each class
-	{
-		for(j = 0; j < data->numSamples; j++) // for each instance
-		{
-			if(data->outputData[j][i] == 1.0)
-			{
-				for (l = 0; l < data->numInputs; l++) 
-				{
-					reducedData->inputData[sample_counter][l] = data->inputData[j][l];
-				}
+			for (i = 0; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
 
-				for (l = 0; l < data->numOutputs; l++) 
-				{
-					reducedData->outputData[sample_counter][l] = data->outputData[j][l];
+				if (i + 1 < getChromosomeNodeArity(chromo, index - chromo->numInputs)) {
+					fprintf(fp, "\\frac{");
+					saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
+					fprintf(fp, "}{");
 				}
-
-				sample_counter++;	
-				if(sample_counter == reducedData->numSamples)
-				{
-					flag_sample_max = 1;
-					break;			
+				else if (i + 1 == getChromosomeNodeArity(chromo, index - chromo->numInputs) && getChromosomeNodeArity(chromo, index - chromo->numInputs) > 2) {
+					saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
+					fprintf(fp, "}}");
 				}
-
-				class_counter++;
-				if(class_counter == class_size[i])
-				{
-					class_counter = 0;
-					break;
+				else {
+					saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
+					fprintf(fp, "}");
 				}
 			}
 		}
-
-		if(flag_sample_max == 1)
-		{
-			break;
-		}
 	}
 
-	free(class_size);
-	return reducedData;
-}
+	/* abs */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "abs", FUNCTIONNAMELENGTH) == 0 ) {
 
-/* Randomly distributes the folds for the training and validation sets */
+		fprintf(fp, " \\left|");
 
-DLL_EXPORT void getIndex(int * training_index, int * validation_index, int testing_index, unsigned int * seed)
-{
-	do
-	{
-		training_index[0] = randInt(10, seed);
-	} 
-	while(testing_index == training_index[0]);
+		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-	do
-	{
-		training_index[1] = randInt(10, seed);
-	} 
-	while(testing_index == training_index[1] || training_index[1] == training_index[0]);
+		fprintf(fp, " \\right|");
 
-	do
-	{
-		training_index[2] = randInt(10, seed);
-	} 
-	while(testing_index == training_index[2] || training_index[2] == training_index[0] || training_index[2] == training_index[1]);
+	}
 
-	do
-	{
-		training_index[3] = randInt(10, seed);
-	} 
-	while(testing_index == training_index[3] || training_index[3] == training_index[0] || training_index[3] == training_index[1] || training_index[3] == training_index[2]);
+	/* sqrt */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "sqrt", FUNCTIONNAMELENGTH) == 0 ) {
 
-	do
-	{
-		training_index[4] = randInt(10, seed);
-	} 
-	while(testing_index == training_index[4] || training_index[4] == training_index[0] || training_index[4] == training_index[1] || training_index[4] == training_index[2] || training_index[4] == training_index[3]);
+		fprintf(fp, " \\sqrt{");
 
-	do
-	{
-		training_index[5] = randInt(10, seed);
-	} 
-	while(testing_index == training_index[5] || training_index[5] == training_index[0] || training_index[5] == training_index[1] || training_index[5] == training_index[2] || training_index[5] == training_index[3] || training_index[5] == training_index[4]);
+		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-	do
-	{
-		training_index[6] = randInt(10, seed);
-	} 
-	while(testing_index == training_index[6] || training_index[6] == training_index[0] || training_index[6] == training_index[1] || training_index[6] == training_index[2] || training_index[6] == training_index[3] || training_index[6] == training_index[4] || training_index[6] == training_index[5]);
+		fprintf(fp, " }");
 
-	do
-	{
-		validation_index[0] = randInt(10, seed);
-	} 
-	while(testing_index == validation_index[0] || validation_index[0] == training_index[0] || validation_index[0] == training_index[1] || validation_index[0] == training_index[2] || validation_index[0] == training_index[3] || validation_index[0] == training_index[4] || validation_index[0] == training_index[5] || validation_index[0] == training_index[6]);
+	}
 
-	do
-	{
-		validation_index[1] = randInt(10, seed);
-	} 
-	while(testing_index == validation_index[1] || validation_index[1] == training_index[0] || validation_index[1] == training_index[1] || validation_index[1] == training_index[2] || validation_index[1] == training_index[3] || validation_index[1] == training_index[4] || validation_index[1] == training_index[5] || validation_index[1] == training_index[6] || validation_index[1] == validation_index[0]);
 
-}
+	/* sq */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "sq", FUNCTIONNAMELENGTH) == 0 ) {
 
-/* Build training data set */
+		fprintf(fp, " (");
 
-DLL_EXPORT struct dataSet * getTrainingData(struct dataSet ** folds, int * training_index)
-{
-	int i, j, k, l;
-	struct dataSet * trainingData = (struct dataSet*)malloc(sizeof(struct dataSet));
+		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+
+		fprintf(fp, " )^2");
 
-	trainingData->numInputs = folds[0]->numInputs;
-	trainingData->numOutputs = folds[0]->numOutputs;
-	trainingData->numSamples = 0;
-	
-	for(i = 0; i < 7; i++) // calculate the number of instances
-	{
-		trainingData->numSamples = trainingData->numSamples + folds[training_index[i]]->numSamples;
 	}
 
-	// allocate memory for the data
-	trainingData->inputData = (double**)malloc(trainingData->numSamples * sizeof(double*));
-	trainingData->outputData = (double**)malloc(trainingData->numSamples * sizeof(double*));
+	/* cube */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "cube", FUNCTIONNAMELENGTH) == 0 ) {
 
-	for (i = 0; i < trainingData->numSamples; i++) 
-	{
-		trainingData->inputData[i] = (double*)malloc(trainingData->numInputs * sizeof(double));
-		trainingData->outputData[i] = (double*)malloc(trainingData->numOutputs * sizeof(double));
-	}
+		fprintf(fp, " (");
 
-	l = 0;
-	for (i = 0; i < 7; i++) // for each fold
-	{
-		for(j = 0; j < folds[training_index[i]]->numSamples; j++) // for each instance of each fold
-		{	
-			for (k = 0; k < trainingData->numInputs; k++) 
-			{
-				trainingData->inputData[l][k] = folds[training_index[i]]->inputData[j][k];
-			}
+		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-			for (k = 0; k < trainingData->numOutputs; k++) 
-			{
-				trainingData->outputData[l][k] = folds[training_index[i]]->outputData[j][k];
-			}
+		fprintf(fp, " )^3");
 
-			l++;
-		}
 	}
 
-	return trainingData;
-}
+	/* exp */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "exp", FUNCTIONNAMELENGTH) == 0 ) {
 
-/* Build validation data set */
+		fprintf(fp, " e^{");
 
-DLL_EXPORT struct dataSet * getValidationData(struct dataSet ** folds, int * validation_index)
-{
-	int i, j, k, l;
-	struct dataSet * validationData = (struct dataSet*)malloc(sizeof(struct dataSet));
+		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
+
+		fprintf(fp, " }");
 
-	validationData->numInputs = folds[0]->numInputs;
-	validationData->numOutputs = folds[0]->numOutputs;
-	validationData->numSamples = 0;
-	
-	for(i = 0; i < 2; i++) // calculate the number of instances
-	{
-		validationData->numSamples = validationData->numSamples + folds[validation_index[i]]->numSamples;
 	}
 
-	// allocate memory for the data
-	validationData->inputData = (double**)malloc(validationData->numSamples * sizeof(double*));
-	validationData->outputData = (double**)malloc(validationData->numSamples * sizeof(double*));
+	/* sin */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "sin", FUNCTIONNAMELENGTH) == 0 ) {
 
-	for (i = 0; i < validationData->numSamples; i++) 
-	{
-		validationData->inputData[i] = (double*)malloc(validationData->numInputs * sizeof(double));
-		validationData->outputData[i] = (double*)malloc(validationData->numOutputs * sizeof(double));
-	}
+		fprintf(fp, "\\sin(");
 
-	l = 0;
-	for (i = 0; i < 2; i++) // for each fold
-	{
-		for(j = 0; j < folds[validation_index[i]]->numSamples; j++) // for each instance of each fold
-		{	
-			for (k = 0; k < validationData->numInputs; k++) 
-			{
-				validationData->inputData[l][k] = folds[validation_index[i]]->inputData[j][k];
-			}
+		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-			for (k = 0; k < validationData->numOutputs; k++) 
-			{
-				validationData->outputData[l][k] = folds[validation_index[i]]->outputData[j][k];
-			}
+		fprintf(fp, " )");
 
-			l++;
-		}
 	}
 
-	return validationData;
-}
-
-/* Build testing data set */
+	/* cos */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "cos", FUNCTIONNAMELENGTH) == 0 ) {
 
-DLL_EXPORT struct dataSet * getTestingData(struct dataSet ** folds, int testing_index)
-{
-	int i, j;
-	struct dataSet * testingData = (struct dataSet*)malloc(sizeof(struct dataSet));
+		fprintf(fp, " \\cos(");
 
-	testingData->numInputs = folds[0]->numInputs;
-	testingData->numOutputs = folds[0]->numOutputs;
-	testingData->numSamples = folds[testing_index]->numSamples;
+		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-	// allocate memory for the data
-	testingData->inputData = (double**)malloc(testingData->numSamples * sizeof(double*));
-	testingData->outputData = (double**)malloc(testingData->numSamples * sizeof(double*));
+		fprintf(fp, " )");
 
-	for (i = 0; i < testingData->numSamples; i++) 
-	{
-		testingData->inputData[i] = (double*)malloc(testingData->numInputs * sizeof(double));
-		testingData->outputData[i] = (double*)malloc(testingData->numOutputs * sizeof(double));
 	}
 
-	for(i = 0; i < folds[testing_index]->numSamples; i++) // for each instance of the fold
-	{	
-		for (j = 0; j < testingData->numInputs; j++) 
-		{
-			testingData->inputData[i][j] = folds[testing_index]->inputData[i][j];
-		}
-
-		for (j = 0; j < testingData->numOutputs; j++) 
-		{
-			testingData->outputData[i][j] = folds[testing_index]->outputData[i][j];
-		}
-	}
+	/* tan */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "tan", FUNCTIONNAMELENGTH) == 0 ) {
 
-	return testingData;
-}
+		fprintf(fp, " \\tan(");
 
-/*
-	frees given dataSet
-*/
-DLL_EXPORT void freeDataSet(struct dataSet *data) {
+		saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[0], fp);
 
-	int i;
+		fprintf(fp, " )");
 
-	/* attempt to prevent user double freeing */
-	if (data == NULL) {
-		printf("Warning: double freeing of dataSet prevented.\n");
-		return;
 	}
 
-	for (i = 0; i < data->numSamples; i++) {
-		free(data->inputData[i]);
-		free(data->outputData[i]);
+	/* rand */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "rand", FUNCTIONNAMELENGTH) == 0 ) {
+
+		fprintf(fp, " rand()");
 	}
 
-	free(data->inputData);
-	free(data->outputData);
-	free(data);
-}
+	/* pi */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "pi", FUNCTIONNAMELENGTH) == 0 ) {
 
+		fprintf(fp, "\\pi");
+	}
 
-/*
-	prints the given data structure to the screen
-*/
-DLL_EXPORT void printDataSet(struct dataSet *data) {
+	/* 0 */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "0", FUNCTIONNAMELENGTH) == 0 ) {
 
-	int i, j;
+		fprintf(fp, " 0");
+	}
 
-	printf("DATA SET\n");
-	printf("Inputs: %d, ", data->numInputs);
-	printf("Outputs: %d, ", data->numOutputs);
-	printf("Samples: %d\n", data->numSamples);
+	/* 1 */
+	else if (strncmp(chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function], "1", FUNCTIONNAMELENGTH) == 0 ) {
 
-	for (i = 0; i < data->numSamples; i++) {
+		fprintf(fp, " 1");
+	}
 
-		for (j = 0; j < data->numInputs; j++) {
-			printf("%f ", data->inputData[i][j]);
-		}
+	/* other */
+	else {
 
-		printf(" : ");
+		fprintf(fp, "%s(", chromo->funcSet->functionNames[chromo->nodes[index - chromo->numInputs]->function]);
 
-		for (j = 0; j < data->numOutputs; j++) {
-			printf("%f ", data->outputData[i][j]);
+		for (i = 0; i < getChromosomeNodeArity(chromo, index - chromo->numInputs); i++) {
+
+			saveChromosomeLatexRecursive(chromo, chromo->nodes[index - chromo->numInputs]->inputs[i], fp);
+
+			if (i < getChromosomeNodeArity(chromo, index - chromo->numInputs) - 1)
+				fprintf(fp, ", ");
 		}
 
-		printf("\n");
+		fprintf(fp, ")");
 	}
+
 }
 
 
 /*
-	saves dataset to file
+	save the given chromosome as a standalone C source file
 */
-DLL_EXPORT void saveDataSet(struct dataSet *data, char const *fileName) {
+DLL_EXPORT void saveChromosomeC(struct chromosome *chromo, char const *functionName, char const *fileName) {
 
-	int i, j;
+	int i;
 	FILE *fp;
 
+	/* the plan holds only the active nodes, so inactive nodes are never written */
+	setChromosomeActiveNodes(chromo);
+
+	if (chromo->planRecurrent == 1) {
+		printf("Warning: saveChromosomeC is only compatible with feed-forward networks. The chromosome has not been saved.\n");
+		return;
+	}
+
 	fp = fopen(fileName, "w");
 
 	if (fp == NULL) {
-		printf("Warning: cannot save data set to %s. Data set was not saved.\n", fileName);
 		return;
 	}
 
-	fprintf(fp, "%d,", data->numInputs);
-	fprintf(fp, "%d,", data->numOutputs);
-	fprintf(fp, "%d", data->numSamples);
-	fprintf(fp, "\n");
+	/* file header */
+	fprintf(fp, "/*\n");
+	fprintf(fp, "\t%s: %d inputs, %d outputs and %d active nodes.\n", functionName, chromo->numInputs, chromo->numOutputs, chromo->numActiveNodes);
+	fprintf(fp, "\tGenerated by CGP-Library. Compiled as C99 without floating point\n");
+	fprintf(fp, "\tcontraction (e.g. -ffp-contract=off) it gives the same outputs as executeChromosome.\n");
+	fprintf(fp, "*/\n\n");
+	fprintf(fp, "#include <math.h>\n");
+	fprintf(fp, "#include <float.h>\n");
+
+	if (chromo->planActivation != ACTIVATIONNONE && chromo->planActivation != ACTIVATIONSOFTSIGN) {
+		fprintf(fp, "#include <stdint.h>\n");
+		fprintf(fp, "#include <string.h>\n");
+	}
+
+	/* the treatment of NAN and inf node outputs used by executeChromosome */
+	fprintf(fp, "\nstatic double %s_clamp(double x) {\n", functionName);
+	fprintf(fp, "\tif (isnan(x)) {\n\t\treturn 0;\n\t}\n");
+	fprintf(fp, "\tif (isinf(x)) {\n\t\treturn x > 0 ? DBL_MAX : DBL_MIN;\n\t}\n");
+	fprintf(fp, "\treturn x;\n}\n");
+
+	/* the exp approximation of the fast evaluator */
+	if (chromo->planActivation != ACTIVATIONNONE && chromo->planActivation != ACTIVATIONSOFTSIGN) {
+		fprintf(fp, "\nstatic double %s_fastExp(double x) {\n", functionName);
+		fprintf(fp, "\tconst double shifter = 6755399441055744.0;\n");
+		fprintf(fp, "\tdouble t, n, r, p, scale;\n");
+		fprintf(fp, "\tint64_t bits;\n");
+		fprintf(fp, "\tx = isless(x, 708) ? x : 708;\n");
+		fprintf(fp, "\tx = isgreater(x, -708) ? x : -708;\n");
+		fprintf(fp, "\tt = (x * 1.4426950408889634) + shifter;\n");
+		fprintf(fp, "\tn = t - shifter;\n");
+		fprintf(fp, "\tr = (x - (n * 0.693145751953125)) - (n * 1.4286068203094172e-6);\n");
+		fprintf(fp, "\tp = 1 + r * (1 + r * (1.0 / 2 + r * (1.0 / 6 + r * (1.0 / 24 + r * (1.0 / 120 + r * (1.0 / 720 + r * (1.0 / 5040)))))));\n");
+		fprintf(fp, "\tmemcpy(&bits, &t, sizeof(double));\n");
+		fprintf(fp, "\tbits = (bits - 0x4338000000000000LL + 1023) << 52;\n");
+		fprintf(fp, "\tmemcpy(&scale, &bits, sizeof(double));\n");
+		fprintf(fp, "\treturn p * scale;\n}\n");
+	}
+
+	/* the network, unrolled one active node per statement */
+	fprintf(fp, "\nvoid %s(const double *inputs, double *outputs) {\n", functionName);
+	fprintf(fp, "\tdouble s;\n");
 
+	for (i = 0; i < chromo->numActiveNodes; i++) {
 
-	for (i = 0; i < data->numSamples; i++) {
+		if (saveChromosomeCNode(chromo, i, functionName, fp) == 0) {
 
-		for (j = 0; j < data->numInputs; j++) {
-			fprintf(fp, "%f,", data->inputData[i][j]);
-		}
+			printf("Warning: node function '%s' cannot be saved by saveChromosomeC. The chromosome has not been saved.\n", chromo->funcSet->functionNames[chromo->planFunctions[i]]);
 
-		for (j = 0; j < data->numOutputs; j++) {
-			if(j != data->numOutputs - 1)
-				fprintf(fp, "%f,", data->outputData[i][j]);
-			else
-				fprintf(fp, "%f", data->outputData[i][j]);
+			fclose(fp);
+			remove(fileName);
+			return;
 		}
+	}
 
-		fprintf(fp, "\n");
+	for (i = 0; i < chromo->numOutputs; i++) {
+		fprintf(fp, "\toutputs[%d] = ", i);
+		saveChromosomeCInputs(chromo, &chromo->outputNodes[i], 1, "%s", "", fp);
+		fprintf(fp, ";\n");
 	}
 
-	fclose(fp);
-}
+	fprintf(fp, "\t(void)s;\n}\n");
 
+	/* batch runtime over consecutive samples */
+	fprintf(fp, "\nvoid %s_batch(const double *inputs, int numSamples, double *outputs) {\n", functionName);
+	fprintf(fp, "\tint i;\n");
+	fprintf(fp, "\tfor (i = 0; i < numSamples; i++) {\n");
+	fprintf(fp, "\t\t%s(inputs + (i * %d), outputs + (i * %d));\n", functionName, chromo->numInputs, chromo->numOutputs);
+	fprintf(fp, "\t}\n}\n");
 
-/*
-	returns the number of inputs for each sample in the given dataSet
-*/
-DLL_EXPORT int getNumDataSetInputs(struct dataSet *data) {
-	return data->numInputs;
+	fclose(fp);
 }
 
-
 /*
-	returns the number of outputs for each sample in the given dataSet
+	used by saveChromosomeC. Writes the statement computing the given step
+	of the plan, returning 0 if its node function cannot be written.
 */
-DLL_EXPORT int getNumDataSetOutputs(struct dataSet *data) {
-	return data->numOutputs;
-}
+static int saveChromosomeCNode(struct chromosome *chromo, int step, char const *functionName, FILE *fp) {
 
+	double (*function)(const int numInputs, const double *inputs, const double *connectionWeights);
 
-/*
-	returns the number of samples in the given dataSet
-*/
-DLL_EXPORT int getNumDataSetSamples(struct dataSet *data) {
-	return data->numSamples;
-}
+	const int slot = chromo->planSlots[step];
+	const int nodeArity = chromo->planArity[step];
+	const int *nodeInputs = chromo->planInputs + (step * chromo->arity);
+	const double *nodeWeights = chromo->planWeights + (step * chromo->arity);
+	const char *fastFormulas[] = {"", "1 / (1 + %s_fastExp(-s))", "1 - 2 / (%s_fastExp(2 * s) + 1)", "s / (1 + fabs(s))", "%s_fastExp(-(s * s) / 2)"};
 
+	int i;
 
-/*
-	returns the inputs of the given sample of the given dataSet
-*/
-DLL_EXPORT double *getDataSetSampleInputs(struct dataSet *data, int sample) {
-	return data->inputData[sample];
-}
+	function = chromo->funcSet->functions[chromo->planFunctions[step]];
 
+	/* the sum of weighted inputs, in the order used by sumWeigtedInputs */
+	if (chromo->planActivation != ACTIVATIONNONE || function == _sigmoid || function == _gaussian || function == _step || function == _softsign || function == _hyperbolicTangent) {
 
-/*
-	returns the given input of the given sample of the given dataSet
-*/
-DLL_EXPORT double getDataSetSampleInput(struct dataSet *data, int sample, int input) {
-	return data->inputData[sample][input];
-}
+		fprintf(fp, "\ts = 0");
 
+		for (i = 0; i < nodeArity; i++) {
+			fprintf(fp, " + ");
+			saveChromosomeCInputs(chromo, &nodeInputs[i], 1, "%s", "", fp);
+			fprintf(fp, " * %.17g", nodeWeights[i]);
+		}
 
-/*
-	returns the outputs of the given sample of the given dataSet
-*/
-DLL_EXPORT double *getDataSetSampleOutputs(struct dataSet *data, int sample) {
-	return data->outputData[sample];
-}
+		fprintf(fp, ";\n");
+	}
 
+	/* as getFastActivation, only NANs are dealt with */
+	if (chromo->planActivation != ACTIVATIONNONE) {
+		fprintf(fp, "\tconst double n%d = isnan(s) ? 0 : %s_clamp(", slot, functionName);
+		fprintf(fp, fastFormulas[chromo->planActivation], functionName);
+		fprintf(fp, ");\n");
+		return 1;
+	}
 
-/*
-	returns the given output of the given sample of the given dataSet
-*/
-DLL_EXPORT double getDataSetSampleOutput(struct dataSet *data, int sample, int output) {
-	return data->outputData[sample][output];
-}
+	fprintf(fp, "\tconst double n%d = %s_clamp(", slot, functionName);
 
+	if (function == _add) {
+		saveChromosomeCInputs(chromo, nodeInputs, nodeArity, "%s", " + ", fp);
+	}
+	else if (function == _sub) {
+		saveChromosomeCInputs(chromo, nodeInputs, nodeArity, "%s", " - ", fp);
+	}
+	else if (function == _mul) {
+		saveChromosomeCInputs(chromo, nodeInputs, nodeArity, "%s", " * ", fp);
+	}
+	else if (function == _divide) {
+		saveChromosomeCInputs(chromo, nodeInputs, nodeArity, "%s", " / ", fp);
+	}
+	else if (function == _absolute) {
+		saveChromosomeCInputs(chromo, nodeInputs, 1, "fabs(%s)", "", fp);
+	}
+	else if (function == _squareRoot) {
+		saveChromosomeCInputs(chromo, nodeInputs, 1, "sqrt(%s)", "", fp);
+	}
+	else if (function == _square) {
+		saveChromosomeCInputs(chromo, nodeInputs, 1, "pow(%s, 2)", "", fp);
+	}
+	else if (function == _cube) {
+		saveChromosomeCInputs(chromo, nodeInputs, 1, "pow(%s, 3)", "", fp);
+	}
+	else if (function == _power && nodeArity > 1) {
+		fprintf(fp, "pow(");
+		saveChromosomeCInputs(chromo, nodeInputs, 2, "%s", ", ", fp);
+		fprintf(fp, ")");
+	}
+	else if (function == _exponential) {
+		saveChromosomeCInputs(chromo, nodeInputs, 1, "exp(%s)", "", fp);
+	}
+	else if (function == _sine) {
+		saveChromosomeCInputs(chromo, nodeInputs, 1, "sin(%s)", "", fp);
+	}
+	else if (function == _cosine) {
+		saveChromosomeCInputs(chromo, nodeInputs, 1, "cos(%s)", "", fp);
+	}
+	else if (function == _tangent) {
+		saveChromosomeCInputs(chromo, nodeInputs, 1, "tan(%s)", "", fp);
+	}
+	else if (function == _constOne) {
+		fprintf(fp, "1");
+	}
+	else if (function == _constZero) {
+		fprintf(fp, "0");
+	}
+	else if (function == _constPI) {
+		fprintf(fp, "%.17g", M_PI);
+	}
+	else if (function == _and || function == _nand) {
+		fprintf(fp, "(");
+		saveChromosomeCInputs(chromo, nodeInputs, nodeArity, "%s == 0", " || ", fp);
+		fprintf(fp, function == _and ? ") ? 0 : 1" : ") ? 1 : 0");
+	}
+	else if (function == _or || function == _nor) {
+		fprintf(fp, "(");
+		saveChromosomeCInputs(chromo, nodeInputs, nodeArity, "%s == 1", " || ", fp);
+		fprintf(fp, function == _or ? ") ? 1 : 0" : ") ? 0 : 1");
+	}
+	else if (function == _xor || function == _xnor) {
+		fprintf(fp, "(");
+		saveChromosomeCInputs(chromo, nodeInputs, nodeArity, "(%s == 1)", " + ", fp);
+		fprintf(fp, function == _xor ? " == 1) ? 1 : 0" : " == 1) ? 0 : 1");
+	}
+	else if (function == _not) {
+		saveChromosomeCInputs(chromo, nodeInputs, 1, "%s == 0 ? 1 : 0", "", fp);
+	}
+	else if (function == _wire) {
+		saveChromosomeCInputs(chromo, nodeInputs, 1, "%s", "", fp);
+	}
+	else if (function == _sigmoid) {
+		fprintf(fp, "1 / (1 + exp(-s))");
+	}
+	else if (function == _gaussian) {
+		fprintf(fp, "exp(-(pow(s, 2)) / 2)");
+	}
+	else if (function == _step) {
+		fprintf(fp, "s < 0 ? 0 : 1");
+	}
+	else if (function == _softsign) {
+		fprintf(fp, "s / (1 + fabs(s))");
+	}
+	else if (function == _hyperbolicTangent) {
+		fprintf(fp, "tanh(s)");
+	}
 
+	/* custom node functions and rand have no standalone form */
+	else {
+		return 0;
+	}
 
-/*
-	Results Functions
-*/
+	fprintf(fp, ");\n");
 
+	return 1;
+}
 
 /*
-	initialises a results structure
+	used by saveChromosomeC. Writes the values of the given slots, each
+	using format and separated by separator. Chromosome inputs are read
+	from inputs and node outputs from the node constants n<slot>.
 */
-struct results* initialiseResults(struct parameters *params, int numRuns) {
+static void saveChromosomeCInputs(struct chromosome *chromo, const int *slots, int numSlots, char const *format, char const *separator, FILE *fp) {
 
-	struct results *rels;
+	int i;
+	char value[32];
 
-	rels = (struct results*)malloc(sizeof(struct results));
-	rels->bestChromosomes = (struct chromosome**)malloc(numRuns * sizeof(struct chromosome*));
+	for (i = 0; i < numSlots; i++) {
 
-	rels->numRuns = numRuns;
+		if (slots[i] < chromo->numInputs) {
+			snprintf(value, sizeof(value), "inputs[%d]", slots[i]);
+		}
+		else {
+			snprintf(value, sizeof(value), "n%d", slots[i]);
+		}
 
-	/*
-		Initialised chromosomes are returns from runCGP and stored in a results structure.
-		Therefore they should not be initialised here.
-	*/
+		if (i > 0) {
+			fprintf(fp, "%s", separator);
+		}
 
-	return rels;
+		fprintf(fp, format, value);
+	}
 }
 
+DLL_EXPORT int compareChromosomes(struct chromosome *chromoA, struct chromosome *chromoB) {
 
-/*
-	free an initialised results structure
-*/
-DLL_EXPORT void freeResults(struct results *rels) {
+	int i, j;
 
-	int i;
+	/* ensure that the chromosomes don't point to NULL */
+	if (chromoA == NULL || chromoB == NULL) {
+		return 0;
+	}
 
-	/* attempt to prevent user double freeing */
-	if (rels == NULL) {
-		printf("Warning: double freeing of results prevented.\n");
-		return;
+	/* Check the high level parameters */
+	if (chromoA->numInputs != chromoB->numInputs) {
+		return 0;
 	}
 
-	for (i = 0; i < rels->numRuns; i++) {
-		freeChromosome(rels->bestChromosomes[i]);
+	if (chromoA->numNodes != chromoB->numNodes) {
+		return 0;
 	}
 
-	free(rels->bestChromosomes);
-	free(rels);
-}
+	if (chromoA->numOutputs != chromoB->numOutputs) {
+		return 0;
+	}
 
+	if (chromoA->arity != chromoB->arity) {
+		return 0;
+	}
 
-/*
-	saves results structure to file
-*/
-DLL_EXPORT void saveResults(struct results *rels, char const *fileName, unsigned int * seed) {
+	/* for each node*/
+	for (i = 0; i < chromoA->numNodes; i++) {
 
-	FILE *fp;
-	int i;
+		/* Check the function genes */
+		if (chromoA->nodes[i]->function != chromoB->nodes[i]->function) {
+			return 0;
+		}
 
-	struct chromosome *chromoTemp;
+		/* for each node input */
+		for (j = 0; j < chromoA->arity; j++) {
 
-	if (rels == NULL) {
-		printf("Warning: cannot save uninitialised results structure. Results not saved.\n");
-		return;
+			/* Check the node inputs */
+			if (chromoA->nodes[i]->inputs[j] != chromoB->nodes[i]->inputs[j]) {
+				return 0;
+			}
+		}
 	}
 
-	fp = fopen(fileName, "w");
+	/* for all of the outputs */
+	for (i = 0; i < chromoA->numOutputs; i++) {
 
-	if (fp == NULL) {
-		printf("Warning: cannot open '%s' and so cannot save results to that file. Results not saved.\n", fileName);
-		return;
+		/* Check the outputs */
+		if (chromoA->outputNodes[i] != chromoB->outputNodes[i] ) {
+			return 0;
+		}
 	}
 
-	fprintf(fp, "Run,Fitness,Generations,Active Nodes\n");
+	return 1;
+}
 
-	for (i = 0; i < rels->numRuns; i++) {
 
-		chromoTemp = getChromosome(rels, i, seed);
+DLL_EXPORT int compareChromosomesANN(struct chromosome *chromoA, struct chromosome *chromoB) {
 
-		fprintf(fp, "%d,%f,%d,%d\n", i, chromoTemp->fitness, chromoTemp->generation, chromoTemp->numActiveNodes);
+	int i, j;
 
-		freeChromosome(chromoTemp);
+	/* ensure that the chromosomes don't point to NULL */
+	if (chromoA == NULL || chromoB == NULL) {
+		return 0;
 	}
 
-	fclose(fp);
-}
+	/* Check the high level parameters */
+	if (chromoA->numInputs != chromoB->numInputs) {
+		return 0;
+	}
 
+	if (chromoA->numNodes != chromoB->numNodes) {
+		return 0;
+	}
 
-/*
-	Gets the number of chromosomes in the results structure
-*/
-DLL_EXPORT int getNumChromosomes(struct results *rels) {
-	return rels->numRuns;
-}
+	if (chromoA->numOutputs != chromoB->numOutputs) {
+		return 0;
+	}
 
+	if (chromoA->arity != chromoB->arity) {
+		return 0;
+	}
 
-/*
-	returns the average number of chromosome active nodes from repeated
-	run results specified in rels.
-*/
-DLL_EXPORT double getAverageActiveNodes(struct results *rels) {
+	/* for each node*/
+	for (i = 0; i < chromoA->numNodes; i++) {
 
-	int i;
-	double avgActiveNodes = 0;
-	struct chromosome *chromoTemp;
+		/* Check the function genes */
+		if (chromoA->nodes[i]->function != chromoB->nodes[i]->function) {
+			return 0;
+		}
 
-	for (i = 0; i < getNumChromosomes(rels); i++) {
+		/* for each node input */
+		for (j = 0; j < chromoA->arity; j++) {
 
-		chromoTemp = rels->bestChromosomes[i];
+			/* Check the node inputs */
+			if (chromoA->nodes[i]->inputs[j] != chromoB->nodes[i]->inputs[j]) {
+				return 0;
+			}
 
-		avgActiveNodes += getNumChromosomeActiveNodes(chromoTemp);
+			/* Check the connection weights inputs */
+			if (chromoA->nodes[i]->weights[j] != chromoB->nodes[i]->weights[j]) {
+				return 0;
+			}
+		}
 	}
 
-	avgActiveNodes = avgActiveNodes / getNumChromosomes(rels);
-
-	return avgActiveNodes;
-}
-
-
-/*
-	returns the median number of chromosome active nodes from repeated
-	run results specified in rels.
-*/
-DLL_EXPORT double getMedianActiveNodes(struct results *rels) {
-
-	int i;
-	double medActiveNodes = 0;
-
-	int *array = (int*)malloc(getNumChromosomes(rels) * sizeof(int));
+	/* for all of the outputs */
+	for (i = 0; i < chromoA->numOutputs; i++) {
 
-	for (i = 0; i < getNumChromosomes(rels); i++) {
-		array[i] = getNumChromosomeActiveNodes(rels->bestChromosomes[i]);
+		/* Check the outputs */
+		if (chromoA->outputNodes[i] != chromoB->outputNodes[i] ) {
+			return 0;
+		}
 	}
 
-	medActiveNodes = medianInt(array, getNumChromosomes(rels));
-
-	free(array);
-
-	return medActiveNodes;
+	return 1;
 }
 
 
-static double medianInt(const int *anArray, const int length) {
+DLL_EXPORT int compareChromosomesActiveNodes(struct chromosome *chromoA, struct chromosome *chromoB) {
 
-	int i;
-	int *copyArray = (int*)malloc(length * sizeof(int));
-	double median;
+	int i, j;
 
-	/* make a copy of the array */
-	for (i = 0; i < length; i++) {
-		copyArray[i] = anArray[i];
+	/* ensure that the chromosomes don't point to NULL */
+	if (chromoA == NULL || chromoB == NULL) {
+		return 0;
 	}
 
-	/* sort the copy array */
-	sortIntArray(copyArray, length);
+	/* Check the high level parameters */
+	if (chromoA->numInputs != chromoB->numInputs) {
+		return 0;
+	}
 
-	/* if even */
-	if (length % 2 == 0) {
-		median = (copyArray[(length / 2)] + copyArray[(length / 2) - 1] ) / 2;
+	if (chromoA->numNodes != chromoB->numNodes) {
+		return 0;
 	}
 
-	/* if odd */
-	else {
-		median = copyArray[ (length - 1) / 2];
+	if (chromoA->numOutputs != chromoB->numOutputs) {
+		return 0;
 	}
 
-	free(copyArray);
+	if (chromoA->arity != chromoB->arity) {
+		return 0;
+	}
 
-	return median;
-}
+	/* for each node*/
+	for (i = 0; i < chromoA->numNodes; i++) {
 
-static double medianDouble(const double *anArray, const int length) {
+		/* if the node is active in both chromosomes */
+		if (chromoA->nodes[i]->active == 1 && chromoB->nodes[i]->active == 1) {
 
-	int i;
-	double *copyArray = (double*)malloc(length * sizeof(double));
-	double median;
+			/* Check the function genes */
+			if (chromoA->nodes[i]->function != chromoB->nodes[i]->function) {
+				return 0;
+			}
 
-	/* make a copy of the array */
-	for (i = 0; i < length; i++) {
-		copyArray[i] = anArray[i];
-	}
+			/* for each node input */
+			for (j = 0; j < chromoA->arity; j++) {
 
-	/* sort the copy array */
-	sortDoubleArray(copyArray, length);
+				/* Check the node inputs */
+				if (chromoA->nodes[i]->inputs[j] != chromoB->nodes[i]->inputs[j]) {
+					return 0;
+				}
+			}
+		}
+		/* if the node is active in one chromosome */
+		else if (chromoA->nodes[i]->active != chromoB->nodes[i]->active ) {
+			return 0;
+		}
 
-	/* if even */
-	if (length % 2 == 0) {
-		median = (copyArray[(length / 2)] + copyArray[(length / 2) - 1] ) / 2;
+		/* The node is inactive in both chromosomes */
+		else {
+			/* do nothing */
+		}
 	}
 
-	/* if odd */
-	else {
-		median = copyArray[ (length - 1) / 2];
-	}
+	/* for all of the outputs */
+	for (i = 0; i < chromoA->numOutputs; i++) {
 
-	free(copyArray);
+		/* Check the outputs */
+		if (chromoA->outputNodes[i] != chromoB->outputNodes[i] ) {
+			return 0;
+		}
+	}
 
-	return median;
+	return 1;
 }
 
 
+DLL_EXPORT int compareChromosomesActiveNodesANN(struct chromosome *chromoA, struct chromosome *chromoB) {
 
-/*
-	returns the average chromosome fitness from repeated
-	run results specified in rels.
-*/
-DLL_EXPORT double getAverageFitness(struct results *rels) {
+	int i, j;
 
-	int i;
-	double avgFit = 0;
-	struct chromosome *chromoTemp;
+	/* ensure that the chromosomes don't point to NULL */
+	if (chromoA == NULL || chromoB == NULL) {
+		return 0;
+	}
 
+	/* Check the high level parameters */
+	if (chromoA->numInputs != chromoB->numInputs) {
+		return 0;
+	}
 
-	for (i = 0; i < getNumChromosomes(rels); i++) {
+	if (chromoA->numNodes != chromoB->numNodes) {
+		return 0;
+	}
 
-		chromoTemp = rels->bestChromosomes[i];
+	if (chromoA->numOutputs != chromoB->numOutputs) {
+		return 0;
+	}
 
-		avgFit += getChromosomeFitness(chromoTemp);
+	if (chromoA->arity != chromoB->arity) {
+		return 0;
 	}
 
-	avgFit = avgFit / getNumChromosomes(rels);
+	/* for each node*/
+	for (i = 0; i < chromoA->numNodes; i++) {
 
-	return avgFit;
-}
+		/* if the node is active in both chromosomes */
+		if (chromoA->nodes[i]->active == 1 && chromoB->nodes[i]->active == 1) {
 
+			/* Check the function genes */
+			if (chromoA->nodes[i]->function != chromoB->nodes[i]->function) {
+				return 0;
+			}
 
-/*
-	returns the median chromosome fitness from repeated
-	run results specified in rels.
-*/
-DLL_EXPORT double getMedianFitness(struct results *rels) {
+			/* for each node input */
+			for (j = 0; j < chromoA->arity; j++) {
 
-	int i;
-	double med = 0;
+				/* Check the node inputs */
+				if (chromoA->nodes[i]->inputs[j] != chromoB->nodes[i]->inputs[j]) {
+					return 0;
+				}
 
-	double *array = (double*)malloc(getNumChromosomes(rels) * sizeof(double));
+				/* Check the connection weights inputs */
+				if (chromoA->nodes[i]->weights[j] != chromoB->nodes[i]->weights[j]) {
+					return 0;
+				}
+			}
+		}
+		/* if the node is active in one chromosome */
+		else if (chromoA->nodes[i]->active != chromoB->nodes[i]->active ) {
+			return 0;
+		}
 
-	for (i = 0; i < getNumChromosomes(rels); i++) {
-		array[i] = getChromosomeFitness(rels->bestChromosomes[i]);
+		/* The node is inactive in both chromosomes */
+		else {
+			/* do nothing */
+		}
 	}
 
-	med = medianDouble(array, getNumChromosomes(rels));
+	/* for all of the outputs */
+	for (i = 0; i < chromoA->numOutputs; i++) {
 
-	free(array);
+		/* Check the outputs */
+		if (chromoA->outputNodes[i] != chromoB->outputNodes[i] ) {
+			return 0;
+		}
+	}
 
-	return med;
+	return 1;
 }
 
 
-
 /*
-	returns the average number of generations used by each run  specified in rels.
+	Mutates the given chromosome using the mutation method described in parameters
 */
-DLL_EXPORT double getAverageGenerations(struct results *rels) {
+DLL_EXPORT void mutateChromosome(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed) {
 
-	int i;
-	double avgGens = 0;
-	struct chromosome *chromoTemp;
+	double start = (params->profile != NULL) ? getProfileClock() : 0;
 
-	for (i = 0; i < getNumChromosomes(rels); i++) {
+	params->mutationType(params, chromo, type, seed);
 
-		chromoTemp = rels->bestChromosomes[i];
+	chromo->activeNodesDirty = 1;
+	setChromosomeActiveNodes(chromo);
 
-		avgGens += getChromosomeGenerations(chromoTemp);
+	if (params->profile != NULL) {
+		addProfileCount(&params->profile->mutations, 1);
+		addProfileTime(params->profile, PROFILEMUTATION, start);
 	}
-
-	avgGens = avgGens / getNumChromosomes(rels);
-
-	return avgGens;
 }
 
 
 /*
-	returns the median number of generations used by each run  specified in rels.
+	removes the inactive nodes from the given chromosome
 */
-DLL_EXPORT double getMedianGenerations(struct results *rels) {
+DLL_EXPORT void removeInactiveNodes(struct chromosome *chromo) {
 
-	int i;
-	double med = 0;
+	int i, j, k;
 
-	int *array = (int*)malloc(getNumChromosomes(rels) * sizeof(int));
+	/* the node numbering changes and so the cached node values are dropped */
+	freeNodeCache(chromo);
 
-	for (i = 0; i < getNumChromosomes(rels); i++) {
-		array[i] = getChromosomeGenerations(rels->bestChromosomes[i]);
-	}
+	/* set the active nodes */
+	setChromosomeActiveNodes(chromo);
 
-	med = medianInt(array, getNumChromosomes(rels));
+	/* for all nodes */
+	for (i = 0; i < chromo->numNodes - 1; i++) {
 
-	free(array);
+		/* if the node is inactive */
+		if (chromo->nodes[i]->active == 0) {
 
-	return med;
-}
+			/* set the node to be the next node */
+			for (j = i; j < chromo->numNodes - 1; j++) {
+				copyNode(chromo->nodes[j], chromo->nodes[j + 1]);
+			}
 
+			/* */
+			for (j = 0; j < chromo->numNodes; j++) {
+				for (k = 0; k < chromo->arity; k++) {
 
+					if (chromo->nodes[j]->inputs[k] >= i + chromo->numInputs) {
+						chromo->nodes[j]->inputs[k]--;
+					}
+				}
+			}
 
-/*
-	returns a pointer to a copy of the best chromosomes found on the given run in rels.
-*/
-DLL_EXPORT struct chromosome* getChromosome(struct results *rels, int run, unsigned int * seed) {
+			/* for the number of chromosome outputs */
+			for (j = 0; j < chromo->numOutputs; j++) {
 
-	struct chromosome *chromo;
+				if (chromo->outputNodes[j] >= i + chromo->numInputs) {
+					chromo->outputNodes[j]--;
+				}
+			}
 
-	/* do some error checking */
-	if (rels == NULL) {
-		printf("Error: cannot get best chromosome from uninitialised results.\nTerminating CGP-Library.\n");
-		exit(0);
-	}
+			/* de-increment the number of nodes */
+			chromo->numNodes--;
 
-	chromo = initialiseChromosomeFromChromosome(rels->bestChromosomes[run], seed);
+			/* made the newly assigned node be evaluated */
+			i--;
+		}
+	}
 
-	return chromo;
-}
+	if (chromo->nodes[chromo->numNodes - 1]->active == 0) {
+		chromo->numNodes--;
+	}
 
+	/*
+		the removed nodes are part of the chromosome's single memory block
+		and so they are only left unused rather than freed
+	*/
 
-/*
-	Mutation Methods
-*/
+	/* set the active nodes of the renumbered nodes */
+	chromo->activeNodesDirty = 1;
+	setChromosomeActiveNodes(chromo);
+}
 
 
 /*
-	Conductions point mutation on the give chromosome. A predetermined
-	number of chromosome genes are randomly selected and changed to
-	a random valid allele. The number of mutations is the number of chromosome
-	genes multiplied by the mutation rate. Each gene has equal probability
-	of being selected.
-
-	DO NOT USE WITH ANN
+	sets the fitness of the given chromosome
 */
-static void pointMutation(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed) {
+DLL_EXPORT void setChromosomeFitness(struct parameters *params, struct chromosome *chromo, struct dataSet *data) {
 
-	int i;
-	int numGenes;
-	int numFunctionGenes, numInputGenes, numOutputGenes;
-	int numGenesToMutate;
-	int geneToMutate;
-	int nodeIndex;
-	int nodeInputIndex;
+	double fitness;
+	double start = (params->profile != NULL) ? getProfileClock() : 0;
 
-	/* get the number of each type of gene */
-	numFunctionGenes = params->numNodes;
-	numInputGenes = params->numNodes * params->arity;
-	numOutputGenes = params->numOutputs;
+	setChromosomeActiveNodes(chromo);
 
-	/* set the total number of chromosome genes */
-	numGenes = numFunctionGenes + numInputGenes + numOutputGenes;
+	resetChromosome(chromo);
 
-	/* calculate the number of genes to mutate */
-	numGenesToMutate = (int)roundf(numGenes * params->mutationRate);
+	fitness = params->fitnessFunction(params, chromo, data);
 
-	/* for the number of genes to mutate */
-	for (i = 0; i < numGenesToMutate; i++) {
+	chromo->fitness = fitness;
 
-		/* select a random gene */
-		geneToMutate = randInt(numGenes, seed);
+	if (params->profile != NULL) {
+		addProfileEvaluation(params->profile, chromo, start);
+	}
+}
 
-		/* mutate function gene */
-		if (geneToMutate < numFunctionGenes) {
+/*
+	sets the fitness of the given chromosome - ideally to evaluate the validation set 
+*/
+DLL_EXPORT void setChromosomeFitnessValidation(struct parameters *params, struct chromosome *chromo, struct dataSet *data) {
 
-			nodeIndex = geneToMutate;
+	double fitness;
+	double start = (params->profile != NULL) ? getProfileClock() : 0;
 
-			chromo->nodes[nodeIndex]->function = getRandomFunction(chromo->funcSet->numFunctions, seed);
-		}
+	setChromosomeActiveNodes(chromo);
 
-		/* mutate node input gene */
-		else if (geneToMutate < numFunctionGenes + numInputGenes) {
+	resetChromosome(chromo);
 
-			nodeIndex = (int) ((geneToMutate - numFunctionGenes) / chromo->arity);
-			nodeInputIndex = (geneToMutate - numFunctionGenes) % chromo->arity;
+	fitness = params->fitnessFunction(params, chromo, data);
 
-			chromo->nodes[nodeIndex]->inputs[nodeInputIndex] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, nodeIndex, params->recurrentConnectionProbability, seed);
-		}
+	chromo->fitnessValidation = fitness;
 
-		/* mutate output gene */
-		else {
-			nodeIndex = geneToMutate - numFunctionGenes - numInputGenes;
-			chromo->outputNodes[nodeIndex] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections, seed);
-		}
+	if (params->profile != NULL) {
+		addProfileEvaluation(params->profile, chromo, start);
 	}
 }
 
 
 /*
-	Same as pointMutation but also mutates weight genes. The reason this is separated is
-	that point mutation should always mutate the same number of genes. When weight genes are not
-	used many mutations will not do anything and so the number of actual mutations varies.
-
-	>>> However, in this case, only the mutation applied to the active nodes are counted!
+	sets the fitness of the given chromosome where only fitnesses not greater
+	than the cutoff need to be exact, see setCustomBoundedFitnessFunction
 */
-static void pointMutationANN(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed) 
-{
-	int numGenes;
-	int numFunctionGenes, numInputGenes, numWeightGenes, numOutputGenes;
-	int numGenesToMutate;
-	int geneToMutate;
-	int nodeIndex;
-	int nodeInputIndex;
-	int counter = 0;
-
-	/* get the number of each type of gene */
-	numFunctionGenes = params->numNodes;
-	numInputGenes = params->numNodes * params->arity;
-	numWeightGenes = params->numNodes * params->arity;
-	numOutputGenes = params->numOutputs;
-
-	/* set the total number of chromosome genes */
-	numGenes = numFunctionGenes + numInputGenes + numWeightGenes + numOutputGenes;
+static void setChromosomeFitnessBounded(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff) {
 
-	/* calculate the number of genes to mutate */
-	numGenesToMutate = (int)roundf(numGenes * params->mutationRate);
-
-	/* for the number of genes to mutate */
-	while(counter < numGenesToMutate)
-	{
-		/* select a random gene */
-		geneToMutate = randInt(numGenes, seed);
+	double start;
 
-		/* mutate function gene */
-		if (geneToMutate < numFunctionGenes) 
-		{
-			nodeIndex = geneToMutate;
+	if (params->boundedFitnessFunction == NULL || cutoff == DBL_MAX) {
+		setChromosomeFitness(params, chromo, data);
+		return;
+	}
 
-			if(chromo->nodes[nodeIndex]->active == 1)
-			{
-				counter++;
-			}
+	start = (params->profile != NULL) ? getProfileClock() : 0;
 
-			chromo->nodes[nodeIndex]->function = getRandomFunction(chromo->funcSet->numFunctions, seed);
-		}
+	setChromosomeActiveNodes(chromo);
 
-		/* mutate node input gene */
-		else if (geneToMutate < numFunctionGenes + numInputGenes) 
-		{
-			nodeIndex = (int) ((geneToMutate - numFunctionGenes) / chromo->arity);
-			nodeInputIndex = (geneToMutate - numFunctionGenes) % chromo->arity;
+	resetChromosome(chromo);
 
-			if(chromo->nodes[nodeIndex]->active == 1)
-			{
-				counter++;
-			}
+	chromo->fitness = params->boundedFitnessFunction(params, chromo, data, cutoff);
 
-			chromo->nodes[nodeIndex]->inputs[nodeInputIndex] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, nodeIndex, params->recurrentConnectionProbability, seed);
-		}
+	if (params->profile != NULL) {
+		addProfileEvaluation(params->profile, chromo, start);
+	}
+}
 
-		/* mutate connection weight */
-		else if (geneToMutate < numFunctionGenes + numInputGenes + numWeightGenes) 
-		{
-			nodeIndex = (int) ((geneToMutate - numFunctionGenes - numInputGenes) / chromo->arity);
-			nodeInputIndex = (geneToMutate - numFunctionGenes - numInputGenes) % chromo->arity;
 
-			if(chromo->nodes[nodeIndex]->active == 1)
-			{
-				counter++;
-			}
+/*
+	reset the output values of all chromosome nodes to zero
+*/
+DLL_EXPORT void resetChromosome(struct chromosome *chromo) {
 
-			chromo->nodes[nodeIndex]->weights[nodeInputIndex] = getRandomConnectionWeight(params->connectionWeightRange, seed);
-		}
+	int i;
 
-		/* mutate output gene */
-		else 
-		{
-			nodeIndex = geneToMutate - numFunctionGenes - numInputGenes - numWeightGenes;
-			counter++;
-			chromo->outputNodes[nodeIndex] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections, seed);
-		}
+	for (i = 0; i < chromo->numInputs + chromo->numNodes; i++) {
+		chromo->nodeValues[i] = 0;
 	}
 }
 
-
-
 /*
-	Conductions a single active mutation on the give chromosome.
-
-	DO NOT USE WITH ANN
+	copies the contents of one chromosome to another. Provided the number of inputs, nodes, outputs and node arity are the same.
 */
-static void singleMutation(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed) {
+DLL_EXPORT void copyChromosome(struct chromosome *chromoDest, struct chromosome *chromoSrc) {
 
-	int numFunctionGenes, numInputGenes, numOutputGenes;
-	int numGenes;
-	int geneToMutate;
-	int nodeIndex;
-	int nodeInputIndex;
+	int i;
+	double start = (chromoDest->profile != NULL) ? getProfileClock() : 0;
 
-	int mutatedActive = 0;
-	int previousGeneValue;
-	int newGeneValue;
+	/* error checking  */
+	if (chromoDest->numInputs != chromoSrc->numInputs) {
+		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The number of chromosome inputs do not match.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
 
-	/* get the number of each type of gene */
-	numFunctionGenes = params->numNodes;
-	numInputGenes = params->numNodes * params->arity;
-	numOutputGenes = params->numOutputs;
+	if (chromoDest->numNodes != chromoSrc->numNodes) {
+		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The number of chromosome nodes do not match.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
 
-	/* set the total number of chromosome genes */
-	numGenes = numFunctionGenes + numInputGenes + numOutputGenes;
+	if (chromoDest->numOutputs != chromoSrc->numOutputs) {
+		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The number of chromosome outputs do not match.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
 
-	/* while active gene not mutated */
-	while (mutatedActive == 0) {
+	if (chromoDest->arity != chromoSrc->arity) {
+		printf("Error: cannot copy a chromosome to a chromosome of different dimensions. The arity of the chromosome nodes do not match.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
 
-		/* select a random gene */
-		geneToMutate = randInt(numGenes, seed);
+	/* copy nodes and which are active */
+	for (i = 0; i < chromoSrc->numNodes; i++) {
+		copyNode(chromoDest->nodes[i],  chromoSrc->nodes[i]);
+		chromoDest->activeNodes[i] = chromoSrc->activeNodes[i];
+	}
 
-		/* mutate function gene */
-		if (geneToMutate < numFunctionGenes) {
+	/* share the functionset, which within a run is already the same */
+	if (chromoDest->funcSet != chromoSrc->funcSet) {
+		releaseFunctionSet(chromoDest->funcSet);
+		chromoDest->funcSet = retainFunctionSet(chromoSrc->funcSet);
+	}
 
-			nodeIndex = geneToMutate;
+	/* copy each of the chromosomes outputs */
+	for (i = 0; i < chromoSrc->numOutputs; i++) {
+		chromoDest->outputNodes[i] = chromoSrc->outputNodes[i];
+	}
 
-			previousGeneValue = chromo->nodes[nodeIndex]->function;
+	/* copy the number of active node */
+	chromoDest->numActiveNodes = chromoSrc->numActiveNodes;
+	chromoDest->activeNodesDirty = chromoSrc->activeNodesDirty;
 
-			chromo->nodes[nodeIndex]->function = getRandomFunction(chromo->funcSet->numFunctions, seed);
+	/* rebuild the execution plan from the copied nodes */
+	compileChromosome(chromoDest);
 
-			newGeneValue = chromo->nodes[nodeIndex]->function;
+	/* copy the cached node values which are still valid */
+	copyNodeCache(chromoDest, chromoSrc);
 
-			if ((previousGeneValue != newGeneValue) && (chromo->nodes[nodeIndex]->active == 1)) {
-				mutatedActive = 1;
+	/* the offloaded outputs were those of the old genes */
+	chromoDest->offloadDataSetId = 0;
+
+	if (chromoDest->profile != NULL) {
+		addProfileCount(&chromoDest->profile->copies, 1);
+		addProfileTime(chromoDest->profile, PROFILECOPY, start);
+	}
+
+	/* copy the fitness */
+	chromoDest->fitness = chromoSrc->fitness;
+	chromoDest->fitnessValidation = chromoSrc->fitnessValidation;
+
+	/* copy generation */
+	chromoDest->generation = chromoSrc->generation;
+}
+
+/*
+	Gets the number of chromosome inputs
+*/
+DLL_EXPORT int getNumChromosomeInputs(struct chromosome *chromo) {
+	return chromo->numInputs;
+}
+
+/*
+	Gets the number of chromosome nodes
+*/
+DLL_EXPORT int getNumChromosomeNodes(struct chromosome *chromo) {
+	return chromo->numNodes;
+}
+
+/*
+	Gets the number of chromosome active nodes
+*/
+DLL_EXPORT int getNumChromosomeActiveNodes(struct chromosome *chromo) {
+	return chromo->numActiveNodes;
+}
+
+/*
+	Gets the number of chromosome outputs
+*/
+DLL_EXPORT int getNumChromosomeOutputs(struct chromosome *chromo) {
+	return chromo->numOutputs;
+}
+
+/*
+	Gets the chromosome node arity
+*/
+DLL_EXPORT int getChromosomeNodeArity(struct chromosome *chromo, int index) {
+
+	int chromoArity = chromo->arity;
+	int maxArity = chromo->funcSet->maxNumInputs[chromo->nodes[index]->function];
+
+	if (maxArity == -1) {
+		return chromoArity;
+	}
+	else if (maxArity < chromoArity) {
+		return maxArity;
+	}
+	else {
+		return chromoArity;
+	}
+}
+
+/*
+	Gets the chromosome fitness
+*/
+DLL_EXPORT double getChromosomeFitness(struct chromosome *chromo) {
+	return chromo->fitness;
+}
+
+/*
+	Gets the number of active connections in the given chromosome
+*/
+DLL_EXPORT int getNumChromosomeActiveConnections(struct chromosome *chromo) {
+
+	int i;
+	int complexity = 0;
+
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+		complexity += chromo->nodes[chromo->activeNodes[i]]->actArity;
+	}
+
+	return complexity;
+}
+
+/*
+	Gets the number of generations required to find the given chromosome
+*/
+DLL_EXPORT int getChromosomeGenerations(struct chromosome *chromo) {
+	return chromo->generation;
+}
+
+
+/*
+	set the active nodes in the given chromosome, unless they are already
+	set for its current genes i.e. activeNodesDirty is not set.
+
+	The nodes are swept from the last to the first, marking the inputs of
+	each active node, and so only the earlier nodes need to be revisited
+	when a recurrent connection marks a later node. The active nodes are
+	then read in order without sorting.
+*/
+static void setChromosomeActiveNodes(struct chromosome *chromo) {
+
+	int i, j;
+	int input;
+	int restart;
+	double start;
+
+	/* error checking */
+	if (chromo == NULL) {
+		printf("Error: chromosome has not been initialised and so the active nodes cannot be set.\n");
+		return;
+	}
+
+	if (chromo->activeNodesDirty == 0) {
+		return;
+	}
+
+	start = (chromo->profile != NULL) ? getProfileClock() : 0;
+
+	/* reset the active nodes */
+	for (i = 0; i < chromo->numNodes; i++) {
+		chromo->nodes[i]->active = 0;
+	}
+
+	/* the nodes connected to the outputs are active */
+	for (i = 0; i < chromo->numOutputs; i++) {
+
+		/* if the output connects to a chromosome input, skip */
+		if (chromo->outputNodes[i] < chromo->numInputs) {
+			continue;
+		}
+
+		chromo->nodes[chromo->outputNodes[i] - chromo->numInputs]->active = 1;
+	}
+
+	/* the nodes connected to active nodes are active */
+	for (i = chromo->numNodes - 1; i >= 0; i--) {
+
+		if (chromo->nodes[i]->active == 0) {
+			continue;
+		}
+
+		/* set the nodes actual arity*/
+		chromo->nodes[i]->actArity = getChromosomeNodeArity(chromo, i);
+
+		restart = -1;
+
+		for (j = 0; j < chromo->nodes[i]->actArity; j++) {
+
+			input = chromo->nodes[i]->inputs[j] - chromo->numInputs;
+
+			if (input < 0 || chromo->nodes[input]->active == 1) {
+				continue;
 			}
 
+			chromo->nodes[input]->active = 1;
+
+			/* a recurrent connection to a node which has already been swept */
+			if (input > i && input > restart) {
+				restart = input;
+			}
 		}
 
-		/* mutate node input gene */
-		else if (geneToMutate < numFunctionGenes + numInputGenes) {
+		if (restart != -1) {
+			i = restart + 1;
+		}
+	}
 
-			nodeIndex = (int) ((geneToMutate - numFunctionGenes) / chromo->arity);
-			nodeInputIndex = (geneToMutate - numFunctionGenes) % chromo->arity;
+	/* place active nodes in order */
+	chromo->numActiveNodes = 0;
 
-			previousGeneValue = chromo->nodes[nodeIndex]->inputs[nodeInputIndex];
+	for (i = 0; i < chromo->numNodes; i++) {
+		if (chromo->nodes[i]->active == 1) {
+			chromo->activeNodes[chromo->numActiveNodes] = i;
+			chromo->numActiveNodes++;
+		}
+	}
 
-			chromo->nodes[nodeIndex]->inputs[nodeInputIndex] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, nodeIndex, params->recurrentConnectionProbability, seed);
+	/* build the execution plan from the active nodes */
+	compileChromosome(chromo);
 
-			newGeneValue = chromo->nodes[nodeIndex]->inputs[nodeInputIndex];
+	chromo->activeNodesDirty = 0;
 
-			if ((previousGeneValue != newGeneValue) && (chromo->nodes[nodeIndex]->active == 1)) {
-				mutatedActive = 1;
+	if (chromo->profile != NULL) {
+		addProfileCount(&chromo->profile->activeNodesUpdates, 1);
+		addProfileTime(chromo->profile, PROFILEACTIVENODES, start);
+	}
+}
+
+
+/*
+	Builds the flat execution plan of the given chromosome. For every
+	active node, in the order given by activeNodes, the plan holds the
+	node function, actual arity, the slot the node output is written to
+	and contiguous copies of the node inputs and connection weights.
+	Slots index nodeValues, where chromosome inputs come first followed
+	by the node outputs i.e. the same numbering used by the input genes.
+*/
+static void compileChromosome(struct chromosome *chromo) {
+
+	int i, j;
+	int activeNode;
+	int *planInputs;
+	double *planWeights;
+
+	chromo->planRecurrent = 0;
+
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+
+		activeNode = chromo->activeNodes[i];
+
+		chromo->planFunctions[i] = chromo->nodes[activeNode]->function;
+		chromo->planArity[i] = chromo->nodes[activeNode]->actArity;
+		chromo->planSlots[i] = chromo->numInputs + activeNode;
+
+		planInputs = chromo->planInputs + (i * chromo->arity);
+		planWeights = chromo->planWeights + (i * chromo->arity);
+
+		for (j = 0; j < chromo->nodes[activeNode]->actArity; j++) {
+			planInputs[j] = chromo->nodes[activeNode]->inputs[j];
+			planWeights[j] = chromo->nodes[activeNode]->weights[j];
+
+			/* inputs from the node itself or later nodes make the plan recurrent */
+			if (planInputs[j] >= chromo->planSlots[i]) {
+				chromo->planRecurrent = 1;
 			}
 		}
+	}
 
-		/* mutate output gene */
-		else {
-			nodeIndex = geneToMutate - numFunctionGenes - numInputGenes;
+	/* plans whose steps all use the same activation function can use the fast evaluator */
+	chromo->planActivation = ACTIVATIONNONE;
 
-			previousGeneValue = chromo->outputNodes[nodeIndex];
+	if (chromo->fastActivation == 1 && chromo->numActiveNodes > 0) {
 
-			chromo->outputNodes[nodeIndex] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections, seed);
+		for (i = 1; i < chromo->numActiveNodes && chromo->planFunctions[i] == chromo->planFunctions[0]; i++);
+
+		if (i == chromo->numActiveNodes) {
+			chromo->planActivation = getActivation(chromo->funcSet->functions[chromo->planFunctions[0]]);
+		}
+	}
+}
+
+
+/*
+	returns the activation of the fast evaluator computing the given node
+	function, ACTIVATIONNONE if the node function has no fast form
+*/
+static int getActivation(double (*function)(const int numInputs, const double *inputs, const double *connectionWeights)) {
+
+	if (function == _sigmoid) {
+		return ACTIVATIONSIGMOID;
+	}
+	else if (function == _hyperbolicTangent) {
+		return ACTIVATIONHYPERBOLICTANGENT;
+	}
+	else if (function == _softsign) {
+		return ACTIVATIONSOFTSIGN;
+	}
+	else if (function == _gaussian) {
+		return ACTIVATIONGAUSSIAN;
+	}
+
+	return ACTIVATIONNONE;
+}
+
+
+/*
+	allocates a chromosome of the given dimensions as a single block of
+	memory holding the chromosome, its nodes, their genes and its execution
+	plan. The node genes are stored node after node so that the weights of
+	consecutive nodes are contiguous. Only the buffers which are allocated on
+	demand (blockValues and the node cache) and the shared function set are
+	kept outside the block.
+*/
+static struct chromosome *allocateChromosome(int numInputs, int numNodes, int numOutputs, int arity) {
+
+	struct chromosome *chromo;
+	char *block;
+	int i;
+
+	size_t size = 0;
+	size_t chromoOffset = getChromosomePartOffset(&size, sizeof(struct chromosome));
+	size_t nodePointersOffset = getChromosomePartOffset(&size, numNodes * sizeof(struct node*));
+	size_t nodesOffset = getChromosomePartOffset(&size, numNodes * sizeof(struct node));
+	size_t nodeInputsOffset = getChromosomePartOffset(&size, numNodes * arity * sizeof(int));
+	size_t nodeWeightsOffset = getChromosomePartOffset(&size, numNodes * arity * sizeof(double));
+	size_t outputNodesOffset = getChromosomePartOffset(&size, numOutputs * sizeof(int));
+	size_t activeNodesOffset = getChromosomePartOffset(&size, numNodes * sizeof(int));
+	size_t outputValuesOffset = getChromosomePartOffset(&size, numOutputs * sizeof(double));
+	size_t nodeInputsHoldOffset = getChromosomePartOffset(&size, arity * sizeof(double));
+	size_t planFunctionsOffset = getChromosomePartOffset(&size, numNodes * sizeof(int));
+	size_t planArityOffset = getChromosomePartOffset(&size, numNodes * sizeof(int));
+	size_t planSlotsOffset = getChromosomePartOffset(&size, numNodes * sizeof(int));
+	size_t planInputsOffset = getChromosomePartOffset(&size, numNodes * arity * sizeof(int));
+	size_t planWeightsOffset = getChromosomePartOffset(&size, numNodes * arity * sizeof(double));
+	size_t nodeValuesOffset = getChromosomePartOffset(&size, (numInputs + numNodes) * sizeof(double));
+	size_t nodeDepthsOffset = getChromosomePartOffset(&size, numNodes * sizeof(int));
+
+	block = (char*)malloc(size);
+
+	if (block == NULL) {
+		printf("Error: cannot allocate memory for a chromosome of %d nodes.\nTerminating CGP-Library.\n", numNodes);
+		exit(0);
+	}
+
+	chromo = (struct chromosome*)(block + chromoOffset);
+
+	chromo->numInputs = numInputs;
+	chromo->numNodes = numNodes;
+	chromo->numOutputs = numOutputs;
+	chromo->arity = arity;
+
+	chromo->nodes = (struct node**)(block + nodePointersOffset);
+	chromo->outputNodes = (int*)(block + outputNodesOffset);
+	chromo->activeNodes = (int*)(block + activeNodesOffset);
+	chromo->outputValues = (double*)(block + outputValuesOffset);
+	chromo->nodeInputsHold = (double*)(block + nodeInputsHoldOffset);
+	chromo->funcSet = NULL;
+	chromo->generation = -1;
+
+	/* point each node at its genes */
+	for (i = 0; i < numNodes; i++) {
+		chromo->nodes[i] = (struct node*)(block + nodesOffset) + i;
+		chromo->nodes[i]->inputs = (int*)(block + nodeInputsOffset) + i * arity;
+		chromo->nodes[i]->weights = (double*)(block + nodeWeightsOffset) + i * arity;
+	}
+
+	chromo->planFunctions = (int*)(block + planFunctionsOffset);
+	chromo->planArity = (int*)(block + planArityOffset);
+	chromo->planSlots = (int*)(block + planSlotsOffset);
+	chromo->planInputs = (int*)(block + planInputsOffset);
+	chromo->planWeights = (double*)(block + planWeightsOffset);
+	chromo->nodeValues = (double*)(block + nodeValuesOffset);
+	chromo->nodeDepths = (int*)(block + nodeDepthsOffset);
+
+	/* the active nodes are found once the genes are set */
+	chromo->activeNodesDirty = 1;
+
+	chromo->fastActivation = 0;
+	chromo->planActivation = ACTIVATIONNONE;
+
+	/* only allocated once executeChromosomeBatch is used */
+	chromo->blockValues = NULL;
+
+	/* only allocated once executeChromosomesOffload is used */
+	chromo->offloadOutputs = NULL;
+	chromo->offloadNumSamples = 0;
+	chromo->offloadDataSetId = 0;
+
+	chromo->profile = NULL;
+
+	/* only allocated once a dataSet is cached, see getNodeCache */
+	chromo->nodeCacheSize = 0;
+	chromo->nodeCache = NULL;
+	chromo->nodeRecompute = NULL;
+	chromo->nodeCacheClock = 0;
+
+	return chromo;
+}
+
+
+/*
+	returns the offset of a part of partSize bytes appended to a chromosome
+	block of the given size, and increases the size of the block accordingly
+*/
+static size_t getChromosomePartOffset(size_t *size, size_t partSize) {
+
+	size_t offset = *size;
+
+	*size += (partSize + CHROMOSOMEALIGNMENT - 1) / CHROMOSOMEALIGNMENT * CHROMOSOMEALIGNMENT;
+
+	return offset;
+}
+
+
+/*
+	get the depth of the given chromosome
+	depth is defined as the largest number of active nodes between the input and output
+
+	As the nodes are in order, the depth of each node only depends on the
+	depths of the earlier nodes. Recurrent connections add no depth.
+*/
+DLL_EXPORT int getChromosomeDepth(struct chromosome *chromo)
+{
+	int i, j;
+	int input;
+	int maxDepth = -1;
+
+	removeInactiveNodes(chromo);
+
+	for (i = 0; i < chromo->numNodes; i++)
+	{
+		chromo->nodeDepths[i] = 0;
+
+		for (j = 0; j < chromo->nodes[i]->actArity; j++)
+		{
+			input = chromo->nodes[i]->inputs[j] - chromo->numInputs;
+
+			if (input >= 0 && input < i && chromo->nodeDepths[input] > chromo->nodeDepths[i])
+			{
+				chromo->nodeDepths[i] = chromo->nodeDepths[input];
+			}
+		}
+
+		chromo->nodeDepths[i]++;
+	}
+
+	for (i = 0; i < chromo->numOutputs; i++)
+	{
+		if (chromo->outputNodes[i] < chromo->numInputs)
+		{
+			if (maxDepth < 0)
+			{
+				maxDepth = 0;
+			}
+		}
+		else if (chromo->nodeDepths[chromo->outputNodes[i] - chromo->numInputs] > maxDepth)
+		{
+			maxDepth = chromo->nodeDepths[chromo->outputNodes[i] - chromo->numInputs];
+		}
+	}
+
+	return maxDepth;
+}
+
+/*
+	Sorts the given array of chromosomes by fitness, lowest to highest
+	uses insertion sort (quickish and stable)
+*/
+static void sortChromosomeArray(struct chromosome **chromoArray, int numChromos) {
+
+	int i, j;
+	struct chromosome *chromoTmp;
+
+	for (i = 0; i < numChromos; i++) {
+		for (j = i; j < numChromos; j++) {
+
+			if (chromoArray[i]->fitness > chromoArray[j]->fitness) {
+				chromoTmp = chromoArray[i];
+				chromoArray[i] = chromoArray[j];
+				chromoArray[j] = chromoTmp;
+			}
+		}
+	}
+}
+
+
+
+/*
+	Dataset functions
+*/
+
+
+/*
+	Initialises data structure and assigns values for given arrays
+	arrays must take the form
+	inputs[numSamples][numInputs]
+	outputs[numSamples][numOutputs]
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetFromArrays(int numInputs, int numOutputs, int numSamples, double *inputs, double *outputs) {
+
+	struct dataSet *data;
+
+	/* initialise memory for data structure */
+	data = allocateDataSet(numInputs, numOutputs, numSamples);
+
+	/* the given arrays have the same layout as the dataSet storage */
+	memcpy(data->inputBlock, inputs, numSamples * numInputs * sizeof(double));
+	memcpy(data->outputBlock, outputs, numSamples * numOutputs * sizeof(double));
+
+	return data;
+}
+
+
+/*
+	Initialises data structure and assigns values of given file
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetFromFile(char const *file) {
+
+	return initialiseDataSetFromMappedFile(file, 1);
+}
+
+
+/*
+	Initialises data structure and assigns values of given file, which is
+	memory mapped and parsed by numThreads threads each given a range of lines.
+
+	The lines are first counted by each thread so that every thread knows
+	the sample its range starts at, then each thread parses its own lines
+	straight into the rows of the dataSet.
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetFromMappedFile(char const *file, int numThreads) {
+
+	struct dataSet *data;
+	char *contents;
+	const char *end;
+	const char *samplesStart;
+	const char **rangeStarts;
+	char header[DATASETVALUELENGTH];
+	size_t size;
+	size_t headerLength;
+	int numInputs, numOutputs, numSamples;
+	int *rangeSamples;
+	int *rangeErrors;
+	int numLines;
+	int t;
+
+	if (numThreads < 1) {
+		printf("Error: the number of threads used to load a dataSet must be at least one; '%d' given.\nTerminating CGP-Library.\n", numThreads);
+		exit(0);
+	}
+
+	contents = mapFileContents(file, &size);
+	end = contents + size;
+
+	/* the first line contains the meta data */
+	samplesStart = getDataSetLineStart(contents, end);
+	headerLength = (size_t)(samplesStart - contents);
+
+	if (headerLength >= DATASETVALUELENGTH) {
+		headerLength = DATASETVALUELENGTH - 1;
+	}
+
+	memcpy(header, contents, headerLength);
+	header[headerLength] = '\0';
+
+	if (sscanf(header, "%d,%d,%d", &numInputs, &numOutputs, &numSamples) != 3 || numInputs < 1 || numOutputs < 1 || numSamples < 0) {
+		printf("Error: the first line of file '%s' must give the number of inputs, outputs and samples.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	/* initialise memory for data structure */
+	data = allocateDataSet(numInputs, numOutputs, numSamples);
+
+	/* split the samples into one range of whole lines for each thread */
+	rangeStarts = (const char**)malloc((numThreads + 1) * sizeof(const char*));
+	rangeSamples = (int*)malloc((numThreads + 1) * sizeof(int));
+	rangeErrors = (int*)malloc(numThreads * sizeof(int));
+
+	rangeStarts[0] = samplesStart;
+	rangeStarts[numThreads] = end;
+
+	for (t = 1; t < numThreads; t++) {
+		rangeStarts[t] = getDataSetLineStart(samplesStart + ((end - samplesStart) / numThreads) * t - 1, end);
+
+		if (rangeStarts[t] < rangeStarts[t - 1]) {
+			rangeStarts[t] = rangeStarts[t - 1];
+		}
+	}
+
+	/* count the samples of each range */
+	#pragma omp parallel for default(none), private(t), shared(numThreads,rangeStarts,rangeSamples,end), schedule(static), num_threads(numThreads)
+	for (t = 0; t < numThreads; t++) {
+
+		const char *pos = rangeStarts[t];
+		const char *lineEnd;
+
+		rangeSamples[t + 1] = 0;
+
+		while (pos < rangeStarts[t + 1]) {
+
+			lineEnd = memchr(pos, '\n', end - pos);
+
+			if (lineEnd == NULL) {
+				lineEnd = end;
+			}
+
+			if (isDataSetLineBlank(pos, lineEnd) == 0) {
+				rangeSamples[t + 1]++;
+			}
+
+			pos = getDataSetLineStart(lineEnd, end);
+		}
+	}
+
+	/* the first sample of each range */
+	rangeSamples[0] = 0;
+
+	for (t = 1; t <= numThreads; t++) {
+		rangeSamples[t] += rangeSamples[t - 1];
+	}
+
+	numLines = rangeSamples[numThreads];
+
+	if (numLines != numSamples) {
+		printf("Error: file '%s' holds %d samples but its first line gives %d samples.\nTerminating CGP-Library.\n", file, numLines, numSamples);
+		exit(0);
+	}
+
+	/* parse the samples of each range into the dataSet */
+	#pragma omp parallel for default(none), private(t), shared(numThreads,rangeStarts,rangeSamples,rangeErrors,end,data), schedule(static), num_threads(numThreads)
+	for (t = 0; t < numThreads; t++) {
+
+		const char *pos = rangeStarts[t];
+		const char *lineEnd;
+		int sample = rangeSamples[t];
+
+		rangeErrors[t] = -1;
+
+		while (pos < rangeStarts[t + 1]) {
+
+			lineEnd = memchr(pos, '\n', end - pos);
+
+			if (lineEnd == NULL) {
+				lineEnd = end;
+			}
+
+			if (isDataSetLineBlank(pos, lineEnd) == 0) {
+
+				if (parseDataSetLine(pos, lineEnd, data->inputData[sample], data->numInputs, data->outputData[sample], data->numOutputs) != data->numInputs + data->numOutputs && rangeErrors[t] == -1) {
+					rangeErrors[t] = sample;
+				}
+
+				sample++;
+			}
+
+			pos = getDataSetLineStart(lineEnd, end);
+		}
+	}
+
+	for (t = 0; t < numThreads; t++) {
+		if (rangeErrors[t] != -1) {
+			printf("Error: sample %d of file '%s' does not hold %d values.\nTerminating CGP-Library.\n", rangeErrors[t], file, numInputs + numOutputs);
+			exit(0);
+		}
+	}
+
+	free(rangeStarts);
+	free(rangeSamples);
+	free(rangeErrors);
+
+	unmapFileContents(contents, size);
+
+	return data;
+}
+
+
+/*
+	returns the contents of the given file, memory mapped where supported
+	and otherwise read into memory. The contents are not null terminated.
+*/
+static char *mapFileContents(char const *file, size_t *size) {
+
+	char *contents;
+
+#if defined(_WIN32)
+	FILE *fp;
+	long length;
+
+	fp = fopen(file, "rb");
+
+	if (fp == NULL) {
+		printf("Error: file '%s' cannot be found.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	fseek(fp, 0, SEEK_END);
+	length = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	contents = (char*)malloc(length > 0 ? length : 1);
+	*size = fread(contents, 1, length > 0 ? length : 0, fp);
+
+	fclose(fp);
+#else
+	int fd;
+	struct stat fileStat;
+
+	fd = open(file, O_RDONLY);
+
+	if (fd == -1) {
+		printf("Error: file '%s' cannot be found.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	if (fstat(fd, &fileStat) == -1 || fileStat.st_size == 0) {
+		printf("Error: file '%s' cannot be read.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	*size = (size_t)fileStat.st_size;
+	contents = (char*)mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	close(fd);
+
+	if (contents == MAP_FAILED) {
+		printf("Error: file '%s' cannot be memory mapped.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+#endif
+
+	return contents;
+}
+
+
+/*
+	releases the contents returned by mapFileContents
+*/
+static void unmapFileContents(char *contents, size_t size) {
+
+#if defined(_WIN32)
+	(void)size;
+	free(contents);
+#else
+	munmap(contents, size);
+#endif
+}
+
+
+/*
+	returns whether the given character separates the values of a line
+*/
+static int isDataSetSeparator(char c) {
+
+	return c == ',' || c == ' ' || c == '\t' || c == '\r';
+}
+
+
+/*
+	returns whether the given line holds no values
+*/
+static int isDataSetLineBlank(const char *pos, const char *lineEnd) {
+
+	for (; pos < lineEnd; pos++) {
+		if (isDataSetSeparator(*pos) == 0) {
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+
+/*
+	returns the start of the line after the one holding pos, or end
+*/
+static const char *getDataSetLineStart(const char *pos, const char *end) {
+
+	const char *lineEnd = memchr(pos, '\n', end - pos);
+
+	return lineEnd == NULL ? end : lineEnd + 1;
+}
+
+
+/*
+	parses the value starting at pos and returns the position after it.
+
+	Values of at most 19 significant digits whose mantissa and power of ten
+	are both exactly representable are computed with a single correctly
+	rounded multiplication or division, so giving the same value as atof.
+	Any other value is copied and given to strtod.
+*/
+static const char *parseDataSetValue(const char *pos, const char *lineEnd, double *value) {
+
+	static const double powersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+	const char *start = pos;
+	const char *valueEnd;
+	char token[DATASETVALUELENGTH];
+	uint64_t mantissa = 0;
+	int numDigits = 0;
+	int anyDigits = 0;
+	int exact = 1;
+	int negative = 0;
+	int exponent = 0;
+	int exponentValue = 0;
+	int exponentNegative = 0;
+
+	if (pos < lineEnd && (*pos == '-' || *pos == '+')) {
+		negative = (*pos == '-');
+		pos++;
+	}
+
+	/* the integer digits */
+	for (; pos < lineEnd && *pos >= '0' && *pos <= '9'; pos++) {
+
+		anyDigits = 1;
+
+		if (mantissa == 0 && *pos == '0') {
+			continue;
+		}
+
+		if (numDigits < 19) {
+			mantissa = (mantissa * 10) + (uint64_t)(*pos - '0');
+			numDigits++;
+		}
+		else {
+			exact = 0;
+		}
+	}
+
+	/* the fraction digits */
+	if (pos < lineEnd && *pos == '.') {
+
+		for (pos++; pos < lineEnd && *pos >= '0' && *pos <= '9'; pos++) {
+
+			anyDigits = 1;
+
+			if (mantissa == 0 && *pos == '0') {
+				exponent--;
+				continue;
+			}
+
+			if (numDigits < 19) {
+				mantissa = (mantissa * 10) + (uint64_t)(*pos - '0');
+				numDigits++;
+				exponent--;
+			}
+			else {
+				exact = 0;
+			}
+		}
+	}
+
+	/* the exponent */
+	if (anyDigits == 1 && pos < lineEnd && (*pos == 'e' || *pos == 'E')) {
+
+		pos++;
+
+		if (pos < lineEnd && (*pos == '-' || *pos == '+')) {
+			exponentNegative = (*pos == '-');
+			pos++;
+		}
+
+		if (pos >= lineEnd || *pos < '0' || *pos > '9') {
+			exact = 0;
+		}
+
+		for (; pos < lineEnd && *pos >= '0' && *pos <= '9'; pos++) {
+			if (exponentValue < 10000) {
+				exponentValue = (exponentValue * 10) + (*pos - '0');
+			}
+		}
+
+		exponent += exponentNegative ? -exponentValue : exponentValue;
+	}
+
+	/* the value must end at a separator */
+	if (pos < lineEnd && isDataSetSeparator(*pos) == 0) {
+		exact = 0;
+	}
+
+	if (exact == 1 && anyDigits == 1 && mantissa <= ((uint64_t)1 << 53) && exponent >= -22 && exponent <= 22) {
+
+		*value = exponent < 0 ? (double)mantissa / powersOfTen[-exponent] : (double)mantissa * powersOfTen[exponent];
+
+		if (negative == 1) {
+			*value = -*value;
+		}
+
+		return pos;
+	}
+
+	/* otherwise give strtod a null terminated copy of the value */
+	for (valueEnd = start; valueEnd < lineEnd && isDataSetSeparator(*valueEnd) == 0; valueEnd++);
+
+	if (valueEnd - start >= DATASETVALUELENGTH) {
+		printf("Error: the dataSet value '%.*s...' is longer than %d characters.\nTerminating CGP-Library.\n", 16, start, DATASETVALUELENGTH - 1);
+		exit(0);
+	}
+
+	memcpy(token, start, valueEnd - start);
+	token[valueEnd - start] = '\0';
+
+	*value = strtod(token, NULL);
+
+	return valueEnd;
+}
+
+
+/*
+	parses the inputs and then the outputs of the given line and returns
+	the number of values on the line
+*/
+static int parseDataSetLine(const char *pos, const char *lineEnd, double *inputs, int numInputs, double *outputs, int numOutputs) {
+
+	int col = 0;
+	double value;
+
+	while (1) {
+
+		while (pos < lineEnd && isDataSetSeparator(*pos) == 1) {
+			pos++;
+		}
+
+		if (pos >= lineEnd) {
+			break;
+		}
+
+		pos = parseDataSetValue(pos, lineEnd, &value);
+
+		if (col < numInputs) {
+			inputs[col] = value;
+		}
+		else if (col < numInputs + numOutputs) {
+			outputs[col - numInputs] = value;
+		}
+
+		col++;
+	}
+
+	return col;
+}
+
+/* 
+	Cross-validation functions 
+*/
+
+/* Shuffle the rows of a given dataset */
+
+DLL_EXPORT void shuffleData(struct dataSet *data, unsigned int * seed)
+{
+	int i;
+
+	checkDataSetInMemory(data, "shuffleData");
+
+	/* one buffer large enough to hold either the inputs or the outputs of a row */
+	int rowLength = (data->numInputs > data->numOutputs) ? data->numInputs : data->numOutputs;
+	double * row = (double*)malloc(rowLength * sizeof(double));
+
+	for(i = 0; i < data->numSamples; i++)
+	{
+		int rnd1 = randInt(data->numSamples, seed);  
+		int rnd2 = randInt(data->numSamples, seed); 
+
+		/* swap the rows in place so that the samples stay contiguous */
+		memcpy(row, data->inputData[rnd1], data->numInputs * sizeof(double));
+		memcpy(data->inputData[rnd1], data->inputData[rnd2], data->numInputs * sizeof(double));
+		memcpy(data->inputData[rnd2], row, data->numInputs * sizeof(double));
+
+		memcpy(row, data->outputData[rnd1], data->numOutputs * sizeof(double));
+		memcpy(data->outputData[rnd1], data->outputData[rnd2], data->numOutputs * sizeof(double));
+		memcpy(data->outputData[rnd2], row, data->numOutputs * sizeof(double));
+	}
+
+	free(row);
+
+	/* the column copy and any cached node values no longer match the order of the samples, nor do those of the views sharing the rows */
+	freeDataSetColumns(data);
+	data->id = getNewDataSetId();
+
+	#pragma omp atomic
+	dataSetsOrder++;
+}
+
+/* Create 10 folds of approximately the same size, keeping the same class proportion in each fold */
+
+DLL_EXPORT struct dataSet ** generateFolds(struct dataSet * data)
+{
+	int i, j, k;
+	int count;
+	int foldSize[10];
+	struct dataSet ** folds;
+
+	checkDataSetInMemory(data, "generateFolds");
+
+	folds = (struct dataSet**)malloc(10 * sizeof(struct dataSet*));
+	for (i = 0; i < 10; i++) 
+	{
+		foldSize[i] = 0;
+	}
+
+	i = 0;
+	count = 0;
+	while(1) // set the size of each fold
+	{
+		foldSize[i] = foldSize[i] + 1;
+		count++;
+		if(count == data->numSamples)
+			break;
+		if(i == 9)
+			i = 0;
+		else
+			i++;
+	}
+
+	// allocate memory for the folds data
+	for(i = 0; i < 10; i++) // for each fold
+	{
+		folds[i] = allocateDataSet(data->numInputs, data->numOutputs, foldSize[i]);
+	}
+
+	// keep the same class proportion in each fold
+	int * counter = (int*)malloc(10*sizeof(int));
+	for(i = 0; i < 10; i++)
+	{
+		counter[i] = 0;
+	} 
+
+	// the instances of each class are given to the folds in turn
+	int * order = getStratifiedSampleOrder(data);
+
+	for(i = 0; i < data->numSamples; i++)
+	{
+		j = order[i];
+		k = i % 10;
+
+		memcpy(folds[k]->inputData[counter[k]], data->inputData[j], data->numInputs * sizeof(double));
+		memcpy(folds[k]->outputData[counter[k]], data->outputData[j], data->numOutputs * sizeof(double));
+
+		counter[k] = counter[k] + 1;
+	}
+
+	free(order);
+	free(counter);
+
+	return folds;
+}
+
+/*
+	returns the samples of the given dataSet ordered class by class. The
+	class of a sample is its first output equal to 1, and the samples
+	without one follow those of the last class. Giving the ordered samples
+	to each of a number of groups in turn keeps the same class proportion
+	in each group.
+*/
+static int *getStratifiedSampleOrder(struct dataSet *data)
+{
+	int i, j;
+	int count = 0;
+	int *classes = (int*)malloc(data->numSamples * sizeof(int));
+	int *order = (int*)malloc(data->numSamples * sizeof(int));
+
+	for(j = 0; j < data->numSamples; j++)
+	{
+		classes[j] = data->numOutputs;
+
+		for(i = data->numOutputs - 1; i >= 0; i--)
+		{
+			if(getDataSetSampleOutput(data, j, i) == 1.0)
+			{
+				classes[j] = i;
+			}
+		}
+	}
+
+	for(i = 0; i <= data->numOutputs; i++) // for each class, and then the samples without one
+	{
+		for(j = 0; j < data->numSamples; j++) // for each instance
+		{
+			if(classes[j] == i)
+			{
+				order[count] = j;
+				count++;
+			}
+		}
+	}
+
+	free(classes);
+
+	return order;
+}
+
+/* 
+	Reduce the sample size of the dataset 
+	Utilizes only a percentage of the dataset sample size
+*/
+DLL_EXPORT struct dataSet * reduceSampleSize(struct dataSet * data, double percentage)
+{
+	if(percentage <= 0.001 || percentage >= 0.999)
+	{
+		return data;
+	}
+
+	int i, j;
+
+	checkDataSetInMemory(data, "reduceSampleSize");
+
+	// allocate memory for the data
+	struct dataSet * reducedData = allocateDataSet(data->numInputs, data->numOutputs, (int) (percentage * data->numSamples));
+
+	// count the number of instances of each class
+	int * class_size = (int *)malloc(data->numOutputs * sizeof(int));
+	for(i = 0; i < data->numOutputs; i++)
+	{
+		class_size[i] = 0;
+	}
+
+	for(i = 0; i < data->numOutputs; i++) // for each class
+	{
+		for(j = 0; j < data->numSamples; j++) // for each instance
+		{
+			if(data->outputData[j][i] == 1.0)
+			{
+				class_size[i] = class_size[i] + 1;
+			}
+		}		
+	}	
+
+	// apply the percentage reduction to each class size
+	for(i = 0; i < data->numOutputs; i++)
+	{
+		class_size[i] = (int) (percentage * class_size[i]);
+	}	
+
+	// adjust the differences between the class_size and the reducedData->numSamples
+	int sum = 0;
+	for(i = 0; i < data->numOutputs; i++)
+	{
+		sum += class_size[i];
+	}
+	
+	int diff = reducedData->numSamples - sum;
+	
+	int counter = 0;
+	for(i = 0; i < diff; i++)
+	{
+		class_size[counter] = class_size[counter] + 1;
+
+		counter++;
+		if(counter == reducedData->numOutputs)
+		{
+			counter = 0;
+		}
+	}
+
+	// keep the same class proportion during the reduction
+	int class_counter = 0;
+	int sample_counter = 0;
+	int flag_sample_max = 0;
+
+	for(i = 0; i < data->numOutputs; i++) // for each class
+	{
+		for(j = 0; j < data->numSamples; j++) // for each instance
+		{
+			if(data->outputData[j][i] == 1.0)
+			{
+				memcpy(reducedData->inputData[sample_counter], data->inputData[j], data->numInputs * sizeof(double));
+				memcpy(reducedData->outputData[sample_counter], data->outputData[j], data->numOutputs * sizeof(double));
+
+				sample_counter++;	
+				if(sample_counter == reducedData->numSamples)
+				{
+					flag_sample_max = 1;
+					break;			
+				}
+
+				class_counter++;
+				if(class_counter == class_size[i])
+				{
+					class_counter = 0;
+					break;
+				}
+			}
+		}
+
+		if(flag_sample_max == 1)
+		{
+			break;
+		}
+	}
+
+	free(class_size);
+	return reducedData;
+}
+
+/* Randomly distributes the folds for the training and validation sets */
+
+DLL_EXPORT void getIndex(int * training_index, int * validation_index, int testing_index, unsigned int * seed)
+{
+	do
+	{
+		training_index[0] = randInt(10, seed);
+	} 
+	while(testing_index == training_index[0]);
+
+	do
+	{
+		training_index[1] = randInt(10, seed);
+	} 
+	while(testing_index == training_index[1] || training_index[1] == training_index[0]);
+
+	do
+	{
+		training_index[2] = randInt(10, seed);
+	} 
+	while(testing_index == training_index[2] || training_index[2] == training_index[0] || training_index[2] == training_index[1]);
+
+	do
+	{
+		training_index[3] = randInt(10, seed);
+	} 
+	while(testing_index == training_index[3] || training_index[3] == training_index[0] || training_index[3] == training_index[1] || training_index[3] == training_index[2]);
+
+	do
+	{
+		training_index[4] = randInt(10, seed);
+	} 
+	while(testing_index == training_index[4] || training_index[4] == training_index[0] || training_index[4] == training_index[1] || training_index[4] == training_index[2] || training_index[4] == training_index[3]);
+
+	do
+	{
+		training_index[5] = randInt(10, seed);
+	} 
+	while(testing_index == training_index[5] || training_index[5] == training_index[0] || training_index[5] == training_index[1] || training_index[5] == training_index[2] || training_index[5] == training_index[3] || training_index[5] == training_index[4]);
+
+	do
+	{
+		training_index[6] = randInt(10, seed);
+	} 
+	while(testing_index == training_index[6] || training_index[6] == training_index[0] || training_index[6] == training_index[1] || training_index[6] == training_index[2] || training_index[6] == training_index[3] || training_index[6] == training_index[4] || training_index[6] == training_index[5]);
+
+	do
+	{
+		validation_index[0] = randInt(10, seed);
+	} 
+	while(testing_index == validation_index[0] || validation_index[0] == training_index[0] || validation_index[0] == training_index[1] || validation_index[0] == training_index[2] || validation_index[0] == training_index[3] || validation_index[0] == training_index[4] || validation_index[0] == training_index[5] || validation_index[0] == training_index[6]);
+
+	do
+	{
+		validation_index[1] = randInt(10, seed);
+	} 
+	while(testing_index == validation_index[1] || validation_index[1] == training_index[0] || validation_index[1] == training_index[1] || validation_index[1] == training_index[2] || validation_index[1] == training_index[3] || validation_index[1] == training_index[4] || validation_index[1] == training_index[5] || validation_index[1] == training_index[6] || validation_index[1] == validation_index[0]);
+
+}
+
+/* Build training data set */
+
+DLL_EXPORT struct dataSet * getTrainingData(struct dataSet ** folds, int * training_index)
+{
+	int i, l;
+	int numSamples = 0;
+	struct dataSet * trainingData;
+	
+	for(i = 0; i < 7; i++) // calculate the number of instances
+	{
+		numSamples = numSamples + folds[training_index[i]]->numSamples;
+	}
+
+	// allocate memory for the data
+	trainingData = allocateDataSet(folds[0]->numInputs, folds[0]->numOutputs, numSamples);
+
+	l = 0;
+	for (i = 0; i < 7; i++) // for each fold
+	{
+		copyDataSetSamples(trainingData, l, folds[training_index[i]]);
+
+		l = l + folds[training_index[i]]->numSamples;
+	}
+
+	return trainingData;
+}
+
+/* Build validation data set */
+
+DLL_EXPORT struct dataSet * getValidationData(struct dataSet ** folds, int * validation_index)
+{
+	int i, l;
+	int numSamples = 0;
+	struct dataSet * validationData;
+	
+	for(i = 0; i < 2; i++) // calculate the number of instances
+	{
+		numSamples = numSamples + folds[validation_index[i]]->numSamples;
+	}
+
+	// allocate memory for the data
+	validationData = allocateDataSet(folds[0]->numInputs, folds[0]->numOutputs, numSamples);
+
+	l = 0;
+	for (i = 0; i < 2; i++) // for each fold
+	{
+		copyDataSetSamples(validationData, l, folds[validation_index[i]]);
+
+		l = l + folds[validation_index[i]]->numSamples;
+	}
+
+	return validationData;
+}
+
+/* Build testing data set */
+
+DLL_EXPORT struct dataSet * getTestingData(struct dataSet ** folds, int testing_index)
+{
+	// allocate memory for the data
+	struct dataSet * testingData = allocateDataSet(folds[0]->numInputs, folds[0]->numOutputs, folds[testing_index]->numSamples);
+
+	copyDataSetSamples(testingData, 0, folds[testing_index]);
+
+	return testingData;
+}
+
+/*
+	Initialises a dataSet view of the given samples of the given dataSet.
+	The view shares the rows of the given dataSet and so must be freed
+	before it.
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetView(struct dataSet *data, int numSamples, const int *samples) {
+
+	int i;
+	struct dataSet *view;
+
+	view = allocateDataSetView(data->numInputs, data->numOutputs, numSamples);
+
+	for (i = 0; i < numSamples; i++) {
+
+		if (samples[i] < 0 || samples[i] >= data->numSamples) {
+			printf("Error: sample %d is not in the dataSet.\nTerminating CGP-Library.\n", samples[i]);
+			exit(0);
+		}
+
+		view->inputData[i] = getDataSetSampleInputs(data, samples[i]);
+		view->outputData[i] = getDataSetSampleOutputs(data, samples[i]);
+	}
+
+	return view;
+}
+
+
+/* Build a view of the training data set */
+
+DLL_EXPORT struct dataSet * getTrainingDataView(struct dataSet ** folds, int * training_index)
+{
+	return initialiseDataSetViewFromFolds(folds, training_index, 7);
+}
+
+/* Build a view of the validation data set */
+
+DLL_EXPORT struct dataSet * getValidationDataView(struct dataSet ** folds, int * validation_index)
+{
+	return initialiseDataSetViewFromFolds(folds, validation_index, 2);
+}
+
+/* Build a view of the testing data set */
+
+DLL_EXPORT struct dataSet * getTestingDataView(struct dataSet ** folds, int testing_index)
+{
+	return initialiseDataSetViewFromFolds(folds, &testing_index, 1);
+}
+
+
+/*
+	Initialises a dataSet view of the samples of the given folds in the
+	same order as getTrainingData, getValidationData and getTestingData
+*/
+static struct dataSet *initialiseDataSetViewFromFolds(struct dataSet **folds, const int *foldIndexes, int numFolds) {
+
+	int i, j, l;
+	int numSamples = 0;
+	struct dataSet *view;
+
+	for (i = 0; i < numFolds; i++) {
+		numSamples += folds[foldIndexes[i]]->numSamples;
+	}
+
+	view = allocateDataSetView(folds[0]->numInputs, folds[0]->numOutputs, numSamples);
+
+	l = 0;
+	for (i = 0; i < numFolds; i++) {
+		for (j = 0; j < folds[foldIndexes[i]]->numSamples; j++) {
+
+			view->inputData[l] = folds[foldIndexes[i]]->inputData[j];
+			view->outputData[l] = folds[foldIndexes[i]]->outputData[j];
+
+			l++;
+		}
+	}
+
+	return view;
+}
+
+
+/*
+	frees given dataSet
+*/
+DLL_EXPORT void freeDataSet(struct dataSet *data) {
+
+	/* attempt to prevent user double freeing */
+	if (data == NULL) {
+		printf("Warning: double freeing of dataSet prevented.\n");
+		return;
+	}
+
+	if (data->stream != NULL) {
+		unmapFileContents(data->stream->contents, data->stream->size);
+		free(data->stream);
+	}
+
+	freeDataSetColumns(data);
+	alignedFree(data->inputBlock);
+	alignedFree(data->outputBlock);
+	free(data->inputData);
+	free(data->outputData);
+	free(data);
+}
+
+
+/*
+	prints the given data structure to the screen
+*/
+DLL_EXPORT void printDataSet(struct dataSet *data) {
+
+	int i, j;
+
+	printf("DATA SET\n");
+	printf("Inputs: %d, ", data->numInputs);
+	printf("Outputs: %d, ", data->numOutputs);
+	printf("Samples: %d\n", data->numSamples);
+
+	for (i = 0; i < data->numSamples; i++) {
+
+		for (j = 0; j < data->numInputs; j++) {
+			printf("%f ", getDataSetSampleInput(data, i, j));
+		}
+
+		printf(" : ");
+
+		for (j = 0; j < data->numOutputs; j++) {
+			printf("%f ", getDataSetSampleOutput(data, i, j));
+		}
+
+		printf("\n");
+	}
+}
+
+
+/*
+	saves dataset to file
+*/
+DLL_EXPORT void saveDataSet(struct dataSet *data, char const *fileName) {
+
+	int i, j;
+	FILE *fp;
+
+	fp = fopen(fileName, "w");
+
+	if (fp == NULL) {
+		printf("Warning: cannot save data set to %s. Data set was not saved.\n", fileName);
+		return;
+	}
+
+	fprintf(fp, "%d,", data->numInputs);
+	fprintf(fp, "%d,", data->numOutputs);
+	fprintf(fp, "%d", data->numSamples);
+	fprintf(fp, "\n");
+
+
+	for (i = 0; i < data->numSamples; i++) {
+
+		for (j = 0; j < data->numInputs; j++) {
+			fprintf(fp, "%f,", getDataSetSampleInput(data, i, j));
+		}
+
+		for (j = 0; j < data->numOutputs; j++) {
+			if(j != data->numOutputs - 1)
+				fprintf(fp, "%f,", getDataSetSampleOutput(data, i, j));
+			else
+				fprintf(fp, "%f", getDataSetSampleOutput(data, i, j));
+		}
+
+		fprintf(fp, "\n");
+	}
+
+	fclose(fp);
+}
+
+
+/*
+	saves the given dataSet to a binary file. The contiguous inputs and
+	outputs are each written at once, the rows of views one at a time.
+*/
+DLL_EXPORT void saveDataSetBinary(struct dataSet *data, char const *fileName) {
+
+	int i;
+	int failed = 0;
+	FILE *fp;
+	struct binaryFileHeader header;
+	struct binaryDataSetRecord record;
+
+	fp = fopen(fileName, "wb");
+
+	if (fp == NULL) {
+		printf("Warning: cannot save data set to %s. Data set was not saved.\n", fileName);
+		return;
+	}
+
+	memset(&header, 0, sizeof(struct binaryFileHeader));
+	memcpy(header.magic, "CGPDEDS", 8);
+	header.byteOrder = BINARYBYTEORDER;
+	header.version = BINARYFORMATVERSION;
+	header.numRecords = 1;
+
+	memset(&record, 0, sizeof(struct binaryDataSetRecord));
+	record.numInputs = data->numInputs;
+	record.numOutputs = data->numOutputs;
+	record.numSamples = data->numSamples;
+
+	failed |= fwrite(&header, sizeof(struct binaryFileHeader), 1, fp) != 1;
+	failed |= fwrite(&record, sizeof(struct binaryDataSetRecord), 1, fp) != 1;
+
+	if (data->inputBlock != NULL) {
+		failed |= fwrite(data->inputBlock, sizeof(double), (size_t)data->numSamples * data->numInputs, fp) != (size_t)data->numSamples * data->numInputs;
+		failed |= fwrite(data->outputBlock, sizeof(double), (size_t)data->numSamples * data->numOutputs, fp) != (size_t)data->numSamples * data->numOutputs;
+	}
+	else {
+		for (i = 0; i < data->numSamples; i++) {
+			failed |= fwrite(getDataSetSampleInputs(data, i), sizeof(double), data->numInputs, fp) != (size_t)data->numInputs;
+		}
+
+		for (i = 0; i < data->numSamples; i++) {
+			failed |= fwrite(getDataSetSampleOutputs(data, i), sizeof(double), data->numOutputs, fp) != (size_t)data->numOutputs;
+		}
+	}
+
+	if (failed != 0) {
+		printf("Warning: cannot save data set to %s. Data set was not saved.\n", fileName);
+	}
+
+	fclose(fp);
+}
+
+
+/*
+	Initialises data structure and assigns values of given binary file,
+	saved by saveDataSetBinary. The file is memory mapped and its inputs
+	and outputs copied straight into the dataSet.
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetFromBinaryFile(char const *file) {
+
+	struct dataSet *data;
+	struct binaryDataSetRecord record;
+	char *contents;
+	const char *values;
+	size_t size;
+	size_t numInputValues, numOutputValues;
+
+	contents = mapFileContents(file, &size);
+	values = getBinaryDataSetValues(file, contents, size, &record);
+
+	numInputValues = (size_t)record.numSamples * record.numInputs;
+	numOutputValues = (size_t)record.numSamples * record.numOutputs;
+
+	data = allocateDataSet(record.numInputs, record.numOutputs, record.numSamples);
+
+	memcpy(data->inputBlock, values, numInputValues * sizeof(double));
+	memcpy(data->outputBlock, values + (numInputValues * sizeof(double)), numOutputValues * sizeof(double));
+
+	unmapFileContents(contents, size);
+
+	return data;
+}
+
+
+/*
+	checks the given mapped binary dataSet file and reads its record,
+	returning the start of the inputs which are followed by the outputs
+*/
+static const char *getBinaryDataSetValues(char const *file, const char *contents, size_t size, struct binaryDataSetRecord *record) {
+
+	const char *values;
+	size_t numValues;
+	int numRecords;
+
+	values = getBinaryFileRecords(file, contents, size, "CGPDEDS", &numRecords);
+
+	if (numRecords != 1 || (size_t)(contents + size - values) < sizeof(struct binaryDataSetRecord)) {
+		printf("Error: file '%s' does not hold one dataSet.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	memcpy(record, values, sizeof(struct binaryDataSetRecord));
+	values += sizeof(struct binaryDataSetRecord);
+
+	numValues = (size_t)record->numSamples * (record->numInputs + record->numOutputs);
+
+	if (record->numInputs < 1 || record->numOutputs < 1 || record->numSamples < 0 || (size_t)(contents + size - values) != numValues * sizeof(double)) {
+		printf("Error: file '%s' does not hold one dataSet.\nTerminating CGP-Library.\n", file);
+		exit(0);
+	}
+
+	return values;
+}
+
+
+/*
+	Initialises a streamed dataSet of the given binary file, saved by
+	saveDataSetBinary. The file stays mapped and its samples are read a
+	chunk of chunkSize samples at a time, see initialiseDataSetChunk.
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetStreamFromBinaryFile(char const *file, int chunkSize) {
+
+	struct dataSet *data;
+	struct dataStream *stream;
+	struct binaryDataSetRecord record;
+	const char *values;
+
+	if (chunkSize < 1) {
+		printf("Error: the chunk size of a streamed dataSet must be at least one; %d is invalid.\nTerminating CGP-Library.\n", chunkSize);
+		exit(0);
+	}
+
+	stream = (struct dataStream*)malloc(sizeof(struct dataStream));
+
+	stream->contents = mapFileContents(file, &stream->size);
+	values = getBinaryDataSetValues(file, stream->contents, stream->size, &record);
+
+	stream->inputValues = (double*)values;
+	stream->outputValues = stream->inputValues + ((size_t)record.numSamples * record.numInputs);
+	stream->chunkSize = chunkSize;
+	stream->numChunks = (record.numSamples + chunkSize - 1) / chunkSize;
+	stream->firstChunkId = getNewDataSetIds(stream->numChunks);
+
+	data = (struct dataSet*)malloc(sizeof(struct dataSet));
+
+	data->numInputs = record.numInputs;
+	data->numOutputs = record.numOutputs;
+	data->numSamples = record.numSamples;
+
+	data->inputData = NULL;
+	data->outputData = NULL;
+	data->inputBlock = NULL;
+	data->outputBlock = NULL;
+	data->inputColumns = NULL;
+	data->inputColumnsOrder = 0;
+	data->offloadMapped = 0;
+	data->id = getNewDataSetId();
+	data->stream = stream;
+
+	return data;
+}
+
+
+/*
+	returns the number of chunks of the given dataSet. dataSets held in
+	memory are one chunk.
+*/
+DLL_EXPORT int getNumDataSetChunks(struct dataSet *data) {
+
+	if (data->stream == NULL) {
+		return 1;
+	}
+
+	return data->stream->numChunks;
+}
+
+
+/*
+	Initialises a dataSet view of the samples of the given chunk of the
+	given dataSet. For streamed dataSets the next chunk is prefetched to
+	overlap reading it with the use of this one and the previous chunk is
+	released, so only a few chunks are held at once.
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetChunk(struct dataSet *data, int chunk) {
+
+	int i;
+	int numSamples;
+	struct dataSet *view;
+	struct dataStream *stream = data->stream;
+
+	if (chunk < 0 || chunk >= getNumDataSetChunks(data)) {
+		printf("Error: chunk %d is not in the dataSet.\nTerminating CGP-Library.\n", chunk);
+		exit(0);
+	}
+
+	/* the one chunk of a dataSet held in memory holds the same samples */
+	if (stream == NULL) {
+
+		view = allocateDataSetView(data->numInputs, data->numOutputs, data->numSamples);
+		view->id = data->id;
+
+		memcpy(view->inputData, data->inputData, data->numSamples * sizeof(double*));
+		memcpy(view->outputData, data->outputData, data->numSamples * sizeof(double*));
+
+		return view;
+	}
+
+	numSamples = data->numSamples - (chunk * stream->chunkSize);
+	numSamples = numSamples < stream->chunkSize ? numSamples : stream->chunkSize;
+
+	view = allocateDataSetView(data->numInputs, data->numOutputs, numSamples);
+	view->id = stream->firstChunkId + chunk;
+
+	for (i = 0; i < numSamples; i++) {
+		view->inputData[i] = stream->inputValues + (((size_t)chunk * stream->chunkSize) + i) * data->numInputs;
+		view->outputData[i] = stream->outputValues + (((size_t)chunk * stream->chunkSize) + i) * data->numOutputs;
+	}
+
+	/* the chunks are read in order, starting again from the first */
+	adviseDataStreamChunk(stream, data->numInputs, data->numOutputs, (chunk + 1) % stream->numChunks, 1);
+
+	if (stream->numChunks > 2) {
+		adviseDataStreamChunk(stream, data->numInputs, data->numOutputs, (chunk + stream->numChunks - 1) % stream->numChunks, 0);
+	}
+
+	return view;
+}
+
+
+/*
+	advises the kernel that the pages of the given chunk of the given
+	stream are about to be needed, reading them ahead, or are no longer
+	needed, releasing them. Only the pages wholly within the chunk are
+	released, as the others may hold the samples of the chunks either side.
+*/
+static void adviseDataStreamChunk(struct dataStream *stream, int numInputs, int numOutputs, int chunk, int needed) {
+
+#if defined(_WIN32)
+	(void)stream;
+	(void)numInputs;
+	(void)numOutputs;
+	(void)chunk;
+	(void)needed;
+#else
+	int i;
+	uintptr_t start, end;
+	uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+	size_t firstSample = (size_t)chunk * stream->chunkSize;
+	size_t numSamples = (size_t)stream->chunkSize;
+	double *values[2];
+	int rowLengths[2];
+
+	values[0] = stream->inputValues;
+	values[1] = stream->outputValues;
+	rowLengths[0] = numInputs;
+	rowLengths[1] = numOutputs;
+
+	/* the inputs and then the outputs of the chunk */
+	for (i = 0; i < 2; i++) {
+
+		start = (uintptr_t)(values[i] + (firstSample * rowLengths[i]));
+		end = (uintptr_t)(values[i] + ((firstSample + numSamples) * rowLengths[i]));
+		end = end < (uintptr_t)(stream->contents + stream->size) ? end : (uintptr_t)(stream->contents + stream->size);
+
+		if (needed == 1) {
+			start -= start % pageSize;
+			madvise((void*)start, end - start, MADV_WILLNEED);
+		}
+		else {
+			start += (pageSize - (start % pageSize)) % pageSize;
+			end -= end % pageSize;
+
+			if (end > start) {
+				madvise((void*)start, end - start, MADV_DONTNEED);
+			}
+		}
+	}
+#endif
+}
+
+
+/*
+	exits if the given dataSet is streamed, as the named function needs
+	all the samples to be held in memory
+*/
+static void checkDataSetInMemory(struct dataSet *data, char const *functionName) {
+
+	if (data->stream != NULL) {
+		printf("Error: %s cannot be used with a streamed dataSet.\nTerminating CGP-Library.\n", functionName);
+		exit(0);
+	}
+}
+
+
+/*
+	returns the number of inputs for each sample in the given dataSet
+*/
+DLL_EXPORT int getNumDataSetInputs(struct dataSet *data) {
+	return data->numInputs;
+}
+
+
+/*
+	returns the number of outputs for each sample in the given dataSet
+*/
+DLL_EXPORT int getNumDataSetOutputs(struct dataSet *data) {
+	return data->numOutputs;
+}
+
+
+/*
+	returns the number of samples in the given dataSet
+*/
+DLL_EXPORT int getNumDataSetSamples(struct dataSet *data) {
+	return data->numSamples;
+}
+
+
+/*
+	returns the inputs of the given sample of the given dataSet
+*/
+DLL_EXPORT double *getDataSetSampleInputs(struct dataSet *data, int sample) {
+
+	if (data->stream != NULL) {
+		return data->stream->inputValues + ((size_t)sample * data->numInputs);
+	}
+
+	return data->inputData[sample];
+}
+
+
+/*
+	returns the given input of the given sample of the given dataSet
+*/
+DLL_EXPORT double getDataSetSampleInput(struct dataSet *data, int sample, int input) {
+	return getDataSetSampleInputs(data, sample)[input];
+}
+
+
+/*
+	returns the outputs of the given sample of the given dataSet
+*/
+DLL_EXPORT double *getDataSetSampleOutputs(struct dataSet *data, int sample) {
+
+	if (data->stream != NULL) {
+		return data->stream->outputValues + ((size_t)sample * data->numOutputs);
+	}
+
+	return data->outputData[sample];
+}
+
+
+/*
+	returns the given output of the given sample of the given dataSet
+*/
+DLL_EXPORT double getDataSetSampleOutput(struct dataSet *data, int sample, int output) {
+	return getDataSetSampleOutputs(data, sample)[output];
+}
+
+
+/*
+	returns the inputs of the given dataSet stored column by column i.e.
+	input j of sample i is at [(j * numSamples) + i]. The columns are built
+	on the first call and kept until the samples are reordered or freed.
+
+	Runs sharing a dataSet may call this at the same time, and
+	executeChromosomeBlock uses the columns as soon as they are set, so
+	they are only set once built, by one thread.
+*/
+DLL_EXPORT double *getDataSetInputColumns(struct dataSet *data) {
+
+	int i, j;
+	double *columns;
+
+	checkDataSetInMemory(data, "getDataSetInputColumns");
+
+	#pragma omp critical (dataSetColumns)
+	{
+		/* the samples of this dataSet, or of one sharing its rows, were reordered */
+		if (data->inputColumns != NULL && data->inputColumnsOrder != dataSetsOrder) {
+			freeDataSetColumns(data);
+		}
+
+		if (data->inputColumns == NULL) {
+
+			columns = alignedMalloc(data->numSamples * data->numInputs * sizeof(double));
+
+			for (i = 0; i < data->numSamples; i++) {
+				for (j = 0; j < data->numInputs; j++) {
+					columns[(j * data->numSamples) + i] = data->inputData[i][j];
+				}
+			}
+
+			data->inputColumnsOrder = dataSetsOrder;
+			data->inputColumns = columns;
+		}
+
+		columns = data->inputColumns;
+	}
+
+	return columns;
+}
+
+
+/*
+	allocates a dataSet of the given dimensions. The inputs and outputs of
+	all the samples are each stored in one aligned contiguous block and
+	inputData and outputData point to the rows of these blocks.
+*/
+static struct dataSet *allocateDataSet(int numInputs, int numOutputs, int numSamples) {
+
+	int i;
+	struct dataSet *data;
+
+	data = (struct dataSet*)malloc(sizeof(struct dataSet));
+
+	data->numInputs = numInputs;
+	data->numOutputs = numOutputs;
+	data->numSamples = numSamples;
+
+	data->inputBlock = alignedMalloc(numSamples * numInputs * sizeof(double));
+	data->outputBlock = alignedMalloc(numSamples * numOutputs * sizeof(double));
+	data->inputColumns = NULL;
+	data->inputColumnsOrder = 0;
+	data->offloadMapped = 0;
+	data->id = getNewDataSetId();
+	data->stream = NULL;
+
+	data->inputData = (double**)malloc(numSamples * sizeof(double*));
+	data->outputData = (double**)malloc(numSamples * sizeof(double*));
+
+	for (i = 0; i < numSamples; i++) {
+		data->inputData[i] = data->inputBlock + (i * numInputs);
+		data->outputData[i] = data->outputBlock + (i * numOutputs);
+	}
+
+	return data;
+}
+
+
+/*
+	allocates a dataSet view of the given dimensions. Only the row
+	pointers are allocated, which are set to the rows of other dataSets.
+*/
+static struct dataSet *allocateDataSetView(int numInputs, int numOutputs, int numSamples) {
+
+	struct dataSet *view;
+
+	view = (struct dataSet*)malloc(sizeof(struct dataSet));
+
+	view->numInputs = numInputs;
+	view->numOutputs = numOutputs;
+	view->numSamples = numSamples;
+
+	view->inputBlock = NULL;
+	view->outputBlock = NULL;
+	view->inputColumns = NULL;
+	view->inputColumnsOrder = 0;
+	view->offloadMapped = 0;
+	view->id = getNewDataSetId();
+	view->stream = NULL;
+
+	view->inputData = (double**)malloc(numSamples * sizeof(double*));
+	view->outputData = (double**)malloc(numSamples * sizeof(double*));
+
+	return view;
+}
+
+
+/*
+	copies the samples of the given source dataSet to those of the
+	destination dataSet from firstSample. The rows are copied one at a
+	time as the source may be a view whose rows are not contiguous.
+*/
+static void copyDataSetSamples(struct dataSet *dataDest, int firstSample, struct dataSet *dataSrc) {
+
+	int i;
+
+	for (i = 0; i < dataSrc->numSamples; i++) {
+		memcpy(dataDest->inputData[firstSample + i], dataSrc->inputData[i], dataSrc->numInputs * sizeof(double));
+		memcpy(dataDest->outputData[firstSample + i], dataSrc->outputData[i], dataSrc->numOutputs * sizeof(double));
+	}
+}
+
+
+/*
+	returns an id not yet given to any dataSet
+*/
+static unsigned long getNewDataSetId(void) {
+	return getNewDataSetIds(1);
+}
+
+
+/*
+	returns the first of numIds consecutive ids not yet given to any dataSet
+*/
+static unsigned long getNewDataSetIds(int numIds) {
+
+	static unsigned long numDataSetIds = 0;
+	unsigned long id;
+
+	#pragma omp atomic capture
+	{ id = numDataSetIds; numDataSetIds += numIds; }
+
+	return id + 1;
+}
+
+
+/*
+	frees the column copy of the inputs of the given dataSet if built
+*/
+static void freeDataSetColumns(struct dataSet *data) {
+
+	if (data->offloadMapped == 1) {
+		#pragma omp target exit data map(delete: data->inputColumns[0:data->numInputs * data->numSamples])
+		data->offloadMapped = 0;
+	}
+
+	alignedFree(data->inputColumns);
+	data->inputColumns = NULL;
+}
+
+
+/*
+	allocates memory aligned to DATASETALIGNMENT bytes
+*/
+static double *alignedMalloc(size_t size) {
+
+	/* aligned_alloc requires the size to be a multiple of the alignment */
+	size = ((size / DATASETALIGNMENT) + 1) * DATASETALIGNMENT;
+
+#if defined(_WIN32)
+	return (double*)_aligned_malloc(size, DATASETALIGNMENT);
+#else
+	return (double*)aligned_alloc(DATASETALIGNMENT, size);
+#endif
+}
+
+
+/*
+	frees memory allocated by alignedMalloc
+*/
+static void alignedFree(double *ptr) {
+
+#if defined(_WIN32)
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+
+
+/*
+	Results Functions
+*/
+
+
+/*
+	initialises a results structure
+*/
+struct results* initialiseResults(struct parameters *params, int numRuns) {
+
+	struct results *rels;
+
+	rels = (struct results*)malloc(sizeof(struct results));
+	rels->bestChromosomes = (struct chromosome**)malloc(numRuns * sizeof(struct chromosome*));
+
+	rels->numRuns = numRuns;
+
+	/*
+		Initialised chromosomes are returns from runCGP and stored in a results structure.
+		Therefore they should not be initialised here.
+	*/
+
+	return rels;
+}
+
+
+/*
+	free an initialised results structure
+*/
+DLL_EXPORT void freeResults(struct results *rels) {
+
+	int i;
+
+	/* attempt to prevent user double freeing */
+	if (rels == NULL) {
+		printf("Warning: double freeing of results prevented.\n");
+		return;
+	}
+
+	for (i = 0; i < rels->numRuns; i++) {
+		freeChromosome(rels->bestChromosomes[i]);
+	}
+
+	free(rels->bestChromosomes);
+	free(rels);
+}
+
+
+/*
+	saves results structure to file
+*/
+DLL_EXPORT void saveResults(struct results *rels, char const *fileName, unsigned int * seed) {
+
+	FILE *fp;
+	int i;
+
+	struct chromosome *chromoTemp;
+
+	if (rels == NULL) {
+		printf("Warning: cannot save uninitialised results structure. Results not saved.\n");
+		return;
+	}
+
+	fp = fopen(fileName, "w");
+
+	if (fp == NULL) {
+		printf("Warning: cannot open '%s' and so cannot save results to that file. Results not saved.\n", fileName);
+		return;
+	}
+
+	fprintf(fp, "Run,Fitness,Generations,Active Nodes\n");
+
+	for (i = 0; i < rels->numRuns; i++) {
+
+		chromoTemp = getChromosome(rels, i, seed);
+
+		fprintf(fp, "%d,%f,%d,%d\n", i, chromoTemp->fitness, chromoTemp->generation, chromoTemp->numActiveNodes);
+
+		freeChromosome(chromoTemp);
+	}
+
+	fclose(fp);
+}
+
+
+/*
+	Gets the number of chromosomes in the results structure
+*/
+DLL_EXPORT int getNumChromosomes(struct results *rels) {
+	return rels->numRuns;
+}
+
+
+/*
+	returns the average number of chromosome active nodes from repeated
+	run results specified in rels.
+*/
+DLL_EXPORT double getAverageActiveNodes(struct results *rels) {
+
+	int i;
+	double avgActiveNodes = 0;
+	struct chromosome *chromoTemp;
+
+	for (i = 0; i < getNumChromosomes(rels); i++) {
+
+		chromoTemp = rels->bestChromosomes[i];
+
+		avgActiveNodes += getNumChromosomeActiveNodes(chromoTemp);
+	}
+
+	avgActiveNodes = avgActiveNodes / getNumChromosomes(rels);
+
+	return avgActiveNodes;
+}
+
+
+/*
+	returns the median number of chromosome active nodes from repeated
+	run results specified in rels.
+*/
+DLL_EXPORT double getMedianActiveNodes(struct results *rels) {
+
+	int i;
+	double medActiveNodes = 0;
+
+	int *array = (int*)malloc(getNumChromosomes(rels) * sizeof(int));
+
+	for (i = 0; i < getNumChromosomes(rels); i++) {
+		array[i] = getNumChromosomeActiveNodes(rels->bestChromosomes[i]);
+	}
+
+	medActiveNodes = medianInt(array, getNumChromosomes(rels));
+
+	free(array);
+
+	return medActiveNodes;
+}
+
+
+static double medianInt(const int *anArray, const int length) {
+
+	int i;
+	int *copyArray = (int*)malloc(length * sizeof(int));
+	double median;
+
+	/* make a copy of the array */
+	for (i = 0; i < length; i++) {
+		copyArray[i] = anArray[i];
+	}
+
+	/* sort the copy array */
+	sortIntArray(copyArray, length);
+
+	/* if even */
+	if (length % 2 == 0) {
+		median = (copyArray[(length / 2)] + copyArray[(length / 2) - 1] ) / 2;
+	}
+
+	/* if odd */
+	else {
+		median = copyArray[ (length - 1) / 2];
+	}
+
+	free(copyArray);
+
+	return median;
+}
+
+static double medianDouble(const double *anArray, const int length) {
+
+	int i;
+	double *copyArray = (double*)malloc(length * sizeof(double));
+	double median;
+
+	/* make a copy of the array */
+	for (i = 0; i < length; i++) {
+		copyArray[i] = anArray[i];
+	}
+
+	/* sort the copy array */
+	sortDoubleArray(copyArray, length);
+
+	/* if even */
+	if (length % 2 == 0) {
+		median = (copyArray[(length / 2)] + copyArray[(length / 2) - 1] ) / 2;
+	}
+
+	/* if odd */
+	else {
+		median = copyArray[ (length - 1) / 2];
+	}
+
+	free(copyArray);
+
+	return median;
+}
+
+
+
+/*
+	returns the average chromosome fitness from repeated
+	run results specified in rels.
+*/
+DLL_EXPORT double getAverageFitness(struct results *rels) {
+
+	int i;
+	double avgFit = 0;
+	struct chromosome *chromoTemp;
+
+
+	for (i = 0; i < getNumChromosomes(rels); i++) {
+
+		chromoTemp = rels->bestChromosomes[i];
+
+		avgFit += getChromosomeFitness(chromoTemp);
+	}
+
+	avgFit = avgFit / getNumChromosomes(rels);
+
+	return avgFit;
+}
+
+
+/*
+	returns the median chromosome fitness from repeated
+	run results specified in rels.
+*/
+DLL_EXPORT double getMedianFitness(struct results *rels) {
+
+	int i;
+	double med = 0;
+
+	double *array = (double*)malloc(getNumChromosomes(rels) * sizeof(double));
+
+	for (i = 0; i < getNumChromosomes(rels); i++) {
+		array[i] = getChromosomeFitness(rels->bestChromosomes[i]);
+	}
+
+	med = medianDouble(array, getNumChromosomes(rels));
+
+	free(array);
+
+	return med;
+}
+
+
+
+/*
+	returns the average number of generations used by each run  specified in rels.
+*/
+DLL_EXPORT double getAverageGenerations(struct results *rels) {
+
+	int i;
+	double avgGens = 0;
+	struct chromosome *chromoTemp;
+
+	for (i = 0; i < getNumChromosomes(rels); i++) {
+
+		chromoTemp = rels->bestChromosomes[i];
+
+		avgGens += getChromosomeGenerations(chromoTemp);
+	}
+
+	avgGens = avgGens / getNumChromosomes(rels);
+
+	return avgGens;
+}
+
+
+/*
+	returns the median number of generations used by each run  specified in rels.
+*/
+DLL_EXPORT double getMedianGenerations(struct results *rels) {
+
+	int i;
+	double med = 0;
+
+	int *array = (int*)malloc(getNumChromosomes(rels) * sizeof(int));
+
+	for (i = 0; i < getNumChromosomes(rels); i++) {
+		array[i] = getChromosomeGenerations(rels->bestChromosomes[i]);
+	}
+
+	med = medianInt(array, getNumChromosomes(rels));
+
+	free(array);
+
+	return med;
+}
+
+
+
+/*
+	returns a pointer to a copy of the best chromosomes found on the given run in rels.
+*/
+DLL_EXPORT struct chromosome* getChromosome(struct results *rels, int run, unsigned int * seed) {
+
+	struct chromosome *chromo;
+
+	/* do some error checking */
+	if (rels == NULL) {
+		printf("Error: cannot get best chromosome from uninitialised results.\nTerminating CGP-Library.\n");
+		exit(0);
+	}
+
+	chromo = initialiseChromosomeFromChromosome(rels->bestChromosomes[run], seed);
+
+	return chromo;
+}
+
+
+/*
+	Profile Functions
+*/
+
+
+/*
+	Initialises a profile with every counter and time zero
+*/
+DLL_EXPORT struct profile *initialiseProfile(void) {
+
+	struct profile *prof;
+
+	prof = (struct profile*)malloc(sizeof(struct profile));
+
+	resetProfile(prof);
+
+	return prof;
+}
+
+
+/*
+	frees an initialised profile
+*/
+DLL_EXPORT void freeProfile(struct profile *prof) {
+
+	/* attempt to prevent user double freeing */
+	if (prof == NULL) {
+		printf("Warning: double freeing of profile prevented.\n");
+		return;
+	}
+
+	free(prof);
+}
+
+
+/*
+	sets every counter and time of the given profile to zero
+*/
+DLL_EXPORT void resetProfile(struct profile *prof) {
+
+	int i;
+
+	prof->fitnessEvaluations = 0;
+	prof->samplesExecuted = 0;
+	prof->activeNodes = 0;
+	prof->activeNodesUpdates = 0;
+	prof->copies = 0;
+	prof->mutations = 0;
+	prof->DETrials = 0;
+	prof->DETrialsAccepted = 0;
+
+	for (i = 0; i < PROFILENUMPHASES; i++) {
+		prof->times[i] = 0;
+	}
+}
+
+
+/*
+	sets the profile in which the chromosomes initialised from the given
+	parameters, and the algorithms run with them, count their work. NULL
+	stops the counting.
+*/
+DLL_EXPORT void setProfile(struct parameters *params, struct profile *prof) {
+
+	params->profile = prof;
+}
+
+
+/*
+	sets the function called with the profile every logInterval generations
+	of runCGP, runCGPDE_IN and runCGPDE_OUT. NULL stops the logging.
+*/
+DLL_EXPORT void setProfileLog(struct parameters *params, int logInterval, void (*profileLog)(struct parameters *params, struct profile *prof, int generation)) {
+
+	if (profileLog != NULL && logInterval < 1) {
+		printf("Warning: the profile log interval must be > 0; %d is invalid. The profile log is left unchanged.\n", logInterval);
+		return;
+	}
+
+	params->profileLog = profileLog;
+	params->profileLogInterval = logInterval;
+}
+
+
+/*
+	prints every counter and time of the given profile
+*/
+DLL_EXPORT void printProfile(struct profile *prof) {
+
+	int i;
+
+	if (prof == NULL) {
+		printf("Error: cannot print uninitialised profile.\nTerminating CGP-Library.\n");
+		exit(0);
+	}
+
+	printf("-----------------------------------------------------------\n");
+	printf("                       Profile                             \n");
+	printf("-----------------------------------------------------------\n");
+	printf("Fitness Evaluations:\t\t\t%lu\n", prof->fitnessEvaluations);
+	printf("Samples Executed:\t\t\t%lu\n", prof->samplesExecuted);
+	printf("Average Active Nodes:\t\t\t%f\n", getProfileAverageActiveNodes(prof));
+	printf("Active Nodes Updates:\t\t\t%lu\n", prof->activeNodesUpdates);
+	printf("Copies:\t\t\t\t\t%lu\n", prof->copies);
+	printf("Mutations:\t\t\t\t%lu\n", prof->mutations);
+	printf("DE Trials:\t\t\t\t%lu\n", prof->DETrials);
+	printf("DE Trials Accepted:\t\t\t%lu\n", prof->DETrialsAccepted);
+
+	for (i = 0; i < PROFILENUMPHASES; i++) {
+		printf("Time %s:%s%f s\n", profilePhaseNames[i], strlen(profilePhaseNames[i]) < 10 ? "\t\t\t\t" : "\t\t\t", prof->times[i]);
+	}
+
+	printf("-----------------------------------------------------------\n\n");
+}
+
+
+/*
+	returns the number of fitness evaluations counted in the given profile
+*/
+DLL_EXPORT unsigned long getProfileFitnessEvaluations(struct profile *prof) {
+	return prof->fitnessEvaluations;
+}
+
+
+/*
+	returns the number of samples executed counted in the given profile
+*/
+DLL_EXPORT unsigned long getProfileSamplesExecuted(struct profile *prof) {
+	return prof->samplesExecuted;
+}
+
+
+/*
+	returns the average number of active nodes of the chromosomes evaluated
+*/
+DLL_EXPORT double getProfileAverageActiveNodes(struct profile *prof) {
+
+	if (prof->fitnessEvaluations == 0) {
+		return 0;
+	}
+
+	return (double)prof->activeNodes / prof->fitnessEvaluations;
+}
+
+
+/*
+	returns the number of times the active nodes were found again
+*/
+DLL_EXPORT unsigned long getProfileActiveNodesUpdates(struct profile *prof) {
+	return prof->activeNodesUpdates;
+}
+
+
+/*
+	returns the number of chromosome copies counted in the given profile
+*/
+DLL_EXPORT unsigned long getProfileCopies(struct profile *prof) {
+	return prof->copies;
+}
+
+
+/*
+	returns the number of mutations counted in the given profile
+*/
+DLL_EXPORT unsigned long getProfileMutations(struct profile *prof) {
+	return prof->mutations;
+}
+
+
+/*
+	returns the number of DE trial vectors evaluated
+*/
+DLL_EXPORT unsigned long getProfileDETrials(struct profile *prof) {
+	return prof->DETrials;
+}
+
+
+/*
+	returns the number of DE trial vectors which replaced their target
+*/
+DLL_EXPORT unsigned long getProfileDETrialsAccepted(struct profile *prof) {
+	return prof->DETrialsAccepted;
+}
+
+
+/*
+	returns the seconds spent in the given phase, summed over the threads
+*/
+DLL_EXPORT double getProfileTime(struct profile *prof, char const *phase) {
+
+	int i;
+
+	for (i = 0; i < PROFILENUMPHASES; i++) {
+		if (strcmp(phase, profilePhaseNames[i]) == 0) {
+			return prof->times[i];
+		}
+	}
+
+	printf("Warning: the profile phase '%s' is not known. The known phases are evaluation, activeNodes, copy, mutation and DE.\n", phase);
+	return 0;
+}
+
+
+/*
+	returns a time in seconds from which the time of a phase is measured
+*/
+static double getProfileClock(void) {
+
+#if !defined(_WIN32)
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return now.tv_sec + (now.tv_nsec * 1e-9);
+#else
+	return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+
+/*
+	adds the time since start to the given phase of the given profile
+*/
+static void addProfileTime(struct profile *prof, int phase, double start) {
+
+	double elapsed = getProfileClock() - start;
+
+	#pragma omp atomic
+	prof->times[phase] += elapsed;
+}
+
+
+/*
+	adds n to the given counter of a profile, which may be shared by threads
+*/
+static void addProfileCount(unsigned long *counter, unsigned long n) {
+
+	#pragma omp atomic
+	*counter += n;
+}
+
+
+/*
+	counts the fitness evaluation of the given chromosome started at start
+*/
+static void addProfileEvaluation(struct profile *prof, struct chromosome *chromo, double start) {
+
+	addProfileCount(&prof->fitnessEvaluations, 1);
+	addProfileCount(&prof->activeNodes, chromo->numActiveNodes);
+	addProfileTime(prof, PROFILEEVALUATION, start);
+}
+
+
+/*
+	calls the profile log of the given parameters if the given number of
+	generations is a multiple of its interval
+*/
+static void logProfile(struct parameters *params, int generation) {
+
+	if (params->profile != NULL && params->profileLog != NULL && generation % params->profileLogInterval == 0) {
+		params->profileLog(params, params->profile, generation);
+	}
+}
+
+
+/*
+	Mutation Methods
+*/
+
+
+/*
+	Conductions point mutation on the give chromosome. A predetermined
+	number of chromosome genes are randomly selected and changed to
+	a random valid allele. The number of mutations is the number of chromosome
+	genes multiplied by the mutation rate. Each gene has equal probability
+	of being selected.
+
+	DO NOT USE WITH ANN
+*/
+static void pointMutation(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed) {
+
+	int i;
+	int numGenes;
+	int numFunctionGenes, numInputGenes, numOutputGenes;
+	int numGenesToMutate;
+	int geneToMutate;
+	int nodeIndex;
+	int nodeInputIndex;
+
+	/* get the number of each type of gene */
+	numFunctionGenes = params->numNodes;
+	numInputGenes = params->numNodes * params->arity;
+	numOutputGenes = params->numOutputs;
+
+	/* set the total number of chromosome genes */
+	numGenes = numFunctionGenes + numInputGenes + numOutputGenes;
+
+	/* calculate the number of genes to mutate */
+	numGenesToMutate = (int)roundf(numGenes * params->mutationRate);
+
+	/* for the number of genes to mutate */
+	for (i = 0; i < numGenesToMutate; i++) {
+
+		/* select a random gene */
+		geneToMutate = randInt(numGenes, seed);
+
+		/* mutate function gene */
+		if (geneToMutate < numFunctionGenes) {
+
+			nodeIndex = geneToMutate;
+
+			chromo->nodes[nodeIndex]->function = getRandomFunction(chromo->funcSet->numFunctions, seed);
+			setNodeCacheDirty(chromo, nodeIndex);
+		}
+
+		/* mutate node input gene */
+		else if (geneToMutate < numFunctionGenes + numInputGenes) {
+
+			nodeIndex = (int) ((geneToMutate - numFunctionGenes) / chromo->arity);
+			nodeInputIndex = (geneToMutate - numFunctionGenes) % chromo->arity;
+
+			chromo->nodes[nodeIndex]->inputs[nodeInputIndex] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, nodeIndex, params->recurrentConnectionProbability, seed);
+			setNodeCacheDirty(chromo, nodeIndex);
+		}
+
+		/* mutate output gene */
+		else {
+			nodeIndex = geneToMutate - numFunctionGenes - numInputGenes;
+			chromo->outputNodes[nodeIndex] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections, seed);
+		}
+	}
+}
+
+
+/*
+	Same as pointMutation but also mutates weight genes. The reason this is separated is
+	that point mutation should always mutate the same number of genes. When weight genes are not
+	used many mutations will not do anything and so the number of actual mutations varies.
+
+	>>> However, in this case, only the mutation applied to the active nodes are counted!
+*/
+static void pointMutationANN(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed) 
+{
+	int numGenes;
+	int numFunctionGenes, numInputGenes, numWeightGenes, numOutputGenes;
+	int numGenesToMutate;
+	int geneToMutate;
+	int nodeIndex;
+	int nodeInputIndex;
+	int counter = 0;
+
+	/* get the number of each type of gene */
+	numFunctionGenes = params->numNodes;
+	numInputGenes = params->numNodes * params->arity;
+	numWeightGenes = params->numNodes * params->arity;
+	numOutputGenes = params->numOutputs;
+
+	/* set the total number of chromosome genes */
+	numGenes = numFunctionGenes + numInputGenes + numWeightGenes + numOutputGenes;
+
+	/* calculate the number of genes to mutate */
+	numGenesToMutate = (int)roundf(numGenes * params->mutationRate);
+
+	/* for the number of genes to mutate */
+	while(counter < numGenesToMutate)
+	{
+		/* select a random gene */
+		geneToMutate = randInt(numGenes, seed);
+
+		/* mutate function gene */
+		if (geneToMutate < numFunctionGenes) 
+		{
+			nodeIndex = geneToMutate;
+
+			if(chromo->nodes[nodeIndex]->active == 1)
+			{
+				counter++;
+			}
+
+			chromo->nodes[nodeIndex]->function = getRandomFunction(chromo->funcSet->numFunctions, seed);
+			setNodeCacheDirty(chromo, nodeIndex);
+		}
+
+		/* mutate node input gene */
+		else if (geneToMutate < numFunctionGenes + numInputGenes) 
+		{
+			nodeIndex = (int) ((geneToMutate - numFunctionGenes) / chromo->arity);
+			nodeInputIndex = (geneToMutate - numFunctionGenes) % chromo->arity;
+
+			if(chromo->nodes[nodeIndex]->active == 1)
+			{
+				counter++;
+			}
+
+			chromo->nodes[nodeIndex]->inputs[nodeInputIndex] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, nodeIndex, params->recurrentConnectionProbability, seed);
+			setNodeCacheDirty(chromo, nodeIndex);
+		}
+
+		/* mutate connection weight */
+		else if (geneToMutate < numFunctionGenes + numInputGenes + numWeightGenes) 
+		{
+			nodeIndex = (int) ((geneToMutate - numFunctionGenes - numInputGenes) / chromo->arity);
+			nodeInputIndex = (geneToMutate - numFunctionGenes - numInputGenes) % chromo->arity;
+
+			if(chromo->nodes[nodeIndex]->active == 1)
+			{
+				counter++;
+			}
+
+			chromo->nodes[nodeIndex]->weights[nodeInputIndex] = getRandomConnectionWeight(params->connectionWeightRange, seed);
+			setNodeCacheDirty(chromo, nodeIndex);
+		}
+
+		/* mutate output gene */
+		else 
+		{
+			nodeIndex = geneToMutate - numFunctionGenes - numInputGenes - numWeightGenes;
+			counter++;
+			chromo->outputNodes[nodeIndex] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections, seed);
+		}
+	}
+}
+
+
+
+/*
+	Conductions a single active mutation on the give chromosome.
+
+	DO NOT USE WITH ANN
+*/
+static void singleMutation(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed) {
+
+	int numFunctionGenes, numInputGenes, numOutputGenes;
+	int numGenes;
+	int geneToMutate;
+	int nodeIndex;
+	int nodeInputIndex;
+
+	int mutatedActive = 0;
+	int previousGeneValue;
+	int newGeneValue;
+
+	/* get the number of each type of gene */
+	numFunctionGenes = params->numNodes;
+	numInputGenes = params->numNodes * params->arity;
+	numOutputGenes = params->numOutputs;
+
+	/* set the total number of chromosome genes */
+	numGenes = numFunctionGenes + numInputGenes + numOutputGenes;
+
+	/* while active gene not mutated */
+	while (mutatedActive == 0) {
+
+		/* select a random gene */
+		geneToMutate = randInt(numGenes, seed);
+
+		/* mutate function gene */
+		if (geneToMutate < numFunctionGenes) {
+
+			nodeIndex = geneToMutate;
+
+			previousGeneValue = chromo->nodes[nodeIndex]->function;
+
+			chromo->nodes[nodeIndex]->function = getRandomFunction(chromo->funcSet->numFunctions, seed);
+			setNodeCacheDirty(chromo, nodeIndex);
+
+			newGeneValue = chromo->nodes[nodeIndex]->function;
+
+			if ((previousGeneValue != newGeneValue) && (chromo->nodes[nodeIndex]->active == 1)) {
+				mutatedActive = 1;
+			}
+
+		}
+
+		/* mutate node input gene */
+		else if (geneToMutate < numFunctionGenes + numInputGenes) {
+
+			nodeIndex = (int) ((geneToMutate - numFunctionGenes) / chromo->arity);
+			nodeInputIndex = (geneToMutate - numFunctionGenes) % chromo->arity;
+
+			previousGeneValue = chromo->nodes[nodeIndex]->inputs[nodeInputIndex];
+
+			chromo->nodes[nodeIndex]->inputs[nodeInputIndex] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, nodeIndex, params->recurrentConnectionProbability, seed);
+			setNodeCacheDirty(chromo, nodeIndex);
+
+			newGeneValue = chromo->nodes[nodeIndex]->inputs[nodeInputIndex];
+
+			if ((previousGeneValue != newGeneValue) && (chromo->nodes[nodeIndex]->active == 1)) {
+				mutatedActive = 1;
+			}
+		}
+
+		/* mutate output gene */
+		else {
+			nodeIndex = geneToMutate - numFunctionGenes - numInputGenes;
+
+			previousGeneValue = chromo->outputNodes[nodeIndex];
+
+			chromo->outputNodes[nodeIndex] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections, seed);
+
+			newGeneValue = chromo->outputNodes[nodeIndex];
+
+			if (previousGeneValue != newGeneValue) {
+				mutatedActive = 1;
+			}
+		}
+	}
+}
+
+
+/*
+	Conductions probabilistic mutation on the given chromosome. Each chromosome
+	gene is changed to a random valid allele with a probability specified in
+	parameters.
+	If CGPANN, the weights are also mutated.
+*/
+static void probabilisticMutation(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed) {
+
+	int i, j;
+
+	/* the draws of rand_r are kept so that its results are those of earlier versions */
+	if (randomNumberGenerator != RANDOMGENERATORRANDR) {
+		probabilisticMutationSkip(params, chromo, type, seed);
+		return;
+	}
+
+	/* for every nodes in the chromosome */
+	for (i = 0; i < params->numNodes; i++) 
+	{
+		/* mutate the function gene */
+		if (chromo->funcSet->numFunctions > 1 && randDecimal(seed) <= params->mutationRate) {
+			chromo->nodes[i]->function = getRandomFunction(chromo->funcSet->numFunctions, seed);
+			setNodeCacheDirty(chromo, i);
+		}
+
+		/* for every input to each chromosome */
+		for (j = 0; j < params->arity; j++) {
+
+			/* mutate the node input */
+			if (randDecimal(seed) <= params->mutationRate) {
+				chromo->nodes[i]->inputs[j] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, i, params->recurrentConnectionProbability, seed);
+				setNodeCacheDirty(chromo, i);
+			}
+
+			/* mutate the node connection weight (IF CGPANN -> type = 0) */
+			if (type == 0 && randDecimal(seed) <= params->mutationRate) {
+				chromo->nodes[i]->weights[j] = getRandomConnectionWeight(params->connectionWeightRange, seed);
+				setNodeCacheDirty(chromo, i);
+			}
+		}
+	}
+
+	/* for every chromosome output */
+	for (i = 0; i < params->numOutputs; i++) {
+
+		/* mutate the chromosome output */
+		if (randDecimal(seed) <= params->mutationRate) {
+			chromo->outputNodes[i] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections, seed);
+		}
+	}
+}
+
+/*
+	Probabilistic mutation drawing the number of genes skipped before the
+	next mutated gene rather than one random number for every gene. The
+	genes are taken in the order of probabilisticMutation, each being
+	mutated with the probability given in parameters.
+*/
+static void probabilisticMutationSkip(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed) {
+
+	int i, j;
+	int gene, nodeGene;
+	int functionGenes = (chromo->funcSet->numFunctions > 1) ? 1 : 0;
+	int connectionGenes = (type == 0) ? 2 : 1;
+	int nodeGenes = functionGenes + (params->arity * connectionGenes);
+	int numGenes = (params->numNodes * nodeGenes) + params->numOutputs;
+
+	for (gene = getRandomGeneSkip(params->mutationRate, numGenes, seed); gene < numGenes; gene += 1 + getRandomGeneSkip(params->mutationRate, numGenes - gene, seed)) {
+
+		/* mutate the chromosome output */
+		if (gene >= params->numNodes * nodeGenes) {
+			i = gene - (params->numNodes * nodeGenes);
+			chromo->outputNodes[i] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections, seed);
+			continue;
+		}
+
+		i = gene / nodeGenes;
+		nodeGene = (gene % nodeGenes) - functionGenes;
+
+		/* mutate the function gene */
+		if (nodeGene < 0) {
+			chromo->nodes[i]->function = getRandomFunction(chromo->funcSet->numFunctions, seed);
+		}
+
+		/* mutate the node input */
+		else if (nodeGene % connectionGenes == 0) {
+			j = nodeGene / connectionGenes;
+			chromo->nodes[i]->inputs[j] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, i, params->recurrentConnectionProbability, seed);
+		}
+
+		/* mutate the node connection weight (IF CGPANN -> type = 0) */
+		else {
+			j = nodeGene / connectionGenes;
+			chromo->nodes[i]->weights[j] = getRandomConnectionWeight(params->connectionWeightRange, seed);
+		}
+
+		setNodeCacheDirty(chromo, i);
+	}
+}
+
+/*
+	Conductions probabilistic mutation on the active nodes in the given
+	chromosome. Each chromosome gene is changed to a random valid allele
+	with a probability specified in parameters.
+	If CGPANN, the weights are also mutated.
+*/
+static void probabilisticMutationOnlyActive(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed) {
+
+	int i, j;
+	int activeNode;
+
+	/* for every active node in the chromosome */
+	for (i = 0; i < chromo->numActiveNodes; i++) {
+
+		activeNode = chromo->activeNodes[i];
+
+		/* mutate the function gene */
+		if (randDecimal(seed) <= params->mutationRate) {
+			chromo->nodes[activeNode]->function = getRandomFunction(chromo->funcSet->numFunctions, seed);
+			setNodeCacheDirty(chromo, activeNode);
+		}
+
+		/* for every input to each chromosome */
+		for (j = 0; j < params->arity; j++) {
+
+			/* mutate the node input */
+			if (randDecimal(seed) <= params->mutationRate) {
+				chromo->nodes[activeNode]->inputs[j] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, activeNode, params->recurrentConnectionProbability, seed);
+				setNodeCacheDirty(chromo, activeNode);
+			}
+
+			/* mutate the node connection weight (IF CGPANN -> type = 0) */
+			if (type == 0 && randDecimal(seed) <= params->mutationRate) {
+				chromo->nodes[activeNode]->weights[j] = getRandomConnectionWeight(params->connectionWeightRange, seed);
+				setNodeCacheDirty(chromo, activeNode);
+			}
+		}
+	}
+
+	/* for every chromosome output */
+	for (i = 0; i < params->numOutputs; i++) {
+
+		/* mutate the chromosome output */
+		if (randDecimal(seed) <= params->mutationRate) {
+			chromo->outputNodes[i] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections, seed);
+		}
+	}
+}
+
+
+/*
+	Sets the random number seed
+*/
+DLL_EXPORT void setRandomNumberSeed(unsigned int seed) {
+	srand(seed);
+}
+
+
+/*
+	sets the generator of the random numbers drawn from the seeds given to
+	CGP-Library. rand_r keeps the draws of earlier versions and pcg draws
+	from a permuted congruential generator of the same 32 bit state.
+*/
+DLL_EXPORT void setRandomNumberGenerator(char const *generator) {
+
+	if (strcmp(generator, "rand_r") == 0) {
+		randomNumberGenerator = RANDOMGENERATORRANDR;
+	}
+
+	else if (strcmp(generator, "pcg") == 0) {
+		randomNumberGenerator = RANDOMGENERATORPCG;
+	}
+
+	else {
+		printf("Warning: random number generator '%s' is invalid. The random number generator must be 'rand_r' or 'pcg'. The random number generator has been left unchanged as '%s'.\n", generator, randomNumberGenerator == RANDOMGENERATORRANDR ? "rand_r" : "pcg");
+	}
+}
+
+
+
+/*
+	Classification Methods
+*/
+
+
+
+/*
+	CGPANN Algorithm
+*/
+
+DLL_EXPORT struct chromosome* runCGP(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, unsigned int * seed) 
+{
+	return runCGPFromCheckpoint(params, dataTrain, dataValid, numGens, NULL, seed);
+}
+
+/*
+	CGPANN Algorithm continued from the checkpoint saved by runCGP
+*/
+
+DLL_EXPORT struct chromosome* resumeCGP(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, char const *checkpointFile, unsigned int * seed)
+{
+	return runCGPFromCheckpoint(params, dataTrain, dataValid, numGens, checkpointFile, seed);
+}
+
+/*
+	runCGP, starting from the given checkpoint file unless it is NULL
+*/
+
+static struct chromosome* runCGPFromCheckpoint(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, char const *checkpointFile, unsigned int * seed)
+{
+	int i;
+	int gen;
+	int firstGen = 0;
+
+	/* the stopping policies of the run */
+	struct stoppingState stopping;
+	int stopped = 0;
+
+	/* bestChromo found using runCGP */
+	struct chromosome *bestChromo;
+
+	/* arrays of the parents and children */
+	struct chromosome **parentChromos;
+	struct chromosome **childrenChromos;
+
+	/* storage for chromosomes used by selection scheme */
+	struct chromosome **candidateChromos;
+	struct chromosome **rankedChromos;
+	int numCandidateChromos;
+
+	/* the training samples of each generation */
+	struct miniBatches *batches;
+	struct dataSet *batchTrain;
+
+	/* error checking */
+	if (numGens < 0) {
+		printf("Error: %d generations is invalid. The number of generations must be >= 0.\n Terminating CGP-Library.\n", numGens);
+		exit(0);
+	}
+
+	if (dataTrain != NULL && params->numInputs != dataTrain->numInputs) {
+		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", dataTrain->numInputs, params->numInputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (dataTrain != NULL && params->numOutputs != dataTrain->numOutputs) {
+		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", dataTrain->numOutputs, params->numOutputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (dataValid != NULL && params->numInputs != dataValid->numInputs) {
+		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", dataValid->numInputs, params->numInputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (dataValid != NULL && params->numOutputs != dataValid->numOutputs) {
+		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", dataValid->numOutputs, params->numOutputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	/* initialise parent chromosomes */
+	parentChromos = (struct chromosome**)malloc(params->mu * sizeof(struct chromosome*));
+
+	for (i = 0; i < params->mu; i++) {
+		parentChromos[i] = initialiseChromosome(params, seed);
+	}
+
+	/* initialise children chromosomes */
+	childrenChromos = (struct chromosome**)malloc(params->lambda * sizeof(struct chromosome*));
+
+	for (i = 0; i < params->lambda; i++) {
+		childrenChromos[i] = initialiseChromosome(params, seed);
+	}
+
+	/* initialise best chromosome */
+	bestChromo = initialiseChromosomeFromChromosome(parentChromos[0], seed);
+	setChromosomeFitnessValidation(params, bestChromo, dataValid);
+
+	/* determine the size of the Candidate Chromos based on the evolutionary Strategy */
+	if (params->evolutionaryStrategy == '+') {
+		numCandidateChromos = params->mu + params->lambda;
+	}
+	else if (params->evolutionaryStrategy == ',') {
+		numCandidateChromos = params->lambda;
+	}
+	else {
+		printf("Error: the evolutionary strategy '%c' is not known.\nTerminating CGP-Library.\n", params->evolutionaryStrategy);
+		exit(0);
+	}
+
+	/* initialise the candidateChromos */
+	candidateChromos = (struct chromosome**)malloc(numCandidateChromos * sizeof(struct chromosome*));
+
+	for (i = 0; i < numCandidateChromos; i++) 
+	{
+		candidateChromos[i] = initialiseChromosome(params, seed);
+	}
+
+	/* the children followed by the parents, ranked by the selection scheme */
+	rankedChromos = (struct chromosome**)malloc((params->mu + params->lambda) * sizeof(struct chromosome*));
+
+	/* the mini-batches of the training samples, NULL if they are not used */
+	batches = initialiseMiniBatches(params, dataTrain);
+
+	/* set fitness of the parents */
+	for (i = 0; i < params->mu; i++) 
+	{
+		setChromosomeFitness(params, parentChromos[i], dataTrain);
+		setChromosomeFitnessValidation(params, parentChromos[i], dataValid);
+	}
+
+	initialiseStoppingState(&stopping, bestChromo, firstGen);
+
+	/* continue from the generation and stopping state of the checkpoint */
+	if (checkpointFile != NULL)
+	{
+		firstGen = loadCGPCheckpoint(params, checkpointFile, CHECKPOINTCGP, parentChromos, childrenChromos, bestChromo, &stopping, seed);
+	}
+
+	/* for each generation, until a stopping policy is met */
+	for (gen = firstGen; gen < numGens && stopped == 0; gen++) 
+	{
+		batchTrain = getMiniBatch(params, batches, dataTrain, gen);
+
+		/* the parents were evaluated on other training samples and so are evaluated again on those of this generation */
+		if (batches != NULL)
+		{
+			setChromosomesFitness(params, parentChromos, params->mu, NULL, 0, batchTrain, dataValid, 0, DBL_MAX);
+		}
+
+		/* set fitness of the children of the population */
+		setChromosomesFitness(params, childrenChromos, params->lambda, parentChromos, params->mu, batchTrain, dataValid, 1, getChildrenFitnessCutoff(params, parentChromos));
+
+		/* get best chromosome - validation data */
+		getBestChromosome(parentChromos, childrenChromos, params->mu, params->lambda, bestChromo);
+
+		/* select the parents from the children, and from the parents if '+' */
+		selectParents(params, parentChromos, childrenChromos, candidateChromos, rankedChromos, numCandidateChromos);
+
+		/* exchange the fittest parents with the neighbouring islands */
+		if (params->migrationInterval > 0 && (gen + 1) % params->migrationInterval == 0)
+		{
+			migrateChromosomes(params, parentChromos, batchTrain, dataValid, seed);
+		}
+
+		/* create the children from the parents */
+		params->reproductionScheme(params, parentChromos, childrenChromos, params->mu, params->lambda, 0, seed); // Type 0: CGPANN (APPLY weight mutation here)
+
+		stopped = isRunStopped(params, &stopping, parentChromos, bestChromo, batchTrain, dataTrain, gen + 1);
+
+		saveCGPCheckpoint(params, CHECKPOINTCGP, gen + 1, parentChromos, childrenChromos, bestChromo, &stopping, seed);
+
+		logProfile(params, gen + 1);
+	}
+
+	bestChromo->generation = gen;
+
+	/* the best chromosome is chosen on the validation data and so its training fitness may only be a bound or that of a mini-batch */
+	if (getChildrenFitnessCutoff(params, parentChromos) != DBL_MAX || batches != NULL) {
+		setChromosomeFitness(params, bestChromo, dataTrain);
+	}
+
+	freeMiniBatches(batches);
+
+	/* free parent chromosomes */
+	for (i = 0; i < params->mu; i++) {
+		freeChromosome(parentChromos[i]);
+	}
+	free(parentChromos);
+
+	/* free children chromosomes */
+	for (i = 0; i < params->lambda; i++) {
+		freeChromosome(childrenChromos[i]);
+	}
+	free(childrenChromos);
+
+	/* free the used chromosomes and population */
+	for (i = 0; i < numCandidateChromos; i++) {
+		freeChromosome(candidateChromos[i]);
+	}
+	free(candidateChromos);
+	free(rankedChromos);
+
+	return bestChromo;
+}
+
+/*
+	Steady-state CGPANN (typeCGP = 0) or CGPDE-IN (typeCGP = 1) Algorithm.
+
+	Each of the numEvaluations children is a task of one pool of
+	params->numThreads threads. A task copies a random parent of the
+	current population, mutates and evaluates it and then replaces the
+	worst parent if it is not worse, so that no thread waits for the others.
+	In CGPDE-IN the DE of the weights of each new topology is its own task.
+*/
+DLL_EXPORT struct chromosome* runCGPSteadyState(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numEvaluations, int typeCGP, unsigned int * seed)
+{
+	int i;
+	unsigned int taskSeed;
+
+	/* bestChromo found using runCGPSteadyState */
+	struct chromosome *bestChromo;
+
+	/* the population, updated as each child is evaluated */
+	struct chromosome **parentChromos;
+
+	/* error checking */
+	if (numEvaluations < 0) {
+		printf("Error: %d evaluations is invalid. The number of evaluations must be >= 0.\n Terminating CGP-Library.\n", numEvaluations);
+		exit(0);
+	}
+
+	if (typeCGP != 0 && typeCGP != 1) {
+		printf("Error: the steady-state type must be 0 (CGPANN) or 1 (CGPDE-IN); %d is invalid.\nTerminating CGP-Library.\n", typeCGP);
+		exit(0);
+	}
+
+	if (dataTrain != NULL && (params->numInputs != dataTrain->numInputs || params->numOutputs != dataTrain->numOutputs)) {
+		printf("Error: The number of inputs and outputs specified in the dataSet (%d, %d) do not match those specified in the parameters (%d, %d).\n", dataTrain->numInputs, dataTrain->numOutputs, params->numInputs, params->numOutputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (dataValid != NULL && (params->numInputs != dataValid->numInputs || params->numOutputs != dataValid->numOutputs)) {
+		printf("Error: The number of inputs and outputs specified in the dataSet (%d, %d) do not match those specified in the parameters (%d, %d).\n", dataValid->numInputs, dataValid->numOutputs, params->numInputs, params->numOutputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	/* initialise and evaluate the parent chromosomes */
+	parentChromos = (struct chromosome**)malloc(params->mu * sizeof(struct chromosome*));
+
+	for (i = 0; i < params->mu; i++) {
+		parentChromos[i] = initialiseChromosome(params, seed);
+		setChromosomeFitness(params, parentChromos[i], dataTrain);
+		setChromosomeFitnessValidation(params, parentChromos[i], dataValid);
+	}
+
+	/* initialise best chromosome - validation data */
+	bestChromo = initialiseChromosomeFromChromosome(parentChromos[0], seed);
+	getBestChromosome(parentChromos, NULL, params->mu, 0, bestChromo);
+
+	/* one thread creates the tasks, each with its own seed, and every thread takes them in turn */
+	#pragma omp parallel default(none), private(i,taskSeed), shared(params,parentChromos,bestChromo,dataTrain,dataValid,numEvaluations,typeCGP,seed), num_threads(params->numThreads)
+	{
+		#pragma omp single
+		for (i = 0; i < numEvaluations; i++)
+		{
+			taskSeed = randSeed(seed);
+
+			#pragma omp task default(none), firstprivate(taskSeed), shared(params,parentChromos,bestChromo,dataTrain,dataValid,typeCGP)
+			runSteadyStateTask(params, parentChromos, bestChromo, dataTrain, dataValid, typeCGP, taskSeed);
+		}
+	}
+
+	/* the best chromosome is chosen on the validation data and so its training fitness may only be a bound */
+	if (params->boundedFitnessFunction != NULL) {
+		setChromosomeFitness(params, bestChromo, dataTrain);
+	}
+
+	/* free parent chromosomes */
+	for (i = 0; i < params->mu; i++) {
+		freeChromosome(parentChromos[i]);
+	}
+	free(parentChromos);
+
+	return bestChromo;
+}
+
+/*
+	creates, mutates and evaluates one child of the steady-state population.
+	The child can only replace a parent if its fitness is not greater than
+	that of the worst parent, which never increases, and so the fitness of
+	the worst parent when the child is created bounds that of the child.
+*/
+static void runSteadyStateTask(struct parameters *params, struct chromosome **parents, struct chromosome *best, struct dataSet *dataTrain, struct dataSet *dataValid, int typeCGP, unsigned int taskSeed)
+{
+	int i;
+	double cutoff = -DBL_MAX;
+	struct chromosome *parent;
+	struct chromosome *child;
+
+	#pragma omp critical (steadyStatePopulation)
+	{
+		parent = initialiseChromosomeFromChromosome(parents[randInt(params->mu, &taskSeed)], &taskSeed);
+
+		for (i = 0; i < params->mu; i++)
+		{
+			cutoff = (parents[i]->fitness > cutoff) ? parents[i]->fitness : cutoff;
+		}
+	}
+
+	child = initialiseChromosomeFromChromosome(parent, &taskSeed);
+
+	/* Type 0: CGPANN (APPLY weight mutation here), Type 1: CGPDE (do NOT apply weight mutation here) */
+	mutateChromosome(params, child, typeCGP, &taskSeed);
+
+	/* a child with the active nodes of its parent has its fitness */
+	if (params->fitnessMemoisation == 1 && compareChromosomesActiveNodesANN(child, parent) == 1)
+	{
+		child->fitness = parent->fitness;
+		child->fitnessValidation = parent->fitnessValidation;
+	}
+	else if (typeCGP == 1)
+	{
+		/* the weights of the new topology are evolved by DE as a task of the same pool */
+		#pragma omp task default(none), firstprivate(child,taskSeed), shared(params,parents,best,dataTrain,dataValid)
+		runSteadyStateDETask(params, parents, best, child, dataTrain, dataValid, taskSeed);
+
+		freeChromosome(parent);
+		return;
+	}
+	else
+	{
+		setChromosomeFitnessBounded(params, child, dataTrain, cutoff);
+		setChromosomeFitnessValidation(params, child, dataValid);
+	}
+
+	insertSteadyStateChild(params, parents, best, child);
+
+	freeChromosome(parent);
+	freeChromosome(child);
+}
+
+/*
+	evolves the weights of the given child of the steady-state CGPDE-IN
+	population with DE and then inserts the best DE individual with respect
+	to the training set into the population. The child is freed.
+*/
+static void runSteadyStateDETask(struct parameters *params, struct chromosome **parents, struct chromosome *best, struct chromosome *child, struct dataSet *dataTrain, struct dataSet *dataValid, unsigned int taskSeed)
+{
+	int i;
+	struct chromosome **populationChromos;
+	struct chromosome *bestDEChromo;
+
+	populationChromos = runDE(params, child, dataTrain, dataValid, 1, &taskSeed); // Type 1: CGPDE-IN
+	bestDEChromo = getBestDEChromosome(params, populationChromos, dataValid, 1, &taskSeed); // typeCGPDE = 1: CGPDE-IN
+
+	setChromosomeFitnessValidation(params, bestDEChromo, dataValid);
+	insertSteadyStateChild(params, parents, best, bestDEChromo);
+
+	for (i = 0; i < params->NP_IN; i++)
+	{
+		freeChromosome(populationChromos[i]);
+	}
+	free(populationChromos);
+
+	freeChromosome(bestDEChromo);
+	freeChromosome(child);
+}
+
+/*
+	replaces the worst parent of the steady-state population with the given
+	evaluated child if the child is not worse, and the best chromosome if
+	the child is not worse on the validation data
+*/
+static void insertSteadyStateChild(struct parameters *params, struct chromosome **parents, struct chromosome *best, struct chromosome *child)
+{
+	int i;
+	int worst = 0;
+
+	#pragma omp critical (steadyStatePopulation)
+	{
+		for (i = 1; i < params->mu; i++)
+		{
+			if (parents[i]->fitness > parents[worst]->fitness)
+			{
+				worst = i;
+			}
+		}
+
+		if (child->fitness <= parents[worst]->fitness)
+		{
+			copyChromosome(parents[worst], child);
+		}
+
+		if (child->fitnessValidation <= best->fitnessValidation)
+		{
+			copyChromosome(best, child);
+		}
+	}
+}
+
+/*
+	returns a pointer to the fittest chromosome in the two arrays of chromosomes
+
+	loops through parents and then the children in order for the children to always be selected over the parents
+*/
+static void getBestChromosome(struct chromosome **parents, struct chromosome **children, int numParents, int numChildren, struct chromosome *best) 
+{
+	int i;
+	int flag = 0;
+	struct chromosome *bestChromoSoFar;
+
+	bestChromoSoFar = best;
+
+	for (i = 0; i < numParents; i++) 
+	{
+		if (parents[i]->fitnessValidation <= bestChromoSoFar->fitnessValidation) 
+		{ 
+			bestChromoSoFar = parents[i];
+			flag = 1;
+		}
+	}
+
+	for (i = 0; i < numChildren; i++) 
+	{
+		if (children[i]->fitnessValidation <= bestChromoSoFar->fitnessValidation) 
+		{
+			bestChromoSoFar = children[i];
+			flag = 1;
+		}
+	}
+
+	if(flag == 1)
+	{
+		copyChromosome(best, bestChromoSoFar);
+	}
+}
+
+/*
+	sets the fitness of each of the given chromosomes, and their validation
+	fitness if validation is set, using params->numThreads threads.
+
+	Each chromosome holds its own scratch memory and the evaluations draw
+	no random numbers, so the results do not depend on the number of threads.
+
+	If fitness memoisation is set, chromosomes whose active nodes are the
+	same as those of one of the given parents take the fitness of that
+	parent instead of being evaluated.
+
+	The fitnesses greater than the cutoff are only bounds if a bounded
+	fitness function is set, DBL_MAX when every fitness must be exact.
+*/
+static void setChromosomesFitness(struct parameters *params, struct chromosome **chromos, int numChromos, struct chromosome **parents, int numParents, struct dataSet *dataTrain, struct dataSet *dataValid, int validation, double cutoff)
+{
+	int i;
+	int parent;
+	int numEvaluated = 0;
+	struct chromosome **evaluated = NULL;
+
+	/* the children which are not given the fitness of a parent are executed together on the training samples */
+	if (params->offloadEvaluation == 1)
+	{
+		evaluated = (struct chromosome**)malloc(numChromos * sizeof(struct chromosome*));
+
+		for (i = 0; i < numChromos; i++)
+		{
+			if (params->fitnessMemoisation == 0 || getIdenticalChromosome(chromos[i], parents, numParents) == -1)
+			{
+				evaluated[numEvaluated] = chromos[i];
+				numEvaluated++;
+			}
+		}
+
+		executeChromosomesOffload(params, evaluated, numEvaluated, dataTrain);
+	}
+
+	#pragma omp parallel for default(none), private(i,parent), shared(params,chromos,numChromos,parents,numParents,dataTrain,dataValid,validation,cutoff), schedule(dynamic), num_threads(params->numThreads), if(numChromos > 1)
+	for (i = 0; i < numChromos; i++) 
+	{
+		if (params->fitnessMemoisation == 1)
+		{
+			parent = getIdenticalChromosome(chromos[i], parents, numParents);
+
+			if (parent != -1)
+			{
+				chromos[i]->fitness = parents[parent]->fitness;
+
+				if (validation == 1)
+				{
+					chromos[i]->fitnessValidation = parents[parent]->fitnessValidation;
+				}
+
+				continue;
+			}
+		}
+
+		setChromosomeFitnessBounded(params, chromos[i], dataTrain, cutoff);
+
+		if (validation == 1)
+		{
+			setChromosomeFitnessValidation(params, chromos[i], dataValid);
+		}
+	}
+
+	if (params->offloadEvaluation == 1)
+	{
+		clearOffloadOutputs(evaluated, numEvaluated);
+		free(evaluated);
+	}
+}
+
+/*
+	returns the fitness above which the children cannot be selected as the
+	parent, or DBL_MAX if the fitnesses of all the children are used.
+
+	This is only known for the (1+lambda)-ES with selectFittest where a
+	child is selected if its fitness is not greater than that of the parent.
+*/
+static double getChildrenFitnessCutoff(struct parameters *params, struct chromosome **parents)
+{
+	if (params->boundedFitnessFunction == NULL || params->mu != 1 || params->evolutionaryStrategy != '+' || params->selectionScheme != selectFittest)
+	{
+		return DBL_MAX;
+	}
+
+	return parents[0]->fitness;
+}
+
+/*
+	returns the stratified mini-batches of the given training dataSet, or
+	NULL if mini-batches are not used. The samples are split between the
+	batches in the same way as generateFolds splits them between the folds,
+	so that each batch holds about the same proportion of each class.
+*/
+static struct miniBatches *initialiseMiniBatches(struct parameters *params, struct dataSet *data)
+{
+	int i;
+	int numBatches;
+	int *order;
+	int *batchSamples;
+	int *batchSizes;
+	struct miniBatches *batches;
+
+	if (params->miniBatchSize == 0 || data == NULL || params->miniBatchSize >= data->numSamples)
+	{
+		return NULL;
+	}
+
+	numBatches = (data->numSamples + params->miniBatchSize - 1) / params->miniBatchSize;
+	order = getStratifiedSampleOrder(data);
+
+	/* sample order[i] is given to batch i % numBatches */
+	batchSamples = (int*)malloc(numBatches * params->miniBatchSize * sizeof(int));
+	batchSizes = (int*)calloc(numBatches, sizeof(int));
+
+	for (i = 0; i < data->numSamples; i++)
+	{
+		batchSamples[((i % numBatches) * params->miniBatchSize) + batchSizes[i % numBatches]] = order[i];
+		batchSizes[i % numBatches]++;
+	}
+
+	batches = (struct miniBatches*)malloc(sizeof(struct miniBatches));
+	batches->numBatches = numBatches;
+	batches->batches = (struct dataSet**)malloc(numBatches * sizeof(struct dataSet*));
+
+	for (i = 0; i < numBatches; i++)
+	{
+		batches->batches[i] = initialiseDataSetView(data, batchSizes[i], batchSamples + (i * params->miniBatchSize));
+	}
+
+	free(order);
+	free(batchSamples);
+	free(batchSizes);
+
+	return batches;
+}
+
+/*
+	frees the given mini-batches, NULL if mini-batches are not used
+*/
+static void freeMiniBatches(struct miniBatches *batches)
+{
+	int i;
+
+	if (batches == NULL)
+	{
+		return;
+	}
+
+	for (i = 0; i < batches->numBatches; i++)
+	{
+		freeDataSet(batches->batches[i]);
+	}
+
+	free(batches->batches);
+	free(batches);
+}
+
+/*
+	returns the training samples of the given generation or DE iteration.
+	The mini-batches are used in turn, and every fullEvaluationInterval
+	iterations all the samples are used so that a candidate which was only
+	fit on its mini-batches does not stay selected.
+*/
+static struct dataSet *getMiniBatch(struct parameters *params, struct miniBatches *batches, struct dataSet *data, int iteration)
+{
+	if (batches == NULL || (iteration + 1) % params->fullEvaluationInterval == 0)
+	{
+		return data;
+	}
+
+	return batches->batches[iteration % batches->numBatches];
+}
+
+/*
+	starts the stopping policies of a run from the given generation and
+	the validation fitness of its best chromosome so far
+*/
+static void initialiseStoppingState(struct stoppingState *stopping, struct chromosome *best, int generation)
+{
+	stopping->startTime = getProfileClock();
+	stopping->bestFitnessValidation = best->fitnessValidation;
+	stopping->lastImprovement = generation;
+}
+
+/*
+	returns 1 if the run should stop after the given number of generations:
+	a parent has reached the target fitness, the best validation fitness
+	has not decreased for maxStallGenerations or the time budget is spent.
+	The parents are scored on batchTrain, and so when it is a mini-batch a
+	parent that reaches the target is scored again on all of dataTrain
+*/
+static int isRunStopped(struct parameters *params, struct stoppingState *stopping, struct chromosome **parents, struct chromosome *best, struct dataSet *batchTrain, struct dataSet *dataTrain, int generation)
+{
+	int i;
+
+	if (best->fitnessValidation < stopping->bestFitnessValidation)
+	{
+		stopping->bestFitnessValidation = best->fitnessValidation;
+		stopping->lastImprovement = generation;
+	}
+
+	for (i = 0; i < params->mu; i++)
+	{
+		if (parents[i]->fitness <= params->targetFitness && batchTrain != dataTrain)
+		{
+			setChromosomeFitness(params, parents[i], dataTrain);
+		}
+
+		if (parents[i]->fitness <= params->targetFitness)
+		{
+			return 1;
+		}
+	}
+
+	if (params->maxStallGenerations > 0 && generation - stopping->lastImprovement >= params->maxStallGenerations)
+	{
+		return 1;
+	}
+
+	return isTimeBudgetSpent(params, stopping);
+}
+
+/*
+	returns 1 if the time budget of the run has been spent
+*/
+static int isTimeBudgetSpent(struct parameters *params, struct stoppingState *stopping)
+{
+	return params->timeBudget > 0 && getProfileClock() - stopping->startTime >= params->timeBudget;
+}
+
+/*
+	returns the index of the first of the given chromosomes with the same
+	active nodes and connection weights as the given chromosome, or -1
+*/
+static int getIdenticalChromosome(struct chromosome *chromo, struct chromosome **chromos, int numChromos)
+{
+	int i;
+
+	for (i = 0; i < numChromos; i++) 
+	{
+		if (compareChromosomesActiveNodesANN(chromo, chromos[i]) == 1)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/*
+	executes every offloadable chromosome of the given array for all the
+	samples of the given dataSet at once, on the OpenMP target device if
+	there is one. The outputs of each chromosome are then given by
+	executeChromosomeSamples until clearOffloadOutputs is called. Only
+	chromosomes without recurrent connections which are evaluated by the
+	fast evaluator are offloaded; the others are executed as usual.
+*/
+static void executeChromosomesOffload(struct parameters *params, struct chromosome **chromos, int numChromos, struct dataSet *data)
+{
+	int c, i;
+	int first, blockSamples;
+	int numOffload = 0;
+	int numInputs, numNodes, numOutputs, arity, numSamples, numSlots;
+	int *numActive, *activations, *planArity, *planInputs, *planSlots, *outputNodes;
+	double *planWeights, *columns, *values, *outputs;
+	struct chromosome **offload;
+
+	if (params->offloadEvaluation == 0 || data->stream != NULL || data->numSamples == 0)
+	{
+		return;
+	}
+
+	offload = (struct chromosome**)malloc(numChromos * sizeof(struct chromosome*));
+
+	for (c = 0; c < numChromos; c++)
+	{
+		setChromosomeActiveNodes(chromos[c]);
+
+		if (chromos[c]->planRecurrent == 0 && chromos[c]->planActivation != ACTIVATIONNONE)
+		{
+			offload[numOffload] = chromos[c];
+			numOffload++;
+		}
+	}
+
+	if (numOffload == 0)
+	{
+		free(offload);
+		return;
+	}
+
+	numInputs = offload[0]->numInputs;
+	numNodes = offload[0]->numNodes;
+	numOutputs = offload[0]->numOutputs;
+	arity = offload[0]->arity;
+	numSamples = data->numSamples;
+	numSlots = numInputs + numNodes;
+
+	/* the plans of all the chromosomes are packed into flat arrays so that they are uploaded together */
+	numActive = (int*)malloc(numOffload * sizeof(int));
+	activations = (int*)malloc(numOffload * sizeof(int));
+	planArity = (int*)malloc(numOffload * numNodes * sizeof(int));
+	planSlots = (int*)malloc(numOffload * numNodes * sizeof(int));
+	planInputs = (int*)malloc(numOffload * numNodes * arity * sizeof(int));
+	planWeights = (double*)malloc(numOffload * numNodes * arity * sizeof(double));
+	outputNodes = (int*)malloc(numOffload * numOutputs * sizeof(int));
+
+	for (c = 0; c < numOffload; c++)
+	{
+		numActive[c] = offload[c]->numActiveNodes;
+		activations[c] = offload[c]->planActivation;
+
+		memcpy(planArity + (c * numNodes), offload[c]->planArity, numActive[c] * sizeof(int));
+		memcpy(planSlots + (c * numNodes), offload[c]->planSlots, numActive[c] * sizeof(int));
+		memcpy(planInputs + (c * numNodes * arity), offload[c]->planInputs, numActive[c] * arity * sizeof(int));
+		memcpy(planWeights + (c * numNodes * arity), offload[c]->planWeights, numActive[c] * arity * sizeof(double));
+		memcpy(outputNodes + (c * numOutputs), offload[c]->outputNodes, numOutputs * sizeof(int));
+	}
+
+	/* the inputs stay on the device until the dataSet, or its column copy, is free'd */
+	columns = getDataSetInputColumns(data);
+
+	/* runs sharing the dataSet map it once */
+	#pragma omp critical (dataSetColumns)
+	{
+		if (data->offloadMapped == 0)
+		{
+			#pragma omp target enter data map(to: columns[0:numInputs * numSamples])
+			data->offloadMapped = 1;
+		}
+	}
+
+	values = (double*)malloc((size_t)numOffload * OFFLOADBLOCKSIZE * numSlots * sizeof(double));
+	outputs = (double*)malloc((size_t)numOffload * numSamples * numOutputs * sizeof(double));
+
+	#pragma omp target data map(to: numActive[0:numOffload], activations[0:numOffload], planArity[0:numOffload * numNodes], planSlots[0:numOffload * numNodes], planInputs[0:numOffload * numNodes * arity], planWeights[0:numOffload * numNodes * arity], outputNodes[0:numOffload * numOutputs]) map(alloc: values[0:numOffload * OFFLOADBLOCKSIZE * numSlots]) map(from: outputs[0:numOffload * numSamples * numOutputs])
+	{
+		/* each launch executes every chromosome for a block of samples, each sample of each chromosome using its own row of values */
+		for (first = 0; first < numSamples; first += OFFLOADBLOCKSIZE)
+		{
+			blockSamples = numSamples - first < OFFLOADBLOCKSIZE ? numSamples - first : OFFLOADBLOCKSIZE;
+
+			#pragma omp target teams distribute parallel for collapse(2) map(to: columns[0:numInputs * numSamples])
+			for (c = 0; c < numOffload; c++)
+			{
+				for (i = 0; i < blockSamples; i++)
+				{
+					executeOffloadSample(numInputs, numOutputs, arity, numActive[c], activations[c], planArity + (c * numNodes), planSlots + (c * numNodes), planInputs + (c * numNodes * arity), planWeights + (c * numNodes * arity), outputNodes + (c * numOutputs), columns + first + i, numSamples, values + (((size_t)c * OFFLOADBLOCKSIZE) + i) * numSlots, outputs + (((size_t)c * numSamples) + first + i) * numOutputs);
+				}
+			}
+		}
+	}
+
+	for (c = 0; c < numOffload; c++)
+	{
+		if (offload[c]->offloadOutputs == NULL || offload[c]->offloadNumSamples < numSamples)
+		{
+			free(offload[c]->offloadOutputs);
+			offload[c]->offloadOutputs = (double*)malloc((size_t)numSamples * numOutputs * sizeof(double));
+			offload[c]->offloadNumSamples = numSamples;
+		}
+
+		memcpy(offload[c]->offloadOutputs, outputs + ((size_t)c * numSamples * numOutputs), (size_t)numSamples * numOutputs * sizeof(double));
+		offload[c]->offloadDataSetId = data->id;
+	}
+
+	free(outputs);
+	free(values);
+	free(outputNodes);
+	free(planWeights);
+	free(planInputs);
+	free(planSlots);
+	free(planArity);
+	free(activations);
+	free(numActive);
+	free(offload);
+}
+
+/*
+	ends the use of the outputs given by executeChromosomesOffload, which
+	are only those of the chromosome genes when they were computed
+*/
+static void clearOffloadOutputs(struct chromosome **chromos, int numChromos)
+{
+	int c;
+
+	for (c = 0; c < numChromos; c++)
+	{
+		chromos[c]->offloadDataSetId = 0;
+	}
+}
+
+/*
+	sends the fittest parents of this island to its neighbours and receives
+	theirs. Each immigrant is evaluated on the training samples of this island
+	and replaces the worst parent if its fitness is not greater. Every island
+	must migrate at the same generations for the exchanges to be matched
+*/
+static void migrateChromosomes(struct parameters *params, struct chromosome **parents, struct dataSet *dataTrain, struct dataSet *dataValid, unsigned int * seed)
+{
+	int i, j;
+	int offset, numOffsets;
+	int numMigrants, numImmigrants;
+	int worst;
+	char *sendBuffer;
+	char *receiveBuffer;
+	char source[40];
+	const char *record;
+	size_t sendSize, receiveSize, recordSize;
+	size_t weightsOffset, functionsOffset, inputsOffset, outputsOffset;
+	struct binaryChromosomeRecord chromoRecord;
+	struct chromosome **migrants;
+	struct chromosome *immigrant;
+
+	if (params->migrationTransport == NULL || params->numIslands < 2) {
+		return;
+	}
+
+	/* the migrants are sent in the binary chromosome format, fittest first */
+	numMigrants = params->numMigrants < params->mu ? params->numMigrants : params->mu;
+
+	migrants = (struct chromosome**)malloc(params->mu * sizeof(struct chromosome*));
+	memcpy(migrants, parents, params->mu * sizeof(struct chromosome*));
+	sortChromosomeArray(migrants, params->mu);
+
+	sendBuffer = getBinaryChromosomes(migrants, numMigrants, &sendSize);
+	free(migrants);
+
+	immigrant = initialiseChromosomeFromChromosome(parents[0], seed);
+
+	/* a ring exchanges with the next and previous islands, a complete topology with every other island in turn */
+	numOffsets = params->migrationTopology == MIGRATIONRING ? 1 : params->numIslands - 1;
+
+	for (offset = 1; offset <= numOffsets; offset++) {
+
+		receiveBuffer = NULL;
+		receiveSize = 0;
+
+		params->migrationTransport(params->migrationContext, (params->island + offset) % params->numIslands, sendBuffer, sendSize, (params->island - offset + params->numIslands) % params->numIslands, &receiveBuffer, &receiveSize);
+
+		snprintf(source, 40, "migrants of island %d", (params->island - offset + params->numIslands) % params->numIslands);
+		record = getBinaryFileRecords(source, receiveBuffer, receiveSize, "CGPDECH", &numImmigrants);
+
+		for (i = 0; i < numImmigrants; i++) {
+
+			if ((size_t)(receiveBuffer + receiveSize - record) < sizeof(struct binaryChromosomeRecord)) {
+				printf("Error: the %s are incomplete.\nTerminating CGP-Library.\n", source);
+				exit(0);
+			}
+
+			memcpy(&chromoRecord, record, sizeof(struct binaryChromosomeRecord));
+
+			if (chromoRecord.numInputs != params->numInputs || chromoRecord.numNodes != params->numNodes || chromoRecord.numOutputs != params->numOutputs || chromoRecord.arity != params->arity || chromoRecord.numFunctions != immigrant->funcSet->numFunctions) {
+				printf("Error: the %s do not have the dimensions and function set given by the parameters.\nTerminating CGP-Library.\n", source);
+				exit(0);
+			}
+
+			recordSize = getBinaryChromosomeSize(&chromoRecord, &weightsOffset, &functionsOffset, &inputsOffset, &outputsOffset);
+
+			if ((size_t)(receiveBuffer + receiveSize - record) < recordSize) {
+				printf("Error: the %s are incomplete.\nTerminating CGP-Library.\n", source);
+				exit(0);
+			}
+
+			/* the function genes index the function set, which must be the same as that of this island */
+			if (isBinaryChromosomeFunctionSet(record, immigrant->funcSet) == 0) {
+				printf("Error: the %s do not have the function set given by the parameters.\nTerminating CGP-Library.\n", source);
+				exit(0);
+			}
+
+			setBinaryChromosomeGenes(immigrant, record);
+			setChromosomeFitness(params, immigrant, dataTrain);
+			setChromosomeFitnessValidation(params, immigrant, dataValid);
+
+			worst = 0;
+			for (j = 1; j < params->mu; j++) {
+				if (parents[j]->fitness > parents[worst]->fitness) {
+					worst = j;
+				}
+			}
+
+			if (immigrant->fitness <= parents[worst]->fitness) {
+				copyChromosome(parents[worst], immigrant);
+			}
+
+			record += recordSize;
+		}
+
+		free(receiveBuffer);
+	}
+
+	freeChromosome(immigrant);
+	free(sendBuffer);
+}
+
+#ifdef CGPDE_MPI
+/*
+	exchanges the migrants with MPI_Sendrecv, first their size and then the
+	migrants themselves, so that every island can send and receive at once
+*/
+static void mpiMigrationTransport(void *context, int destination, const char *sendBuffer, size_t sendSize, int source, char **receiveBuffer, size_t *receiveSize)
+{
+	unsigned long long sendLength = sendSize;
+	unsigned long long receiveLength;
+
+	(void)context;
+
+	MPI_Sendrecv(&sendLength, 1, MPI_UNSIGNED_LONG_LONG, destination, 0, &receiveLength, 1, MPI_UNSIGNED_LONG_LONG, source, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+	*receiveBuffer = (char*)malloc(receiveLength);
+	*receiveSize = receiveLength;
+
+	MPI_Sendrecv(sendBuffer, (int)sendLength, MPI_BYTE, destination, 1, *receiveBuffer, (int)receiveLength, MPI_BYTE, source, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+}
+#endif
+
+/* 
+	CGPDE-IN Algorithm
+*/
+
+DLL_EXPORT struct chromosome* runCGPDE_IN(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, unsigned int * seed) 
+{
+	return runCGPDE_INFromCheckpoint(params, dataTrain, dataValid, numGens, NULL, seed);
+}
+
+/*
+	CGPDE-IN Algorithm continued from the checkpoint saved by runCGPDE_IN
+*/
+
+DLL_EXPORT struct chromosome* resumeCGPDE_IN(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, char const *checkpointFile, unsigned int * seed)
+{
+	return runCGPDE_INFromCheckpoint(params, dataTrain, dataValid, numGens, checkpointFile, seed);
+}
+
+/*
+	runCGPDE_IN, starting from the given checkpoint file unless it is NULL
+*/
+
+static struct chromosome* runCGPDE_INFromCheckpoint(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, char const *checkpointFile, unsigned int * seed)
+{
+	int i;
+	int gen;
+	int firstGen = 0;
+
+	/* the stopping policies of the run */
+	struct stoppingState stopping;
+	int stopped = 0;
+
+	/* bestChromo found using runCGPDE_IN */
+	struct chromosome *bestChromo;
+
+	/* arrays of the parents and children */
+	struct chromosome **parentChromos;
+	struct chromosome **childrenChromos;
+
+	/* storage for chromosomes used by selection scheme */
+	struct chromosome **candidateChromos;
+	struct chromosome **rankedChromos;
+	int numCandidateChromos;
+
+	/* DE population and trial vectors reused by every generation */
+	struct DEChromosome **DEChromos = NULL;
+	struct DEChromosome **DEChromos_u = NULL;
+	int numTrials = 0;
+
+	/* the topologies whose weights were evolved by DE, NULL if they are not remembered */
+	struct topologyCache *cache = initialiseTopologyCache(params);
+
+	/* error checking */
+	if (numGens < 0) {
+		printf("Error: %d generations is invalid. The number of generations must be >= 0.\n Terminating CGP-Library.\n", numGens);
+		exit(0);
+	}
+
+	if (dataTrain != NULL && params->numInputs != dataTrain->numInputs) {
+		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", dataTrain->numInputs, params->numInputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (dataTrain != NULL && params->numOutputs != dataTrain->numOutputs) {
+		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", dataTrain->numOutputs, params->numOutputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (dataValid != NULL && params->numInputs != dataValid->numInputs) {
+		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", dataValid->numInputs, params->numInputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (dataValid != NULL && params->numOutputs != dataValid->numOutputs) {
+		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", dataValid->numOutputs, params->numOutputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	/* initialise parent chromosomes */
+	parentChromos = (struct chromosome**)malloc(params->mu * sizeof(struct chromosome*));
+	for (i = 0; i < params->mu; i++) 
+	{
+		parentChromos[i] = initialiseChromosome(params, seed);
+	}
+
+	/* 
+		allocate the DE population once, with room for every weight, 
+		the topology and weights are set by every generation
+	*/
+	if (params->recycleDEPopulation == 1)
+	{
+		numTrials = (params->synchronousDE == 1) ? params->NP_IN : 1;
+
+		DEChromos = (struct DEChromosome**)malloc(params->NP_IN * sizeof(struct DEChromosome*));
+		for (i = 0; i < params->NP_IN; i++) 
+		{
+			DEChromos[i] = allocateDEChromosome(parentChromos[0], params->numNodes * params->arity, seed);
+		}
+
+		DEChromos_u = (struct DEChromosome**)malloc(numTrials * sizeof(struct DEChromosome*));
+		for (i = 0; i < numTrials; i++) 
+		{
+			DEChromos_u[i] = allocateDEChromosome(parentChromos[0], params->numNodes * params->arity, seed);
+		}
+	}
+
+	/* initialise children chromosomes */
+	childrenChromos = (struct chromosome**)malloc(params->lambda * sizeof(struct chromosome*));
+	for (i = 0; i < params->lambda; i++) 
+	{
+		childrenChromos[i] = initialiseChromosome(params, seed);	
+	}
+
+	/* initialise best chromosome */
+	bestChromo = initialiseChromosomeFromChromosome(parentChromos[0], seed);
+	setChromosomeFitnessValidation(params, bestChromo, dataValid);
+
+	/* determine the size of the Candidate Chromos based on the evolutionary Strategy */
+	if (params->evolutionaryStrategy == '+') 
+	{
+		numCandidateChromos = params->mu + params->lambda;
+	}
+	else if (params->evolutionaryStrategy == ',') 
+	{
+		numCandidateChromos = params->lambda;
+	}
+	else 
+	{
+		printf("Error: the evolutionary strategy '%c' is not known.\nTerminating CGP-Library.\n", params->evolutionaryStrategy);
+		exit(0);
+	}
+
+	/* initialise the candidateChromos */
+	candidateChromos = (struct chromosome**)malloc(numCandidateChromos * sizeof(struct chromosome*));
+	for (i = 0; i < numCandidateChromos; i++) 
+	{
+		candidateChromos[i] = initialiseChromosome(params, seed);
+	}
+
+	/* the children followed by the parents, ranked by the selection scheme */
+	rankedChromos = (struct chromosome**)malloc((params->mu + params->lambda) * sizeof(struct chromosome*));
+
+	/* set fitness of the parents */
+	for (i = 0; i < params->mu; i++) 
+	{
+		setChromosomeFitness(params, parentChromos[i], dataTrain);
+	}
+
+	initialiseStoppingState(&stopping, bestChromo, firstGen);
+
+	/* continue from the generation and stopping state of the checkpoint */
+	if (checkpointFile != NULL)
+	{
+		firstGen = loadCGPCheckpoint(params, checkpointFile, CHECKPOINTCGPDE_IN, parentChromos, childrenChromos, bestChromo, &stopping, seed);
+	}
+
+	/* for each generation, until a stopping policy is met */
+	for (gen = firstGen; gen < numGens && stopped == 0; gen++) 
+	{		
+		double best_fit = DBL_MAX;
+		int i, best_i = -1;
+
+		/* evaluate every children */
+		setChromosomesFitness(params, childrenChromos, params->lambda, parentChromos, params->mu, dataTrain, dataValid, 0, DBL_MAX);
+
+		/* store the index of the best one */
+		for (i = 0; i < params->lambda; i++) 
+		{
+			double current_fit = getChromosomeFitness(childrenChromos[i]);		
+
+			if(current_fit < best_fit)
+			{
+				best_fit = current_fit;
+				best_i = i;
+			}
+		}
+
+		struct chromosome ** populationChromos = NULL;
+
+		/* the weights already evolved by DE for the topology of the best children */
+		struct chromosome * tunedChromo = getTopologyCache(cache, childrenChromos[best_i]);
+
+		if (tunedChromo != NULL)
+		{
+			copyChromosomeActiveWeights(childrenChromos[best_i], tunedChromo);
+		}
+		else if (params->recycleDEPopulation == 1)
+		{
+			int numWeights = getNumChromosomeWeights(params, childrenChromos[best_i]);
+			int best_j = 0;
+
+			/* give the DE population the topology of the best children */
+			for (i = 0; i < params->NP_IN; i++) 
+			{
+				copyChromosome(DEChromos[i]->chromo, childrenChromos[best_i]);
+			}
+
+			for (i = 0; i < numTrials; i++) 
+			{
+				copyChromosome(DEChromos_u[i]->chromo, childrenChromos[best_i]);
+			}
+
+			/* evolve its weights */
+			setDEPopulationWeights(params, DEChromos, params->NP_IN, numWeights, dataTrain, seed);
+			evolveDEPopulation(params, DEChromos, DEChromos_u, params->NP_IN, 0, params->maxIter_IN, numWeights, dataTrain, NULL, NULL, seed);
+
+			/* the best DE individual with respect to the training set replaces the children */
+			for (i = 1; i < params->NP_IN; i++) 
+			{
+				if (DEChromos[i]->chromo->fitness < DEChromos[best_j]->chromo->fitness)
+				{
+					best_j = i;
+				}
+			}
+
+			copyChromosome(childrenChromos[best_i], DEChromos[best_j]->chromo);
+		}
+		else
+		{
+			/* run DE of the best children of the population to evolve weights */
+			populationChromos = runDE(params, childrenChromos[best_i], dataTrain, dataValid, 1, seed); // Type 1: CGPDE-IN
+			
+			/* get best chromo of the DE population with respect to the training set */
+			struct chromosome * bestDEChromo = getBestDEChromosome(params, populationChromos, dataValid, 1, seed); // typeCGPDE = 1: CGPDE-IN
+
+			copyChromosome(childrenChromos[best_i], bestDEChromo);
+			freeChromosome(bestDEChromo);
+		}
+
+		if (tunedChromo == NULL)
+		{
+			addTopologyCache(cache, childrenChromos[best_i]);
+		}
+
+		/* 
+			evaluate validation set accuracy of the above chromo, 
+			and compare it against the bestChromo, storing the best one 
+		*/
+		setChromosomeFitnessValidation(params, childrenChromos[best_i], dataValid);
+
+		if(childrenChromos[best_i]->fitnessValidation <= bestChromo->fitnessValidation)
+		{
+			copyChromosome(bestChromo, childrenChromos[best_i]);
+		}
+
+		/* select the parents from the children, and from the parents if '+' */
+		selectParents(params, parentChromos, childrenChromos, candidateChromos, rankedChromos, numCandidateChromos);
+
+		/* create the children from the parents */
+		params->reproductionScheme(params, parentChromos, childrenChromos, params->mu, params->lambda, 1, seed); // Type 1: CGPDE (do NOT apply weight mutation here)
+	
+		// clear the chromosomes returned by DE 
+		if (populationChromos != NULL)
+		{
+		        for (i = 0; i < params->NP_IN; i++) 
+			{ 
+				freeChromosome(populationChromos[i]);
+			}
+			free(populationChromos);
+		}
+
+		stopped = isRunStopped(params, &stopping, parentChromos, bestChromo, dataTrain, dataTrain, gen + 1);
+
+		saveCGPCheckpoint(params, CHECKPOINTCGPDE_IN, gen + 1, parentChromos, childrenChromos, bestChromo, &stopping, seed);
+
+		logProfile(params, gen + 1);
+	}
+
+	bestChromo->generation = gen;
+
+	freeTopologyCache(cache);
+
+	/* free the recycled DE population */
+	if (params->recycleDEPopulation == 1)
+	{
+		for (i = 0; i < params->NP_IN; i++) 
+		{
+			freeDEChromosome(DEChromos[i]);
+		}
+		free(DEChromos);
+
+		for (i = 0; i < numTrials; i++) 
+		{
+			freeDEChromosome(DEChromos_u[i]);
+		}
+		free(DEChromos_u);
+	}
+
+	/* free parent chromosomes */
+	for (i = 0; i < params->mu; i++) 
+	{
+		freeChromosome(parentChromos[i]);
+	}
+	free(parentChromos);
+
+	/* free children chromosomes */
+	for (i = 0; i < params->lambda; i++) 
+	{
+		freeChromosome(childrenChromos[i]);
+	}
+	free(childrenChromos);
+
+	/* free the used chromosomes and population */
+	for (i = 0; i < numCandidateChromos; i++) 
+	{
+		freeChromosome(candidateChromos[i]);
+	}
+	free(candidateChromos);
+	free(rankedChromos);
+
+	return bestChromo;
+}
+
+/*
+	CGPDE-OUT Algorithm
+
+	CGPDE-OUT-T and CGPDE-OUT-V versions need to run this function.
+	In fact, this function only needs to be runned once.
+	This function returns all the D.E. population (struct chromosome **).
+	The difference between both versions will be the picked chromosome from this population.
+*/
+
+DLL_EXPORT struct chromosome** runCGPDE_OUT(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, unsigned int * seed) 
+{
+	return runCGPDE_OUTFromCheckpoint(params, dataTrain, dataValid, numGens, NULL, seed);
+}
+
+/*
+	CGPDE-OUT Algorithm continued from the checkpoint saved by runCGPDE_OUT,
+	either during the evolution of the topologies or during the DE of the weights
+*/
+
+DLL_EXPORT struct chromosome** resumeCGPDE_OUT(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, char const *checkpointFile, unsigned int * seed)
+{
+	return runCGPDE_OUTFromCheckpoint(params, dataTrain, dataValid, numGens, checkpointFile, seed);
+}
+
+/*
+	runCGPDE_OUT, starting from the given checkpoint file unless it is NULL
+*/
+
+static struct chromosome** runCGPDE_OUTFromCheckpoint(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, char const *checkpointFile, unsigned int * seed)
+{
+	int i;
+	int gen;
+	int firstGen = 0;
+
+	/* the stopping policies of the run */
+	struct stoppingState stopping;
+	int stopped = 0;
+
+	/* the checkpoint of the DE of the weights, NULL unless it is resumed */
+	char const *checkpointFileDE = NULL;
+	struct binaryCheckpointRecord checkpointRecord;
+
+	/* bestChromo found using runCGPDE_OUT */
+	struct chromosome *bestChromo;
+
+	/* arrays of the parents and children */
+	struct chromosome **parentChromos;
+	struct chromosome **childrenChromos;
+
+	/* storage for chromosomes used by selection scheme */
+	struct chromosome **candidateChromos;
+	struct chromosome **rankedChromos;
+	int numCandidateChromos;
+
+	/* the training samples of each generation */
+	struct miniBatches *batches;
+	struct dataSet *batchTrain;
+
+	/* error checking */
+	if (numGens < 0) {
+		printf("Error: %d generations is invalid. The number of generations must be >= 0.\n Terminating CGP-Library.\n", numGens);
+		exit(0);
+	}
+
+	if (dataTrain != NULL && params->numInputs != dataTrain->numInputs) {
+		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", dataTrain->numInputs, params->numInputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (dataTrain != NULL && params->numOutputs != dataTrain->numOutputs) {
+		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", dataTrain->numOutputs, params->numOutputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (dataValid != NULL && params->numInputs != dataValid->numInputs) {
+		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", dataValid->numInputs, params->numInputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (dataValid != NULL && params->numOutputs != dataValid->numOutputs) {
+		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", dataValid->numOutputs, params->numOutputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	/* initialise parent chromosomes */
+	parentChromos = (struct chromosome**)malloc(params->mu * sizeof(struct chromosome*));
+	for (i = 0; i < params->mu; i++) 
+	{
+		parentChromos[i] = initialiseChromosome(params, seed);
+		setChromosomeFitness(params, parentChromos[i], dataTrain);
+		setChromosomeFitnessValidation(params, parentChromos[i], dataValid);
+	}
+
+	/* initialise children chromosomes */
+	childrenChromos = (struct chromosome**)malloc(params->lambda * sizeof(struct chromosome*));
+	for (i = 0; i < params->lambda; i++) 
+	{
+		childrenChromos[i] = initialiseChromosome(params, seed);	
+	}	
+
+	/* initialise best chromosomes */
+	bestChromo = initialiseChromosomeFromChromosome(parentChromos[0], seed);
+	setChromosomeFitnessValidation(params, bestChromo, dataValid);
+
+	/* determine the size of the Candidate Chromos based on the evolutionary Strategy */
+	if (params->evolutionaryStrategy == '+') 
+	{
+		numCandidateChromos = params->mu + params->lambda;
+	}
+	else if (params->evolutionaryStrategy == ',') 
+	{
+		numCandidateChromos = params->lambda;
+	}
+	else 
+	{
+		printf("Error: the evolutionary strategy '%c' is not known.\nTerminating CGP-Library.\n", params->evolutionaryStrategy);
+		exit(0);
+	}	
+
+	/* initialise the candidateChromos */
+	candidateChromos = (struct chromosome**)malloc(numCandidateChromos * sizeof(struct chromosome*));
+	for (i = 0; i < numCandidateChromos; i++) 
+	{
+		candidateChromos[i] = initialiseChromosome(params, seed);
+	}
+
+	/* the children followed by the parents, ranked by the selection scheme */
+	rankedChromos = (struct chromosome**)malloc((params->mu + params->lambda) * sizeof(struct chromosome*));
+
+	/* the mini-batches of the training samples, NULL if they are not used */
+	batches = initialiseMiniBatches(params, dataTrain);
+
+	initialiseStoppingState(&stopping, bestChromo, firstGen);
+
+	/* continue from the generation and stopping state of the checkpoint, or from its DE iteration after the last generation */
+	if (checkpointFile != NULL)
+	{
+		loadCheckpoint(params, checkpointFile, CHECKPOINTCGPDE_OUT, &checkpointRecord, NULL, 0);
+
+		if (checkpointRecord.iteration < 0)
+		{
+			firstGen = loadCGPCheckpoint(params, checkpointFile, CHECKPOINTCGPDE_OUT, parentChromos, childrenChromos, bestChromo, &stopping, seed);
+		}
+		else
+		{
+			loadCheckpoint(params, checkpointFile, CHECKPOINTCGPDE_OUT, &checkpointRecord, &bestChromo, 1);
+			checkpointFileDE = checkpointFile;
+			firstGen = numGens;
+		}
+	}
+
+	/* for each generation, until a stopping policy is met */
+	for (gen = firstGen; gen < numGens && stopped == 0; gen++) 
+	{	
+		batchTrain = getMiniBatch(params, batches, dataTrain, gen);
+
+		/* the parents were evaluated on other training samples and so are evaluated again on those of this generation */
+		if (batches != NULL)
+		{
+			setChromosomesFitness(params, parentChromos, params->mu, NULL, 0, batchTrain, dataValid, 0, DBL_MAX);
+		}
+
+		/* evaluate every children */
+		setChromosomesFitness(params, childrenChromos, params->lambda, parentChromos, params->mu, batchTrain, dataValid, 1, getChildrenFitnessCutoff(params, parentChromos));
+
+		/* get best chromosome - validation set */
+		getBestChromosome(parentChromos, childrenChromos, params->mu, params->lambda, bestChromo);
+
+		/* select the parents from the children, and from the parents if '+' */
+		selectParents(params, parentChromos, childrenChromos, candidateChromos, rankedChromos, numCandidateChromos);
+
+		/* exchange the fittest parents with the neighbouring islands */
+		if (params->migrationInterval > 0 && (gen + 1) % params->migrationInterval == 0)
+		{
+			migrateChromosomes(params, parentChromos, batchTrain, dataValid, seed);
+		}
+
+		/* create the children from the parents */
+		params->reproductionScheme(params, parentChromos, childrenChromos, params->mu, params->lambda, 1, seed); // Type 1: CGPDE (do NOT apply weight mutation here)
+
+		stopped = isRunStopped(params, &stopping, parentChromos, bestChromo, batchTrain, dataTrain, gen + 1);
+
+		saveCGPCheckpoint(params, CHECKPOINTCGPDE_OUT, gen + 1, parentChromos, childrenChromos, bestChromo, &stopping, seed);
+
+		logProfile(params, gen + 1);
+	}
+
+	freeMiniBatches(batches);
+
+	/* the generations of the topology, kept by the DE population and its checkpoints */
+	if (checkpointFileDE == NULL)
+	{
+		bestChromo->generation = gen;
+	}
+
+	/* run DE of the best individual (bestChromo) of the population with respect to the validation data to evolve weights */
+
+    struct chromosome ** populationChromos = runDEFromCheckpoint(params, bestChromo, dataTrain, dataValid, 2, 1, checkpointFileDE, &stopping, seed); // Type 2: CGPDE-OUT 
+
+	/* free parent chromosomes */
+	for (i = 0; i < params->mu; i++) 
+	{
+		freeChromosome(parentChromos[i]);
+	}
+	free(parentChromos);
+
+	/* free children chromosomes */
+	for (i = 0; i < params->lambda; i++) 
+	{
+		freeChromosome(childrenChromos[i]);
+	}
+	free(childrenChromos);
+
+	/* free the used chromosomes and population */
+	for (i = 0; i < numCandidateChromos; i++) 
+	{
+		freeChromosome(candidateChromos[i]);
+	}
+	free(candidateChromos);
+	free(rankedChromos);
+
+	freeChromosome(bestChromo);
+
+	return populationChromos;
+}
+
+
+/*
+	Run Differential Evolutionary (DE) algorithm to evolve weights of a given chromo
+	type = 1: CGPDE-IN
+	type = 2: CGPDE-OUT 
+*/
+
+DLL_EXPORT struct chromosome ** runDE(struct parameters *params, struct chromosome *chromo, struct dataSet *dataTrain, struct dataSet *dataValid, int type, unsigned int * seed)
+{
+	return runDEFromCheckpoint(params, chromo, dataTrain, dataValid, type, 0, NULL, NULL, seed);
+}
+
+/*
+	runDE, saving the checkpoints of CGPDE-OUT when checkpoint is 1 and
+	starting from the given checkpoint file unless it is NULL. Unless
+	stopping is NULL, DE stops once the time budget of its run is spent
+*/
+
+static struct chromosome **runDEFromCheckpoint(struct parameters *params, struct chromosome *chromo, struct dataSet *dataTrain, struct dataSet *dataValid, int type, int checkpoint, char const *checkpointFile, struct stoppingState *stopping, unsigned int * seed)
+{
+	int firstIter = 0;
+	int maxIter = 0;
+	int NP = 0;
+	double start = (params->profile != NULL) ? getProfileClock() : 0;
+
+	if (type == 1) // IN
+	{
+		maxIter = params->maxIter_IN;
+		NP = params->NP_IN;
+	}
+	else if(type == 2) // OUT
+	{
+		maxIter = params->maxIter_OUT;
+		NP = params->NP_OUT;
+	}
+
+	// initialise population
+	struct DEChromosome ** DEChromos = initialiseDEPopulation(params, chromo, dataTrain, type, seed);
+
+	// get weightsVector size
+	int numWeights = getNumChromosomeWeights(params, chromo);
+
+	// allocate memory for new solution u
+	struct DEChromosome * DEChromo_u = initialiseDEChromosome(params, chromo, dataTrain, seed);
+
+	// allocate memory for the new solutions of an iteration, one for each individual when updated synchronously
+	int numTrials = (params->synchronousDE == 1) ? NP : 1;
+	struct DEChromosome ** DEChromos_u = (struct DEChromosome**)malloc(numTrials * sizeof(struct DEChromosome*));
+
+	int i;
+
+	DEChromos_u[0] = DEChromo_u;
+	for(i = 1; i < numTrials; i++)
+	{
+		DEChromos_u[i] = allocateDEChromosome(chromo, numWeights, seed);
+	}
+
+	// continue from the iteration of the checkpoint
+	if (checkpointFile != NULL)
+	{
+		firstIter = loadDECheckpoint(params, checkpointFile, chromo, DEChromos, NP, seed);
+	}
+
+	evolveDEPopulation(params, DEChromos, DEChromos_u, NP, firstIter, maxIter, numWeights, dataTrain, (checkpoint == 1) ? chromo : NULL, stopping, seed);
+
+	struct chromosome ** populationChromos = (struct chromosome**)malloc(NP*sizeof(struct chromosome*));
+
+	// fill populationChromos and free DEChromosome population
+	for(i = 0; i < NP; i++)
+	{
+		populationChromos[i] = initialiseChromosomeFromChromosome(DEChromos[i]->chromo, seed);
+		freeDEChromosome(DEChromos[i]);
+	}
+	free(DEChromos);
 
-			newGeneValue = chromo->outputNodes[nodeIndex];
+	for(i = 0; i < numTrials; i++)
+	{
+		freeDEChromosome(DEChromos_u[i]);
+	}
+	free(DEChromos_u);
 
-			if (previousGeneValue != newGeneValue) {
-				mutatedActive = 1;
-			}
-		}
+	if (params->profile != NULL)
+	{
+		addProfileTime(params->profile, PROFILEDE, start);
 	}
+
+	return populationChromos;
 }
 
 
 /*
-	Conductions probabilistic mutation on the given chromosome. Each chromosome
-	gene is changed to a random valid allele with a probability specified in
-	parameters.
-	If CGPANN, the weights are also mutated.
+	Runs iterations firstIter to maxIter of DE on the weights of the given population.
+	DEChromos_u holds the new solutions, one when the population is updated
+	as soon as each new solution is evaluated, NP when it is updated synchronously.
+	The new solutions must have the topology of the population. Unless
+	checkpointChromo is NULL, it and the population are saved by saveDECheckpoint.
+	The iterations stop early once the population has converged, see
+	setMinDiversityDE, or once the time budget of stopping is spent.
 */
-static void probabilisticMutation(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed) {
 
-	int i, j;
+static void evolveDEPopulation(struct parameters *params, struct DEChromosome **DEChromos, struct DEChromosome **DEChromos_u, int NP, int firstIter, int maxIter, int numWeights, struct dataSet *dataTrain, struct chromosome *checkpointChromo, struct stoppingState *stopping, unsigned int * seed)
+{
+	int t, i;
 
-	/* for every nodes in the chromosome */
-	for (i = 0; i < params->numNodes; i++) 
-	{
-		/* mutate the function gene */
-		if (chromo->funcSet->numFunctions > 1 && randDecimal(seed) <= params->mutationRate) {
-			chromo->nodes[i]->function = getRandomFunction(chromo->funcSet->numFunctions, seed);
-		}
+	// the mini-batches of the training samples, NULL if they are not used
+	struct miniBatches * batches = initialiseMiniBatches(params, dataTrain);
+	struct dataSet * batchTrain;
 
-		/* for every input to each chromosome */
-		for (j = 0; j < params->arity; j++) {
+	// the chromosomes of the new solutions, executed together when offload evaluation is set
+	struct chromosome ** chromos = (struct chromosome**)malloc(NP * sizeof(struct chromosome*));
 
-			/* mutate the node input */
-			if (randDecimal(seed) <= params->mutationRate) {
-				chromo->nodes[i]->inputs[j] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, i, params->recurrentConnectionProbability, seed);
-			}
+	// for each iteration
+	for(t = firstIter; t < maxIter; t++)
+	{
+		// nothing is left to gain from the remaining iterations, and at least one is run so that the weights are evolved when the time budget was spent by the generations
+		if (isDEPopulationConverged(params, DEChromos, NP, numWeights) == 1 || (stopping != NULL && t > firstIter && isTimeBudgetSpent(params, stopping) == 1))
+		{
+			break;
+		}
 
-			/* mutate the node connection weight (IF CGPANN -> type = 0) */
-			if (type == 0 && randDecimal(seed) <= params->mutationRate) {
-				chromo->nodes[i]->weights[j] = getRandomConnectionWeight(params->connectionWeightRange, seed);
-			}
+		// the population as left by the previous iteration
+		if (checkpointChromo != NULL && t > firstIter)
+		{
+			saveDECheckpoint(params, t, checkpointChromo, DEChromos, NP, seed);
 		}
-	}
 
-	/* for every chromosome output */
-	for (i = 0; i < params->numOutputs; i++) {
+		batchTrain = getMiniBatch(params, batches, dataTrain, t);
 
-		/* mutate the chromosome output */
-		if (randDecimal(seed) <= params->mutationRate) {
-			chromo->outputNodes[i] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections, seed);
+		// the population was evaluated on other training samples and so is evaluated again on those of this iteration
+		if (batches != NULL)
+		{
+			setDEPopulationFitness(params, DEChromos, NP, batchTrain);
 		}
-	}
-}
 
-/*
-	Conductions probabilistic mutation on the active nodes in the given
-	chromosome. Each chromosome gene is changed to a random valid allele
-	with a probability specified in parameters.
-	If CGPANN, the weights are also mutated.
-*/
-static void probabilisticMutationOnlyActive(struct parameters *params, struct chromosome *chromo, int type, unsigned int * seed) {
+		if (params->synchronousDE == 1)
+		{
+			// build the new solution of every individual from the current population
+			for(i = 0; i < NP; i++)
+			{
+				setDETrialVector(params, DEChromos, NP, i, numWeights, DEChromos_u[i]->weightsVector, seed);
+			}
 
-	int i, j;
-	int activeNode;
+			// the new solutions are executed together, their weights being transferred first
+			if (params->offloadEvaluation == 1)
+			{
+				for(i = 0; i < NP; i++)
+				{
+					transferWeightsVectorToChromo(params, DEChromos_u[i]);
+					chromos[i] = DEChromos_u[i]->chromo;
+				}
 
-	/* for every active node in the chromosome */
-	for (i = 0; i < chromo->numActiveNodes; i++) {
+				executeChromosomesOffload(params, chromos, NP, batchTrain);
+			}
 
-		activeNode = chromo->activeNodes[i];
+			// the new solutions are independent and so are evaluated in parallel
+			#pragma omp parallel for default(none), private(i), shared(params,DEChromos,DEChromos_u,NP,batchTrain), schedule(dynamic), num_threads(params->numThreads)
+			for(i = 0; i < NP; i++)
+			{
+				setDEChromosomeFitness(params, DEChromos_u[i], batchTrain, getChromosomeFitness(DEChromos[i]->chromo));
+			}
 
-		/* mutate the function gene */
-		if (randDecimal(seed) <= params->mutationRate) {
-			chromo->nodes[activeNode]->function = getRandomFunction(chromo->funcSet->numFunctions, seed);
-		}
+			if (params->offloadEvaluation == 1)
+			{
+				clearOffloadOutputs(chromos, NP);
+			}
 
-		/* for every input to each chromosome */
-		for (j = 0; j < params->arity; j++) {
+			// keep the better of each individual and its new solution
+			for(i = 0; i < NP; i++)
+			{
+				if(getChromosomeFitness(DEChromos_u[i]->chromo) <= getChromosomeFitness(DEChromos[i]->chromo))
+				{
+					struct DEChromosome * swap = DEChromos[i];
+					DEChromos[i] = DEChromos_u[i];
+					DEChromos_u[i] = swap;
 
-			/* mutate the node input */
-			if (randDecimal(seed) <= params->mutationRate) {
-				chromo->nodes[activeNode]->inputs[j] = getRandomNodeInput(chromo->numInputs, chromo->numNodes, activeNode, params->recurrentConnectionProbability, seed);
+					if (params->profile != NULL)
+					{
+						addProfileCount(&params->profile->DETrialsAccepted, 1);
+					}
+				}
 			}
 
-			/* mutate the node connection weight (IF CGPANN -> type = 0) */
-			if (type == 0 && randDecimal(seed) <= params->mutationRate) {
-				chromo->nodes[activeNode]->weights[j] = getRandomConnectionWeight(params->connectionWeightRange, seed);
+			if (params->profile != NULL)
+			{
+				addProfileCount(&params->profile->DETrials, NP);
 			}
-		}
-	}
-
-	/* for every chromosome output */
-	for (i = 0; i < params->numOutputs; i++) {
 
-		/* mutate the chromosome output */
-		if (randDecimal(seed) <= params->mutationRate) {
-			chromo->outputNodes[i] = getRandomChromosomeOutput(chromo->numInputs, chromo->numNodes, params->shortcutConnections, seed);
+			continue;
 		}
-	}
-}
 
+		// for each DEChromos individual
+		for(i = 0; i < NP; i++)
+		{
+			setDETrialVector(params, DEChromos, NP, i, numWeights, DEChromos_u[0]->weightsVector, seed);
 
-/*
-	Sets the random number seed
-*/
-DLL_EXPORT void setRandomNumberSeed(unsigned int seed) {
-	srand(seed);
-}
+			// tranfer weightsVector to chromo and evaluate fitness, the new solution is only kept if it is not worse
+			setDEChromosomeFitness(params, DEChromos_u[0], batchTrain, getChromosomeFitness(DEChromos[i]->chromo));
 
+			// get fitness of both chromos
+			double fit_u = getChromosomeFitness(DEChromos_u[0]->chromo);
+			double fit_s = getChromosomeFitness(DEChromos[i]->chromo);
 
+			// the topologies are the same and so the solutions are swapped rather than copied
+			if(fit_u <= fit_s)
+			{
+				struct DEChromosome * swap = DEChromos[i];
+				DEChromos[i] = DEChromos_u[0];
+				DEChromos_u[0] = swap;
 
-/*
-	Classification Methods
-*/
+				if (params->profile != NULL)
+				{
+					addProfileCount(&params->profile->DETrialsAccepted, 1);
+				}
+			}
 
+			if (params->profile != NULL)
+			{
+				addProfileCount(&params->profile->DETrials, 1);
+			}
+		}
+	}
 
+	// the best individuals are chosen on their training fitness and so the population is left evaluated on all the training samples
+	if (batches != NULL)
+	{
+		setDEPopulationFitness(params, DEChromos, NP, dataTrain);
+		freeMiniBatches(batches);
+	}
+
+	free(chromos);
+}
 
 /*
-	CGPANN Algorithm
+	Evaluates the fitness of each individual of the given DE population on
+	the given dataSet, using params->numThreads threads. The weights of
+	each individual are already those of its chromosome.
 */
 
-DLL_EXPORT struct chromosome* runCGP(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, unsigned int * seed) 
+static void setDEPopulationFitness(struct parameters *params, struct DEChromosome **DEChromos, int NP, struct dataSet *data)
 {
 	int i;
-	int gen;
-
-	/* bestChromo found using runCGP */
-	struct chromosome *bestChromo;
+	struct chromosome ** chromos = NULL;
 
-	/* arrays of the parents and children */
-	struct chromosome **parentChromos;
-	struct chromosome **childrenChromos;
+	// the population is executed together, its weights already being those of the chromosomes
+	if (params->offloadEvaluation == 1)
+	{
+		chromos = (struct chromosome**)malloc(NP * sizeof(struct chromosome*));
 
-	/* storage for chromosomes used by selection scheme */
-	struct chromosome **candidateChromos;
-	int numCandidateChromos;
+		for(i = 0; i < NP; i++)
+		{
+			chromos[i] = DEChromos[i]->chromo;
+		}
 
-	/* error checking */
-	if (numGens < 0) {
-		printf("Error: %d generations is invalid. The number of generations must be >= 0.\n Terminating CGP-Library.\n", numGens);
-		exit(0);
+		executeChromosomesOffload(params, chromos, NP, data);
 	}
 
-	if (dataTrain != NULL && params->numInputs != dataTrain->numInputs) {
-		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", dataTrain->numInputs, params->numInputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
+	#pragma omp parallel for default(none), private(i), shared(params,DEChromos,NP,data), schedule(dynamic), num_threads(params->numThreads)
+	for(i = 0; i < NP; i++)
+	{
+		setChromosomeFitness(params, DEChromos[i]->chromo, data);
 	}
 
-	if (dataTrain != NULL && params->numOutputs != dataTrain->numOutputs) {
-		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", dataTrain->numOutputs, params->numOutputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
+	if (params->offloadEvaluation == 1)
+	{
+		clearOffloadOutputs(chromos, NP);
+		free(chromos);
 	}
+}
 
-	if (dataValid != NULL && params->numInputs != dataValid->numInputs) {
-		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", dataValid->numInputs, params->numInputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
+
+/*
+	Returns 1 if the diversity of the given DE population, the mean over
+	the weights of their standard deviation in the population, is below
+	params->minDiversityDE. Returns 0 if params->minDiversityDE is 0.
+*/
+
+static int isDEPopulationConverged(struct parameters *params, struct DEChromosome **DEChromos, int NP, int numWeights)
+{
+	int i, j;
+	double diversity = 0;
+
+	if (params->minDiversityDE == 0)
+	{
+		return 0;
 	}
 
-	if (dataValid != NULL && params->numOutputs != dataValid->numOutputs) {
-		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", dataValid->numOutputs, params->numOutputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
+	if (numWeights == 0)
+	{
+		return 1;
 	}
 
-	/* initialise parent chromosomes */
-	parentChromos = (struct chromosome**)malloc(params->mu * sizeof(struct chromosome*));
+	for(j = 0; j < numWeights; j++)
+	{
+		double mean = 0;
+		double variance = 0;
 
-	for (i = 0; i < params->mu; i++) {
-		parentChromos[i] = initialiseChromosome(params, seed);
-	}
+		for(i = 0; i < NP; i++)
+		{
+			mean += DEChromos[i]->weightsVector[j];
+		}
+		mean /= NP;
 
-	/* initialise children chromosomes */
-	childrenChromos = (struct chromosome**)malloc(params->lambda * sizeof(struct chromosome*));
+		for(i = 0; i < NP; i++)
+		{
+			double deviation = DEChromos[i]->weightsVector[j] - mean;
+			variance += deviation * deviation;
+		}
 
-	for (i = 0; i < params->lambda; i++) {
-		childrenChromos[i] = initialiseChromosome(params, seed);
+		diversity += sqrt(variance / NP);
 	}
 
-	/* initialise best chromosome */
-	bestChromo = initialiseChromosomeFromChromosome(parentChromos[0], seed);
-	setChromosomeFitnessValidation(params, bestChromo, dataValid);
+	return (diversity / numWeights) < params->minDiversityDE;
+}
 
-	/* determine the size of the Candidate Chromos based on the evolutionary Strategy */
-	if (params->evolutionaryStrategy == '+') {
-		numCandidateChromos = params->mu + params->lambda;
-	}
-	else if (params->evolutionaryStrategy == ',') {
-		numCandidateChromos = params->lambda;
-	}
-	else {
-		printf("Error: the evolutionary strategy '%c' is not known.\nTerminating CGP-Library.\n", params->evolutionaryStrategy);
-		exit(0);
-	}
+/*
+	Returns the empty topology cache of CGPDE-IN, or NULL if
+	params->topologyCacheSize is 0. The chromosomes are allocated
+	as they are first added.
+*/
 
-	/* initialise the candidateChromos */
-	candidateChromos = (struct chromosome**)malloc(numCandidateChromos * sizeof(struct chromosome*));
+static struct topologyCache *initialiseTopologyCache(struct parameters *params)
+{
+	int i;
+	struct topologyCache *cache;
 
-	for (i = 0; i < numCandidateChromos; i++) 
+	if (params->topologyCacheSize == 0)
 	{
-		candidateChromos[i] = initialiseChromosome(params, seed);
+		return NULL;
 	}
 
-	/* set fitness of the parents */
-	for (i = 0; i < params->mu; i++) 
+	cache = (struct topologyCache*)malloc(sizeof(struct topologyCache));
+	cache->size = params->topologyCacheSize;
+	cache->numChromos = 0;
+	cache->clock = 0;
+	cache->hashes = (unsigned long*)malloc(cache->size * sizeof(unsigned long));
+	cache->lastUses = (int*)malloc(cache->size * sizeof(int));
+	cache->chromos = (struct chromosome**)malloc(cache->size * sizeof(struct chromosome*));
+
+	for(i = 0; i < cache->size; i++)
 	{
-		setChromosomeFitness(params, parentChromos[i], dataTrain);
-		setChromosomeFitnessValidation(params, parentChromos[i], dataValid);
+		cache->chromos[i] = NULL;
 	}
 
-	/* for each generation */
-	for (gen = 0; gen < numGens; gen++) 
-	{
-		/* set fitness of the children of the population */
-		for (i = 0; i < params->lambda; i++) 
-		{
-			setChromosomeFitness(params, childrenChromos[i], dataTrain);
-			setChromosomeFitnessValidation(params, childrenChromos[i], dataValid);
-		}
+	return cache;
+}
 
-		/* get best chromosome - validation data */
-		getBestChromosome(parentChromos, childrenChromos, params->mu, params->lambda, bestChromo);
+/*
+	Frees the given topology cache, which may be NULL
+*/
 
-		/*
-			Set the chromosomes which will be used by the selection scheme
-			dependant upon the evolutionary strategy. i.e. '+' all are used
-			by the selection scheme, ',' only the children are.
-		*/
-		if (params->evolutionaryStrategy == '+') {
+static void freeTopologyCache(struct topologyCache *cache)
+{
+	int i;
+
+	if (cache == NULL)
+	{
+		return;
+	}
 
-			/*
-				Note: the children are placed before the parents to
-				ensure 'new blood' is always selected over old if the
-				fitness are equal.
-			*/
+	for(i = 0; i < cache->numChromos; i++)
+	{
+		freeChromosome(cache->chromos[i]);
+	}
 
-			for (i = 0; i < numCandidateChromos; i++) {
+	free(cache->chromos);
+	free(cache->lastUses);
+	free(cache->hashes);
+	free(cache);
+}
 
-				if (i < params->lambda) {
-					copyChromosome(candidateChromos[i], childrenChromos[i] );
-				}
-				else {
-					copyChromosome(candidateChromos[i], parentChromos[i - params->lambda] );
-				}
-			}
-		}
-		else if (params->evolutionaryStrategy == ',') {
+/*
+	Returns the FNV-1a hash of the active nodes of the given chromosome,
+	their functions and inputs, and of its outputs. Chromosomes which are
+	the same by compareChromosomesActiveNodes have the same hash.
+*/
 
-			for (i = 0; i < numCandidateChromos; i++) {
-				copyChromosome(candidateChromos[i], childrenChromos[i] );
-			}
-		}
+static unsigned long getChromosomeTopologyHash(struct chromosome *chromo)
+{
+	int i, j;
+	struct node *n;
+	uint64_t hash = 14695981039346656037ULL;
 
-		/* select the parents from the candidateChromos */
-		params->selectionScheme(params, parentChromos, candidateChromos, params->mu, numCandidateChromos);
+	setChromosomeActiveNodes(chromo);
 
-		/* create the children from the parents */
-		params->reproductionScheme(params, parentChromos, childrenChromos, params->mu, params->lambda, 0, seed); // Type 0: CGPANN (APPLY weight mutation here)
-	}
+	for(i = 0; i < chromo->numActiveNodes; i++)
+	{
+		n = chromo->nodes[chromo->activeNodes[i]];
 
-	/* free parent chromosomes */
-	for (i = 0; i < params->mu; i++) {
-		freeChromosome(parentChromos[i]);
-	}
-	free(parentChromos);
+		hash = (hash ^ (uint64_t)chromo->activeNodes[i]) * 1099511628211ULL;
+		hash = (hash ^ (uint64_t)n->function) * 1099511628211ULL;
 
-	/* free children chromosomes */
-	for (i = 0; i < params->lambda; i++) {
-		freeChromosome(childrenChromos[i]);
+		for(j = 0; j < chromo->arity; j++)
+		{
+			hash = (hash ^ (uint64_t)n->inputs[j]) * 1099511628211ULL;
+		}
 	}
-	free(childrenChromos);
 
-	/* free the used chromosomes and population */
-	for (i = 0; i < numCandidateChromos; i++) {
-		freeChromosome(candidateChromos[i]);
+	for(i = 0; i < chromo->numOutputs; i++)
+	{
+		hash = (hash ^ (uint64_t)chromo->outputNodes[i]) * 1099511628211ULL;
 	}
-	free(candidateChromos);
 
-	return bestChromo;
+	return (unsigned long)hash;
 }
 
 /*
-	returns a pointer to the fittest chromosome in the two arrays of chromosomes
-
-	loops through parents and then the children in order for the children to always be selected over the parents
+	Returns the chromosome of the topology cache with the same active
+	nodes as the given chromosome, or NULL if there is none
 */
-static void getBestChromosome(struct chromosome **parents, struct chromosome **children, int numParents, int numChildren, struct chromosome *best) 
+
+static struct chromosome *getTopologyCache(struct topologyCache *cache, struct chromosome *chromo)
 {
 	int i;
-	int flag = 0;
-	struct chromosome *bestChromoSoFar;
-
-	bestChromoSoFar = best;
+	unsigned long hash;
 
-	for (i = 0; i < numParents; i++) 
+	if (cache == NULL)
 	{
-		if (parents[i]->fitnessValidation <= bestChromoSoFar->fitnessValidation) 
-		{ 
-			bestChromoSoFar = parents[i];
-			flag = 1;
-		}
+		return NULL;
 	}
 
-	for (i = 0; i < numChildren; i++) 
+	hash = getChromosomeTopologyHash(chromo);
+
+	for(i = 0; i < cache->numChromos; i++)
 	{
-		if (children[i]->fitnessValidation <= bestChromoSoFar->fitnessValidation) 
+		if (cache->hashes[i] == hash && compareChromosomesActiveNodes(chromo, cache->chromos[i]) == 1)
 		{
-			bestChromoSoFar = children[i];
-			flag = 1;
+			cache->lastUses[i] = ++cache->clock;
+			return cache->chromos[i];
 		}
 	}
 
-	if(flag == 1)
-	{
-		copyChromosome(best, bestChromoSoFar);
-	}
+	return NULL;
 }
 
-/* 
-	CGPDE-IN Algorithm
+/*
+	Adds a copy of the given chromosome, whose weights were evolved by DE,
+	to the topology cache, replacing the least recently used chromosome
+	when the cache is full
 */
 
-DLL_EXPORT struct chromosome* runCGPDE_IN(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, unsigned int * seed) 
+static void addTopologyCache(struct topologyCache *cache, struct chromosome *chromo)
 {
 	int i;
-	int gen;
-
-	/* bestChromo found using runCGPDE_IN */
-	struct chromosome *bestChromo;
-
-	/* arrays of the parents and children */
-	struct chromosome **parentChromos;
-	struct chromosome **childrenChromos;
+	int index;
 
-	/* storage for chromosomes used by selection scheme */
-	struct chromosome **candidateChromos;
-	int numCandidateChromos;
+	// the random genes of a new chromosome are overwritten and so do not draw on the seed of the run
+	unsigned int cacheSeed = 0;
 
-	/* error checking */
-	if (numGens < 0) {
-		printf("Error: %d generations is invalid. The number of generations must be >= 0.\n Terminating CGP-Library.\n", numGens);
-		exit(0);
+	if (cache == NULL)
+	{
+		return;
 	}
 
-	if (dataTrain != NULL && params->numInputs != dataTrain->numInputs) {
-		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", dataTrain->numInputs, params->numInputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
+	if (cache->numChromos < cache->size)
+	{
+		index = cache->numChromos;
+		cache->chromos[index] = initialiseChromosomeFromChromosome(chromo, &cacheSeed);
+		cache->numChromos++;
 	}
+	else
+	{
+		index = 0;
 
-	if (dataTrain != NULL && params->numOutputs != dataTrain->numOutputs) {
-		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", dataTrain->numOutputs, params->numOutputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
-	}
+		for(i = 1; i < cache->size; i++)
+		{
+			if (cache->lastUses[i] < cache->lastUses[index])
+			{
+				index = i;
+			}
+		}
 
-	if (dataValid != NULL && params->numInputs != dataValid->numInputs) {
-		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", dataValid->numInputs, params->numInputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
+		copyChromosome(cache->chromos[index], chromo);
 	}
 
-	if (dataValid != NULL && params->numOutputs != dataValid->numOutputs) {
-		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", dataValid->numOutputs, params->numOutputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
-	}
+	cache->hashes[index] = getChromosomeTopologyHash(chromo);
+	cache->lastUses[index] = ++cache->clock;
+}
 
-	/* initialise parent chromosomes */
-	parentChromos = (struct chromosome**)malloc(params->mu * sizeof(struct chromosome*));
-	for (i = 0; i < params->mu; i++) 
-	{
-		parentChromos[i] = initialiseChromosome(params, seed);
-	}
+/*
+	Copies the weights of the active nodes, and the fitness, of the given
+	source chromosome to the destination chromosome, which has the same
+	active nodes. The inactive nodes of the destination are unchanged.
+*/
 
-	/* initialise children chromosomes */
-	childrenChromos = (struct chromosome**)malloc(params->lambda * sizeof(struct chromosome*));
-	for (i = 0; i < params->lambda; i++) 
+static void copyChromosomeActiveWeights(struct chromosome *chromoDest, struct chromosome *chromoSrc)
+{
+	int i;
+	int nodeIndex;
+
+	setChromosomeActiveNodes(chromoDest);
+
+	for(i = 0; i < chromoDest->numActiveNodes; i++)
 	{
-		childrenChromos[i] = initialiseChromosome(params, seed);	
+		nodeIndex = chromoDest->activeNodes[i];
+		memcpy(chromoDest->nodes[nodeIndex]->weights, chromoSrc->nodes[nodeIndex]->weights, chromoDest->arity * sizeof(double));
 	}
 
-	/* initialise best chromosome */
-	bestChromo = initialiseChromosomeFromChromosome(parentChromos[0], seed);
-	setChromosomeFitnessValidation(params, bestChromo, dataValid);
+	chromoDest->fitness = chromoSrc->fitness;
 
-	/* determine the size of the Candidate Chromos based on the evolutionary Strategy */
-	if (params->evolutionaryStrategy == '+') 
+	// the weights do not change the active nodes and so only the execution plan is rebuilt
+	clearNodeCache(chromoDest);
+	compileChromosome(chromoDest);
+}
+
+/*
+	Among the population of chromosomes returned by D.E., this function gets the best chromo.
+	typeCGPDE = 1: CGPDE-IN 
+	typeCGPDE = 2: CGPDE-OUT-T
+	typeCGPDE = 3: CGPDE-OUT-V
+*/
+
+DLL_EXPORT struct chromosome * getBestDEChromosome(struct parameters *params, struct chromosome ** chromos, struct dataSet * dataValid, int typeCGPDE, unsigned int * seed)
+{
+	int NP = 0;
+	if (typeCGPDE == 1) // IN
 	{
-		numCandidateChromos = params->mu + params->lambda;
+		NP = params->NP_IN;
 	}
-	else if (params->evolutionaryStrategy == ',') 
+	else if(typeCGPDE == 2 || typeCGPDE == 3) // OUT-T or OUT-V
 	{
-		numCandidateChromos = params->lambda;
+		NP = params->NP_OUT;
 	}
-	else 
+
+	int i;
+	if(typeCGPDE == 3) // OUT-V
 	{
-		printf("Error: the evolutionary strategy '%c' is not known.\nTerminating CGP-Library.\n", params->evolutionaryStrategy);
-		exit(0);
+		for(i = 0; i < NP; i++) // evaluate validation set accuracy of the NP chromos
+		{
+			setChromosomeFitnessValidation(params, chromos[i], dataValid);
+		}
 	}
+	
+	struct chromosome * best = initialiseChromosomeFromChromosome(chromos[0], seed);
+	struct chromosome *bestChromoSoFar;
+	bestChromoSoFar = chromos[0];
 
-	/* initialise the candidateChromos */
-	candidateChromos = (struct chromosome**)malloc(numCandidateChromos * sizeof(struct chromosome*));
-	for (i = 0; i < numCandidateChromos; i++) 
+	for (i = 1; i < NP; i++) 
 	{
-		candidateChromos[i] = initialiseChromosome(params, seed);
+		if ( (typeCGPDE == 1 || typeCGPDE == 2) && chromos[i]->fitness < bestChromoSoFar->fitness ) // IN or OUT-T
+		{
+			bestChromoSoFar = chromos[i];
+		}
+		else if ( typeCGPDE == 3 && chromos[i]->fitnessValidation < bestChromoSoFar->fitnessValidation ) // OUT-V
+		{
+			bestChromoSoFar = chromos[i];
+		}
 	}
 
-	/* set fitness of the parents */
-	for (i = 0; i < params->mu; i++) 
+	copyChromosome(best, bestChromoSoFar);
+	return best;
+}
+
+/*
+	Initialise DE Population, keeping the weights of the original chromosome, and changing the weights of the remaining ones.
+	Topology is NOT changed!
+	type = 1: CGPDE-IN
+	type = 2: CGPDE-OUT 
+*/
+
+DLL_EXPORT struct DEChromosome ** initialiseDEPopulation(struct parameters *params, struct chromosome *chromo, struct dataSet *data, int type, unsigned int * seed)
+{
+	int NP = 0;
+	if (type == 1) // IN
 	{
-		setChromosomeFitness(params, parentChromos[i], dataTrain);
+		NP = params->NP_IN;
+	}
+	else if(type == 2) // OUT
+	{
+		NP = params->NP_OUT;
 	}
 
+	int numWeights = getNumChromosomeWeights(params, chromo);
 
-	/* for each generation */
-	for (gen = 0; gen < numGens; gen++) 
-	{		
-		double best_fit = DBL_MAX;
-		int i, best_i = -1;
+	// allocate memory for DEChromosome array
+	struct DEChromosome **DEChromos = (struct DEChromosome**) malloc( NP * sizeof(struct DEChromosome*) );   
 
-		/* evaluate every children and store the index of the best one */
-		for (i = 0; i < params->lambda; i++) 
-		{
-			setChromosomeFitness(params, childrenChromos[i], dataTrain);	
-			double current_fit = getChromosomeFitness(childrenChromos[i]);		
+	int i;
+    for(i = 0; i < NP; i++) 
+    {
+    	DEChromos[i] = allocateDEChromosome(chromo, numWeights, seed);
+    }
 
-			if(current_fit < best_fit)
-			{
-				best_fit = current_fit;
-				best_i = i;
-			}
-		}
+    setDEPopulationWeights(params, DEChromos, NP, numWeights, data, seed);
 
-		/* run DE of the best children of the population to evolve weights */
-		struct chromosome ** populationChromos = runDE(params, childrenChromos[best_i], dataTrain, dataValid, 1, seed); // Type 1: CGPDE-IN
-		
-		/* get best chromo of the DE population with respect to the training set */
-		childrenChromos[best_i] = getBestDEChromosome(params, populationChromos, dataValid, 1, seed); // typeCGPDE = 1: CGPDE-IN
+    return DEChromos;
+}
 
-		/* 
-			evaluate validation set accuracy of the above chromo, 
-			and compare it against the bestChromo, storing the best one 
-		*/
-		setChromosomeFitnessValidation(params, childrenChromos[best_i], dataValid);
+/*
+	Sets the weights of a DE population whose individuals have the same topology,
+	keeping the weights of the first individual and randomising those of the others.
+*/
 
-		if(childrenChromos[best_i]->fitnessValidation <= bestChromo->fitnessValidation)
-		{
-			copyChromosome(bestChromo, childrenChromos[best_i]);
-		}
+static void setDEPopulationWeights(struct parameters *params, struct DEChromosome **DEChromos, int NP, int numWeights, struct dataSet *data, unsigned int * seed)
+{
+	int i, j;
 
-		/*
-			Set the chromosomes which will be used by the selection scheme
-			dependant upon the evolutionary strategy. i.e. '+' all are used
-			by the selection scheme, ',' only the children are.
-		*/
-		if (params->evolutionaryStrategy == '+') 
-		{
-			/*
-				Note: the children are placed before the parents to
-				ensure 'new blood' is always selected over old if the
-				fitness are equal.
-			*/
+    // keep the original chromo!
+    transferChromoToWeightsVector(params, DEChromos[0]);
+	setChromosomeFitness(params, DEChromos[0]->chromo, data);
 
-			for (i = 0; i < numCandidateChromos; i++) 
-			{
-				if (i < params->lambda) 
-				{
-					copyChromosome(candidateChromos[i], childrenChromos[i] );
-				}
-				else 
-				{
-					copyChromosome(candidateChromos[i], parentChromos[i - params->lambda] );
-				}
-			}
-		}
-		else if (params->evolutionaryStrategy == ',') 
-		{
-			for (i = 0; i < numCandidateChromos; i++) 
-			{
-				copyChromosome(candidateChromos[i], childrenChromos[i] );
-			}
-		}
+    // assign random weights for the remaining of the chromosomes of the population
+    for(i = 1; i < NP; i++) 
+    {
+    	for(j = 0; j < numWeights; j++)
+    	{
+    		DEChromos[i]->weightsVector[j] = getRandomConnectionWeight(params->connectionWeightRange, seed); 
+    	}
 
-		/* select the parents from the candidateChromos */
-		params->selectionScheme(params, parentChromos, candidateChromos, params->mu, numCandidateChromos);
+    }
 
-		/* create the children from the parents */
-		params->reproductionScheme(params, parentChromos, childrenChromos, params->mu, params->lambda, 1, seed); // Type 1: CGPDE (do NOT apply weight mutation here)
-	
-		// clear the chromosomes returned by DE 
-	        for (i = 0; i < params->NP_IN; i++) 
-		{ 
-			freeChromosome(populationChromos[i]);
-		}
-		free(populationChromos);
+    // transfer weightsVector to chromo and evaluate fitness
+    for(i = 1; i < NP; i++)
+    {
+    	setDEChromosomeFitness(params, DEChromos[i], data, DBL_MAX);
 	}
+}
 
-	/* free parent chromosomes */
-	for (i = 0; i < params->mu; i++) 
-	{
-		freeChromosome(parentChromos[i]);
-	}
-	free(parentChromos);
+/*
+	Initialise a DEChromosome struct
+*/
 
-	/* free children chromosomes */
-	for (i = 0; i < params->lambda; i++) 
-	{
-		freeChromosome(childrenChromos[i]);
-	}
-	free(childrenChromos);
+DLL_EXPORT struct DEChromosome * initialiseDEChromosome(struct parameters *params, struct chromosome *chromo, struct dataSet *data, unsigned int * seed)
+{
+	int numWeights = getNumChromosomeWeights(params, chromo);
 
-	/* free the used chromosomes and population */
-	for (i = 0; i < numCandidateChromos; i++) 
-	{
-		freeChromosome(candidateChromos[i]);
-	}
-	free(candidateChromos);
+	// allocate memory for DEChromosome
+	struct DEChromosome *DEChromo = allocateDEChromosome(chromo, numWeights, seed);
 
-	return bestChromo;
+	int i;
+
+    // assign random weights for the population
+    for(i = 0; i < numWeights; i++)
+    {
+    	DEChromo->weightsVector[i] = getRandomConnectionWeight(params->connectionWeightRange, seed);
+    }
+
+    // transfer weightsVector to chromo and evaluate fitness
+    transferWeightsVectorToChromo(params, DEChromo);
+    setChromosomeFitness(params, DEChromo->chromo, data);
+
+    return DEChromo;
 }
 
 /*
-	CGPDE-OUT Algorithm
-
-	CGPDE-OUT-T and CGPDE-OUT-V versions need to run this function.
-	In fact, this function only needs to be runned once.
-	This function returns all the D.E. population (struct chromosome **).
-	The difference between both versions will be the picked chromosome from this population.
+	Allocates a DEChromosome with a copy of the given chromo. The weightsVector,
+	with room for numWeights weights, shares the DEChromosome's memory block.
 */
 
-DLL_EXPORT struct chromosome** runCGPDE_OUT(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, unsigned int * seed) 
+static struct DEChromosome *allocateDEChromosome(struct chromosome *chromo, int numWeights, unsigned int * seed)
 {
-	int i;
-	int gen;
+	size_t size = 0;
+	size_t DEChromoOffset = getChromosomePartOffset(&size, sizeof(struct DEChromosome));
+	size_t weightsVectorOffset = getChromosomePartOffset(&size, numWeights * sizeof(double));
 
-	/* bestChromo found using runCGPDE_OUT */
-	struct chromosome *bestChromo;
+	char *block = (char*)malloc(size);
 
-	/* arrays of the parents and children */
-	struct chromosome **parentChromos;
-	struct chromosome **childrenChromos;
+	struct DEChromosome *DEChromo = (struct DEChromosome*)(block + DEChromoOffset);
+	DEChromo->weightsVector = (double*)(block + weightsVectorOffset);
 
-	/* storage for chromosomes used by selection scheme */
-	struct chromosome **candidateChromos;
-	int numCandidateChromos;
+	// allocate memory for chromo
+	DEChromo->chromo = initialiseChromosomeFromChromosome(chromo, seed);
 
-	/* error checking */
-	if (numGens < 0) {
-		printf("Error: %d generations is invalid. The number of generations must be >= 0.\n Terminating CGP-Library.\n", numGens);
-		exit(0);
-	}
+	return DEChromo;
+}
 
-	if (dataTrain != NULL && params->numInputs != dataTrain->numInputs) {
-		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", dataTrain->numInputs, params->numInputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
-	}
+/*
+	Builds the trial vector of DE individual i from three other random
+	individuals of the population (DE/rand/1/bin)
+*/
 
-	if (dataTrain != NULL && params->numOutputs != dataTrain->numOutputs) {
-		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", dataTrain->numOutputs, params->numOutputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
-	}
+static void setDETrialVector(struct parameters *params, struct DEChromosome **DEChromos, int NP, int i, int numWeights, double *trialVector, unsigned int * seed)
+{
+	int j, r1, r2, r3, jr;
+	double rj;
 
-	if (dataValid != NULL && params->numInputs != dataValid->numInputs) {
-		printf("Error: The number of inputs specified in the dataSet (%d) does not match the number of inputs specified in the parameters (%d).\n", dataValid->numInputs, params->numInputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
+	// select three random solutions
+	do
+	{
+		r1 = randInt(NP, seed);
 	}
+	while(r1 == i);
 
-	if (dataValid != NULL && params->numOutputs != dataValid->numOutputs) {
-		printf("Error: The number of outputs specified in the dataSet (%d) does not match the number of outputs specified in the parameters (%d).\n", dataValid->numOutputs, params->numOutputs);
-		printf("Terminating CGP-Library.\n");
-		exit(0);
+	do
+	{
+		r2 = randInt(NP, seed);
 	}
+	while(r2 == i || r2 == r1);
 
-	/* initialise parent chromosomes */
-	parentChromos = (struct chromosome**)malloc(params->mu * sizeof(struct chromosome*));
-	for (i = 0; i < params->mu; i++) 
+	do
 	{
-		parentChromos[i] = initialiseChromosome(params, seed);
-		setChromosomeFitness(params, parentChromos[i], dataTrain);
-		setChromosomeFitnessValidation(params, parentChromos[i], dataValid);
+		r3 = randInt(NP, seed);
 	}
+	while(r3 == i || r3 == r1 || r3 == r2);
 
-	/* initialise children chromosomes */
-	childrenChromos = (struct chromosome**)malloc(params->lambda * sizeof(struct chromosome*));
-	for (i = 0; i < params->lambda; i++) 
-	{
-		childrenChromos[i] = initialiseChromosome(params, seed);	
-	}	
+	// select a random component form solution i
+	jr = randInt(numWeights, seed);			
 
-	/* initialise best chromosomes */
-	bestChromo = initialiseChromosomeFromChromosome(parentChromos[0], seed);
-	setChromosomeFitnessValidation(params, bestChromo, dataValid);
+	// the crossover draws of every weight, held in the trial vector until each weight is set
+	randDecimals(trialVector, numWeights, seed);
 
-	/* determine the size of the Candidate Chromos based on the evolutionary Strategy */
-	if (params->evolutionaryStrategy == '+') 
+	// for each weight of the DEChromos[i]
+	for(j = 0; j < numWeights; j++)
 	{
-		numCandidateChromos = params->mu + params->lambda;
+		rj = trialVector[j];
+		
+		if(rj < params->CR || j == jr)
+		{
+			trialVector[j] = DEChromos[r3]->weightsVector[j] + params->F * (DEChromos[r1]->weightsVector[j] - DEChromos[r2]->weightsVector[j]);
+		}
+		else
+		{
+			trialVector[j] = DEChromos[i]->weightsVector[j];
+		}				
 	}
-	else if (params->evolutionaryStrategy == ',') 
+}
+
+/*
+	Transfers the weightsVector to the chromo and sets its fitness.
+	DE only changes the weights, so the active nodes are kept and only
+	the execution plan is rebuilt with the new weights.
+	Fitnesses greater than the cutoff are only bounds if a bounded
+	fitness function is set, DBL_MAX when the fitness must be exact.
+*/
+
+static void setDEChromosomeFitness(struct parameters *params, struct DEChromosome *DEChromo, struct dataSet *data, double cutoff)
+{
+	double start = (params->profile != NULL) ? getProfileClock() : 0;
+
+	transferWeightsVectorToChromo(params, DEChromo);
+	setChromosomeActiveNodes(DEChromo->chromo);
+	resetChromosome(DEChromo->chromo);
+
+	if (params->boundedFitnessFunction != NULL && cutoff != DBL_MAX)
 	{
-		numCandidateChromos = params->lambda;
+		DEChromo->chromo->fitness = params->boundedFitnessFunction(params, DEChromo->chromo, data, cutoff);
 	}
-	else 
+	else
 	{
-		printf("Error: the evolutionary strategy '%c' is not known.\nTerminating CGP-Library.\n", params->evolutionaryStrategy);
-		exit(0);
-	}	
+		DEChromo->chromo->fitness = params->fitnessFunction(params, DEChromo->chromo, data);
+	}
 
-	/* initialise the candidateChromos */
-	candidateChromos = (struct chromosome**)malloc(numCandidateChromos * sizeof(struct chromosome*));
-	for (i = 0; i < numCandidateChromos; i++) 
+	if (params->profile != NULL)
 	{
-		candidateChromos[i] = initialiseChromosome(params, seed);
+		addProfileEvaluation(params->profile, DEChromo->chromo, start);
 	}
+}
 
-	/* for each generation */
-	for (gen = 0; gen < numGens; gen++) 
-	{	
-		/* evaluate every children */
-		for (i = 0; i < params->lambda; i++) 
-		{
-			setChromosomeFitness(params, childrenChromos[i], dataTrain);
-			setChromosomeFitnessValidation(params, childrenChromos[i], dataValid);
-		}		
+/*
+	Transfer the weights from the weightsVector to the chromo structure
+*/
 
-		/* get best chromosome - validation set */
-		getBestChromosome(parentChromos, childrenChromos, params->mu, params->lambda, bestChromo);
+static void transferWeightsVectorToChromo(struct parameters *params, struct DEChromosome *DEChromo)
+{
+	int i, j, counter = 0;
+	struct node *n;
 
-		/*
-			Set the chromosomes which will be used by the selection scheme
-			dependant upon the evolutionary strategy. i.e. '+' all are used
-			by the selection scheme, ',' only the children are.
-		*/
-		if (params->evolutionaryStrategy == '+') 
+	// the weights of (nearly) every active node change
+	clearNodeCache(DEChromo->chromo);
+
+	// only the weights of the active connections are in the weightsVector
+	if (params->activeWeightsDE == 1)
+	{
+		for (i = 0; i < DEChromo->chromo->numActiveNodes; i++) 
 		{
-			/*
-				Note: the children are placed before the parents to
-				ensure 'new blood' is always selected over old if the
-				fitness are equal.
-			*/
+			n = DEChromo->chromo->nodes[DEChromo->chromo->activeNodes[i]];
 
-			for (i = 0; i < numCandidateChromos; i++) 
+			for (j = 0; j < n->actArity; j++) 
 			{
-				if (i < params->lambda) 
-				{
-					copyChromosome(candidateChromos[i], childrenChromos[i] );
-				}
-				else 
-				{
-					copyChromosome(candidateChromos[i], parentChromos[i - params->lambda] );
-				}
+				n->weights[j] = DEChromo->weightsVector[counter];
+				counter++;
 			}
 		}
-		else if (params->evolutionaryStrategy == ',') 
+	}
+	else
+	{
+	    //for every nodes in the chromosome
+		for (i = 0; i < DEChromo->chromo->numNodes; i++) 
 		{
-			for (i = 0; i < numCandidateChromos; i++) 
+			// for every input to each node
+			for (j = 0; j < DEChromo->chromo->arity; j++) 
 			{
-				copyChromosome(candidateChromos[i], childrenChromos[i] );
+				DEChromo->chromo->nodes[i]->weights[j] = DEChromo->weightsVector[counter];
+				counter++;
 			}
 		}
+	}
 
-		/* select the parents from the candidateChromos */
-		params->selectionScheme(params, parentChromos, candidateChromos, params->mu, numCandidateChromos);
-
-		/* create the children from the parents */
-		params->reproductionScheme(params, parentChromos, childrenChromos, params->mu, params->lambda, 1, seed); // Type 1: CGPDE (do NOT apply weight mutation here)
+	// the weights do not change the active nodes and so only the execution plan is rebuilt
+	if (DEChromo->chromo->activeNodesDirty == 0)
+	{
+		compileChromosome(DEChromo->chromo);
 	}
+}
 
-	/* run DE of the best individual (bestChromo) of the population with respect to the validation data to evolve weights */
+/*
+	Transfer the weights from the chromo structure to the weightsVector
+*/
 
-    struct chromosome ** populationChromos = runDE(params, bestChromo, dataTrain, dataValid, 2, seed); // Type 2: CGPDE-OUT 
+static void transferChromoToWeightsVector(struct parameters *params, struct DEChromosome *DEChromo)
+{
+	int i, j, counter = 0;
+	struct node *n;
 
-	/* free parent chromosomes */
-	for (i = 0; i < params->mu; i++) 
+	// only the weights of the active connections are in the weightsVector
+	if (params->activeWeightsDE == 1)
 	{
-		freeChromosome(parentChromos[i]);
+		for (i = 0; i < DEChromo->chromo->numActiveNodes; i++) 
+		{
+			n = DEChromo->chromo->nodes[DEChromo->chromo->activeNodes[i]];
+
+			for (j = 0; j < n->actArity; j++) 
+			{
+				DEChromo->weightsVector[counter] = n->weights[j];
+				counter++;
+			}
+		}
+
+		return;
 	}
-	free(parentChromos);
 
-	/* free children chromosomes */
-	for (i = 0; i < params->lambda; i++) 
+    //for every nodes in the chromosome
+	for (i = 0; i < DEChromo->chromo->numNodes; i++) 
 	{
-		freeChromosome(childrenChromos[i]);
+		// for every input to each node
+		for (j = 0; j < DEChromo->chromo->arity; j++) 
+		{
+			DEChromo->weightsVector[counter] = DEChromo->chromo->nodes[i]->weights[j];
+			counter++;
+		}
 	}
-	free(childrenChromos);
+}
 
-	/* free the used chromosomes and population */
-	for (i = 0; i < numCandidateChromos; i++) 
+/*
+	get the number of weights of a given chromo evolved by DE
+*/
+static int getNumChromosomeWeights(struct parameters *params, struct chromosome *chromo)
+{
+	int i;
+	int numWeights = 0;
+
+	// the used inputs of the active nodes
+	if (params->activeWeightsDE == 1)
 	{
-		freeChromosome(candidateChromos[i]);
-	}
-	free(candidateChromos);
+		for (i = 0; i < chromo->numActiveNodes; i++) 
+		{
+			numWeights += chromo->nodes[chromo->activeNodes[i]]->actArity;
+		}
 
-	freeChromosome(bestChromo);
+		return numWeights;
+	}
 
-	return populationChromos;
+	return (chromo->numNodes * chromo->arity);
 }
 
-
 /*
-	Run Differential Evolutionary (DE) algorithm to evolve weights of a given chromo
-	type = 1: CGPDE-IN
-	type = 2: CGPDE-OUT 
+	initialises an experiment of numRounds stratified 10-fold cross-validations
+	of the given dataSet. The rounds and runs are seeded as in the experiments
+	of the related paper and so give the same training, validation and testing sets
 */
-
-DLL_EXPORT struct chromosome ** runDE(struct parameters *params, struct chromosome *chromo, struct dataSet *dataTrain, struct dataSet *dataValid, int type, unsigned int * seed)
+DLL_EXPORT struct experiment *initialiseExperiment(struct parameters *params, struct dataSet *data, int numRounds, double percentage)
 {
-	int maxIter = 0;
-	int NP = 0;
-	if (type == 1) // IN
-	{
-		maxIter = params->maxIter_IN;
-		NP = params->NP_IN;
+	int i, j;
+	int run;
+	unsigned int seed;
+	int training_index[7];
+	int validation_index[2];
+	struct dataSet *reducedData;
+	struct experiment *experiment;
+
+	if (numRounds < 1) {
+		printf("Error: an experiment requires at least one round; %d is invalid.\nTerminating CGP-Library.\n", numRounds);
+		exit(0);
 	}
-	else if(type == 2) // OUT
-	{
-		maxIter = params->maxIter_OUT;
-		NP = params->NP_OUT;
+
+	if (params->numInputs != data->numInputs || params->numOutputs != data->numOutputs) {
+		printf("Error: The number of inputs and outputs specified in the dataSet (%d, %d) do not match those specified in the parameters (%d, %d).\n", data->numInputs, data->numOutputs, params->numInputs, params->numOutputs);
+		printf("Terminating CGP-Library.\n");
+		exit(0);
 	}
 
-	// initialise population
-	struct DEChromosome ** DEChromos = initialiseDEPopulation(params, chromo, dataTrain, type, seed);
+	experiment = (struct experiment*)malloc(sizeof(struct experiment));
 
-	// get weightsVector size
-	int numWeights = getNumChromosomeWeights(chromo);
+	experiment->params = params;
+	experiment->numRounds = numRounds;
+	experiment->numAlgorithms = 0;
+	experiment->saveDataSets = 0;
+	experiment->scoreFunction = NULL;
+	experiment->scoreName[0] = '\0';
 
-	// allocate memory for new solution u
-	struct DEChromosome * DEChromo_u = initialiseDEChromosome(params, chromo, dataTrain, seed);
+	experiment->folds = (struct dataSet***)malloc(numRounds * sizeof(struct dataSet**));
+	experiment->trainingData = (struct dataSet**)malloc(numRounds * 10 * sizeof(struct dataSet*));
+	experiment->validationData = (struct dataSet**)malloc(numRounds * 10 * sizeof(struct dataSet*));
+	experiment->testingData = (struct dataSet**)malloc(numRounds * 10 * sizeof(struct dataSet*));
+	experiment->seeds = (unsigned int*)malloc(numRounds * 10 * sizeof(unsigned int));
 
-	int t, i, j, r1, r2, r3, jr;
-	double rj;
+	/* the folds are copies of the samples and so every round is kept without the barrier of the next shuffle */
+	for (i = 0; i < numRounds; i++) {
 
-	// for each iteration
-	for(t = 0; t < maxIter; t++)
-	{
-		// for each DEChromos individual
-		for(i = 0; i < NP; i++)
-		{
-			// select three random solutions
-			do
-			{
-				r1 = randInt(NP, seed);
-			}
-			while(r1 == i);
+		seed = i + 50;
+		shuffleData(data, &seed);
+		reducedData = reduceSampleSize(data, percentage);
+		experiment->folds[i] = generateFolds(reducedData);
 
-			do
-			{
-				r2 = randInt(NP, seed);
-			}
-			while(r2 == i || r2 == r1);
+		if (reducedData != data) {
+			freeDataSet(reducedData);
+		}
 
-			do
-			{
-				r3 = randInt(NP, seed);
-			}
-			while(r3 == i || r3 == r1 || r3 == r2);
+		/* the sets of each run are views of the folds */
+		for (j = 0; j < 10; j++) {
 
-			// select a random component form solution i
-			jr = randInt(numWeights, seed);			
+			run = (i * 10) + j;
+			seed = run + 5;
+			getIndex(training_index, validation_index, j, &seed);
 
-			// for each weight of the DEChromos[i]
-			for(j = 0; j < numWeights; j++)
-			{
-				rj = randDecimal(seed);
-				
-				if(rj < params->CR || j == jr)
-				{
-					DEChromo_u->weightsVector[j] = DEChromos[r3]->weightsVector[j] + params->F * (DEChromos[r1]->weightsVector[j] - DEChromos[r2]->weightsVector[j]);
-				}
-				else
-				{
-					DEChromo_u->weightsVector[j] = DEChromos[i]->weightsVector[j];
-				}				
-			}
+			experiment->trainingData[run] = getTrainingDataView(experiment->folds[i], training_index);
+			experiment->validationData[run] = getValidationDataView(experiment->folds[i], validation_index);
+			experiment->testingData[run] = getTestingDataView(experiment->folds[i], j);
+			experiment->seeds[run] = seed;
+		}
+	}
 
-			// tranfer weightsVector to chromo and evaluate fitness
-    		transferWeightsVectorToChromo(params, DEChromo_u);
-    		setChromosomeFitness(params, DEChromo_u->chromo, dataTrain);
+	return experiment;
+}
 
-    		// get fitness of both chromos
-    		double fit_u = getChromosomeFitness(DEChromo_u->chromo);
-    		double fit_s = getChromosomeFitness(DEChromos[i]->chromo);
 
-    		if(fit_u <= fit_s)
-    		{
-    			copyChromosome(DEChromos[i]->chromo, DEChromo_u->chromo);
-    			memcpy(DEChromos[i]->weightsVector, DEChromo_u->weightsVector, numWeights*sizeof(double));
-    		}
-			
-		}
+/*
+	frees an experiment, its folds and the sets of its runs
+*/
+DLL_EXPORT void freeExperiment(struct experiment *experiment)
+{
+	int i, j;
+
+	/* attempting to prevent double free errors */
+	if (experiment == NULL) {
+		return;
 	}
 
-	struct chromosome ** populationChromos = (struct chromosome**)malloc(NP*sizeof(struct chromosome*));
+	for (i = 0; i < experiment->numRounds * 10; i++) {
+		freeDataSet(experiment->trainingData[i]);
+		freeDataSet(experiment->validationData[i]);
+		freeDataSet(experiment->testingData[i]);
+	}
 
-	// fill populationChromos and free DEChromosome population
-	for(i = 0; i < NP; i++)
-	{
-		populationChromos[i] = initialiseChromosomeFromChromosome(DEChromos[i]->chromo, seed);
-		freeDEChromosome(DEChromos[i]);
+	for (i = 0; i < experiment->numRounds; i++) {
+		for (j = 0; j < 10; j++) {
+			freeDataSet(experiment->folds[i][j]);
+		}
+		free(experiment->folds[i]);
 	}
-	free(DEChromos);
-	freeDEChromosome(DEChromo_u);	
 
-	return populationChromos;
+	free(experiment->folds);
+	free(experiment->trainingData);
+	free(experiment->validationData);
+	free(experiment->testingData);
+	free(experiment->seeds);
+	free(experiment);
 }
 
 
 /*
-	Among the population of chromosomes returned by D.E., this function gets the best chromo.
-	typeCGPDE = 1: CGPDE-IN 
-	typeCGPDE = 2: CGPDE-OUT-T
-	typeCGPDE = 3: CGPDE-OUT-V
+	adds "CGPANN", "CGPDE-IN" or "CGPDE-OUT" to the algorithms run on every fold
+	of the experiment. CGPDE-OUT gives the results of both CGPDE-OUT-T and CGPDE-OUT-V
 */
-
-DLL_EXPORT struct chromosome * getBestDEChromosome(struct parameters *params, struct chromosome ** chromos, struct dataSet * dataValid, int typeCGPDE, unsigned int * seed)
+DLL_EXPORT void addExperimentAlgorithm(struct experiment *experiment, char const *algorithm, int numGens)
 {
-	int NP = 0;
-	if (typeCGPDE == 1) // IN
-	{
-		NP = params->NP_IN;
-	}
-	else if(typeCGPDE == 2 || typeCGPDE == 3) // OUT-T or OUT-V
-	{
-		NP = params->NP_OUT;
-	}
+	static const char *algorithmNames[EXPERIMENTNUMALGORITHMS] = {"CGPANN", "CGPDE-IN", "CGPDE-OUT"};
 
 	int i;
-	if(typeCGPDE == 3) // OUT-V
-	{
-		for(i = 0; i < NP; i++) // evaluate validation set accuracy of the NP chromos
-		{
-			setChromosomeFitnessValidation(params, chromos[i], dataValid);
+	int type = -1;
+
+	for (i = 0; i < EXPERIMENTNUMALGORITHMS; i++) {
+		if (strcmp(algorithm, algorithmNames[i]) == 0) {
+			type = i;
 		}
 	}
-	
-	struct chromosome * best = initialiseChromosomeFromChromosome(chromos[0], seed);
-	struct chromosome *bestChromoSoFar;
-	bestChromoSoFar = chromos[0];
 
-	for (i = 1; i < NP; i++) 
-	{
-		if ( (typeCGPDE == 1 || typeCGPDE == 2) && chromos[i]->fitness < bestChromoSoFar->fitness ) // IN or OUT-T
-		{
-			bestChromoSoFar = chromos[i];
-		}
-		else if ( typeCGPDE == 3 && chromos[i]->fitnessValidation < bestChromoSoFar->fitnessValidation ) // OUT-V
-		{
-			bestChromoSoFar = chromos[i];
+	if (type == -1) {
+		printf("Warning: '%s' is not a known algorithm. Valid algorithms are CGPANN, CGPDE-IN and CGPDE-OUT. The algorithm has not been added.\n", algorithm);
+		return;
+	}
+
+	if (numGens < 0) {
+		printf("Warning: %d generations is invalid. The number of generations must be >= 0. %s has not been added.\n", numGens, algorithm);
+		return;
+	}
+
+	for (i = 0; i < experiment->numAlgorithms; i++) {
+		if (experiment->algorithms[i] == type) {
+			printf("Warning: %s has already been added to the experiment. The number of generations is left unchanged as %d.\n", algorithm, experiment->numGens[type]);
+			return;
 		}
 	}
 
-	copyChromosome(best, bestChromoSoFar);
-	return best;
+	experiment->algorithms[experiment->numAlgorithms] = type;
+	experiment->numGens[type] = numGens;
+	experiment->numAlgorithms++;
 }
 
+
 /*
-	Initialise DE Population, keeping the weights of the original chromosome, and changing the weights of the remaining ones.
-	Topology is NOT changed!
-	type = 1: CGPDE-IN
-	type = 2: CGPDE-OUT 
+	sets whether the training, validation and testing sets of each run are saved
 */
+DLL_EXPORT void setExperimentSaveDataSets(struct experiment *experiment, int saveDataSets)
+{
+	if (saveDataSets != 0 && saveDataSets != 1) {
+		printf("Warning: saving the dataSets of an experiment can only be 0 (no) or 1 (yes); %d is invalid. It is left unchanged as %d.\n", saveDataSets, experiment->saveDataSets);
+		return;
+	}
 
-DLL_EXPORT struct DEChromosome ** initialiseDEPopulation(struct parameters *params, struct chromosome *chromo, struct dataSet *data, int type, unsigned int * seed)
+	experiment->saveDataSets = saveDataSets;
+}
+
+
+/*
+	sets the function giving the result of each run on its testing set. If
+	scoreFunction is NULL the fitness function of the parameters is used
+*/
+DLL_EXPORT void setExperimentScoreFunction(struct experiment *experiment, double (*scoreFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *data), char const *scoreName)
 {
-	int NP = 0;
-	if (type == 1) // IN
-	{
-		NP = params->NP_IN;
+	experiment->scoreFunction = scoreFunction;
+
+	if (scoreFunction == NULL) {
+		experiment->scoreName[0] = '\0';
 	}
-	else if(type == 2) // OUT
-	{
-		NP = params->NP_OUT;
+	else {
+		snprintf(experiment->scoreName, FITNESSFUNCTIONNAMELENGTH, "%s", scoreName);
 	}
+}
 
-	int numWeights = getNumChromosomeWeights(chromo);
 
-	// allocate memory for DEChromosome array
-	struct DEChromosome **DEChromos = (struct DEChromosome**) malloc( NP * sizeof(struct DEChromosome*) );   
+/*
+	runs every (round, fold, algorithm) job of the experiment on one pool of
+	params->numThreads threads and writes each result as soon as it is known.
+	The most costly jobs are started first so that the pool stays busy until the end
+*/
+DLL_EXPORT void runExperiment(struct experiment *experiment, char const *directory)
+{
+	static const char *resultsFileNames[EXPERIMENTNUMALGORITHMS + 1] = {"cgpann.txt", "cgpde_in.txt", "cgpde_out_t.txt", "cgpde_out_v.txt"};
 
 	int i, j;
-    for(i = 0; i < NP; i++) 
-    {
-    	// allocate memory for DEChromos[i]
-    	DEChromos[i] = (struct DEChromosome*) malloc(sizeof(struct DEChromosome));
+	int numJobs;
+	char fileName[FILENAME_MAX];
+	char const *scoreName;
+	FILE *resultsFiles[EXPERIMENTNUMALGORITHMS + 1] = {NULL, NULL, NULL, NULL};
+	struct experimentJob *jobs;
 
-    	// allocate memory for weightsVector
-        DEChromos[i]->weightsVector = (double *) malloc( numWeights * sizeof(double) );
+	scoreName = experiment->scoreFunction == NULL ? experiment->params->fitnessFunctionName : experiment->scoreName;
 
-        // allocate memory for chromo
-        DEChromos[i]->chromo = initialiseChromosomeFromChromosome(chromo, seed);
-    }
+	/* open the results files of the added algorithms, CGPDE-OUT having one for each version */
+	for (i = 0; i < experiment->numAlgorithms; i++) {
+		for (j = experiment->algorithms[i]; j <= experiment->algorithms[i] + (experiment->algorithms[i] == 2); j++) {
 
-    // keep the original chromo!
-    int counter = 0;
-    for (i = 0; i < DEChromos[0]->chromo->numNodes; i++) 
-	{
-		// for each input to each node
-		for (j = 0; j < DEChromos[0]->chromo->arity; j++) 
-		{
-			DEChromos[0]->weightsVector[counter] = chromo->nodes[i]->weights[j];
-			counter++;
+			snprintf(fileName, FILENAME_MAX, "%s/%s", directory, resultsFileNames[j]);
+			resultsFiles[j] = fopen(fileName, "w");
+
+			if (resultsFiles[j] == NULL) {
+				printf("Error: the results file '%s' could not be opened.\nTerminating CGP-Library.\n", fileName);
+				exit(0);
+			}
+
+			fprintf(resultsFiles[j], "i,\tj,\t%s\n", scoreName);
+			fflush(resultsFiles[j]);
 		}
 	}
-	setChromosomeFitness(params, DEChromos[0]->chromo, data);
 
-    // assign random weights for the remaining of the chromosomes of the population
-    for(i = 1; i < NP; i++) 
-    {
-    	for(j = 0; j < numWeights; j++)
-    	{
-    		DEChromos[i]->weightsVector[j] = getRandomConnectionWeight(params->connectionWeightRange, seed); 
-    	}
+	if (experiment->saveDataSets == 1) {
+		for (i = 0; i < experiment->numRounds * 10; i++) {
+			saveExperimentDataSet(experiment->trainingData[i], directory, "TRN", i / 10, i % 10);
+			saveExperimentDataSet(experiment->validationData[i], directory, "VLD", i / 10, i % 10);
+			saveExperimentDataSet(experiment->testingData[i], directory, "TST", i / 10, i % 10);
+		}
+	}
 
-    }
+	numJobs = experiment->numRounds * 10 * experiment->numAlgorithms;
+	jobs = (struct experimentJob*)malloc(numJobs * sizeof(struct experimentJob));
 
-    // transfer weightsVector to chromo and evaluate fitness
-    for(i = 1; i < NP; i++)
-    {
-    	transferWeightsVectorToChromo(params, DEChromos[i]);
-    	setChromosomeFitness(params, DEChromos[i]->chromo, data);
+	for (i = 0; i < experiment->numRounds * 10; i++) {
+		for (j = 0; j < experiment->numAlgorithms; j++) {
+			jobs[(i * experiment->numAlgorithms) + j].run = i;
+			jobs[(i * experiment->numAlgorithms) + j].algorithm = experiment->algorithms[j];
+			jobs[(i * experiment->numAlgorithms) + j].cost = getExperimentJobCost(experiment->params, experiment->algorithms[j], experiment->numGens[experiment->algorithms[j]]);
+		}
 	}
 
-    return DEChromos;
+	qsort(jobs, numJobs, sizeof(struct experimentJob), cmpExperimentJob);
+
+	/* each free thread takes the next job; the parallel regions within a job are then run by its thread alone */
+	#pragma omp parallel for default(none), private(i), shared(experiment,jobs,numJobs,resultsFiles), schedule(dynamic,1), num_threads(experiment->params->numThreads)
+	for (i = 0; i < numJobs; i++) {
+		runExperimentJob(experiment, &jobs[i], resultsFiles);
+	}
+
+	for (i = 0; i < EXPERIMENTNUMALGORITHMS + 1; i++) {
+		if (resultsFiles[i] != NULL) {
+			fclose(resultsFiles[i]);
+		}
+	}
+
+	free(jobs);
 }
 
+
 /*
-	Initialise a DEChromosome struct
+	estimates the number of chromosome evaluations of a job. Only the order
+	of the costs is used, to start the longest jobs first
 */
-
-DLL_EXPORT struct DEChromosome * initialiseDEChromosome(struct parameters *params, struct chromosome *chromo, struct dataSet *data, unsigned int * seed)
+static double getExperimentJobCost(struct parameters *params, int algorithm, int numGens)
 {
-	int numWeights = getNumChromosomeWeights(chromo);
+	double cost = (double)numGens * params->lambda;
 
-	// allocate memory for DEChromosome array
-	struct DEChromosome *DEChromo = (struct DEChromosome*) malloc( sizeof(struct DEChromosome) );   
+	/* every generation of CGPDE-IN also runs DE on its best child */
+	if (algorithm == 1) {
+		cost += (double)numGens * params->NP_IN * (params->maxIter_IN + 1);
+	}
+	else if (algorithm == 2) {
+		cost += (double)params->NP_OUT * (params->maxIter_OUT + 1);
+	}
 
-	int i;
-    // allocate memory for weightsVector
-    DEChromo->weightsVector = (double *) malloc( numWeights * sizeof(double) );
+	return cost;
+}
 
-    // allocate memory for chromo
-    DEChromo->chromo = initialiseChromosomeFromChromosome(chromo, seed);
 
-    // assign random weights for the population
-    for(i = 0; i < numWeights; i++)
-    {
-    	DEChromo->weightsVector[i] = getRandomConnectionWeight(params->connectionWeightRange, seed);
-    }
+/*
+	orders the jobs of an experiment by decreasing cost and then by run and algorithm
+*/
+static int cmpExperimentJob(const void *a, const void *b)
+{
+	const struct experimentJob *jobA = (const struct experimentJob*)a;
+	const struct experimentJob *jobB = (const struct experimentJob*)b;
 
-    // transfer weightsVector to chromo and evaluate fitness
-    transferWeightsVectorToChromo(params, DEChromo);
-    setChromosomeFitness(params, DEChromo->chromo, data);
+	if (jobA->cost != jobB->cost) {
+		return jobA->cost < jobB->cost ? 1 : -1;
+	}
 
-    return DEChromo;
+	if (jobA->run != jobB->run) {
+		return jobA->run - jobB->run;
+	}
+
+	return jobA->algorithm - jobB->algorithm;
 }
 
+
 /*
-	Transfer the weights from the weightsVector to the chromo structure
+	runs one algorithm on one fold and writes its results. Each algorithm
+	offsets the seed of the run, so a result does not depend on the other
+	algorithms of the experiment or on the order in which the jobs are taken
 */
-
-static void transferWeightsVectorToChromo(struct parameters *params, struct DEChromosome *DEChromo)
+static void runExperimentJob(struct experiment *experiment, struct experimentJob *job, FILE **resultsFiles)
 {
-	int i, j, counter = 0;
-    //for every nodes in the chromosome
-	for (i = 0; i < DEChromo->chromo->numNodes; i++) 
+	static const char *resultNames[EXPERIMENTNUMALGORITHMS + 1] = {"CGPANN", "CGPDE-IN", "CGPDE-OUT-T", "CGPDE-OUT-V"};
+
+	int i;
+	int numResults = 1;
+	double results[2];
+	unsigned int seed;
+	struct parameters *params = experiment->params;
+	struct dataSet *trainingData = experiment->trainingData[job->run];
+	struct dataSet *validationData = experiment->validationData[job->run];
+	struct dataSet *testingData = experiment->testingData[job->run];
+	struct chromosome *bestChromos[2];
+	struct chromosome **populationChromos;
+
+	seed = experiment->seeds[job->run] + (unsigned int)job->algorithm * 0x9E3779B9u;
+
+	/* CGPDE-OUT evolves the weights of one population for both of its versions */
+	if (job->algorithm == 0) {
+		bestChromos[0] = runCGP(params, trainingData, validationData, experiment->numGens[0], &seed);
+	}
+	else if (job->algorithm == 1) {
+		bestChromos[0] = runCGPDE_IN(params, trainingData, validationData, experiment->numGens[1], &seed);
+	}
+	else {
+		populationChromos = runCGPDE_OUT(params, trainingData, validationData, experiment->numGens[2], &seed);
+
+		bestChromos[0] = getBestDEChromosome(params, populationChromos, validationData, 2, &seed);
+		bestChromos[1] = getBestDEChromosome(params, populationChromos, validationData, 3, &seed);
+		numResults = 2;
+
+		for (i = 0; i < params->NP_OUT; i++) {
+			freeChromosome(populationChromos[i]);
+		}
+		free(populationChromos);
+	}
+
+	for (i = 0; i < numResults; i++) {
+
+		if (experiment->scoreFunction == NULL) {
+			setChromosomeFitness(params, bestChromos[i], testingData);
+			results[i] = bestChromos[i]->fitness;
+		}
+		else {
+			setChromosomeActiveNodes(bestChromos[i]);
+			resetChromosome(bestChromos[i]);
+			results[i] = experiment->scoreFunction(params, bestChromos[i], testingData);
+		}
+
+		freeChromosome(bestChromos[i]);
+	}
+
+	#pragma omp critical(experimentResults)
 	{
-		// for every input to each node
-		for (j = 0; j < DEChromo->chromo->arity; j++) 
-		{
-			DEChromo->chromo->nodes[i]->weights[j] = DEChromo->weightsVector[counter];
-			counter++;
+		for (i = 0; i < numResults; i++) {
+			printf("%s\t%s%d\t%d\t%.4lf\n", resultNames[job->algorithm + i], strlen(resultNames[job->algorithm + i]) < 8 ? "\t" : "", job->run / 10, job->run % 10, results[i]);
+
+			fprintf(resultsFiles[job->algorithm + i], "%d,\t%d,\t%.4f\n", job->run / 10, job->run % 10, results[i]);
+			fflush(resultsFiles[job->algorithm + i]);
 		}
 	}
 }
 
+
 /*
-	get the number of weights of a given chromo
+	saves one set of a run of an experiment as <directory>/<set>/<set>_<round>_<fold>.bin
 */
-static int getNumChromosomeWeights(struct chromosome *chromo)
+static void saveExperimentDataSet(struct dataSet *data, char const *directory, char const *set, int round, int fold)
 {
-	return (chromo->numNodes * chromo->arity);
+	char fileName[FILENAME_MAX];
+
+	snprintf(fileName, FILENAME_MAX, "%s/%s/%s_%d_%d.bin", directory, set, set, round, fold);
+	saveDataSetBinary(data, fileName);
 }
 
 /*
@@ -4716,6 +10207,64 @@ static void copyFunctionSet(struct functionSet *funcSetDest, struct functionSet
 }
 
 
+/*
+	adds a reference to the given function set and returns it.
+	Function sets are shared by the parameters and the chromosomes
+	initialised from them, and are freed once no longer referenced.
+*/
+static struct functionSet *retainFunctionSet(struct functionSet *funcSet) {
+
+	#pragma omp atomic
+	funcSet->refCount++;
+
+	return funcSet;
+}
+
+
+/*
+	removes a reference to the given function set, freeing it if it
+	was the last one
+*/
+static void releaseFunctionSet(struct functionSet *funcSet) {
+
+	int refCount;
+
+	#pragma omp atomic capture
+	refCount = --funcSet->refCount;
+
+	if (refCount == 0) {
+		free(funcSet);
+	}
+}
+
+
+/*
+	returns the function set of the given parameters for modification.
+	If chromosomes also reference it, the parameters are first given their
+	own copy so that the function set of those chromosomes is not changed.
+*/
+static struct functionSet *getWritableFunctionSet(struct parameters *params) {
+
+	struct functionSet *funcSet;
+	int refCount;
+
+	#pragma omp atomic read
+	refCount = params->funcSet->refCount;
+
+	if (refCount > 1) {
+
+		funcSet = (struct functionSet*)malloc(sizeof(struct functionSet));
+		copyFunctionSet(funcSet, params->funcSet);
+		funcSet->refCount = 1;
+
+		releaseFunctionSet(params->funcSet);
+		params->funcSet = funcSet;
+	}
+
+	return params->funcSet;
+}
+
+
 /*
 	copys the contents from the src node into dest node.
 */
@@ -4782,23 +10331,94 @@ static void selectFittest(struct parameters *params, struct chromosome **parents
 }
 
 
+/*
+	Selects the parents of the next generation from the children, and also
+	from the parents when using the '+' evolutionary strategy.
+
+	With the default selection and reproduction schemes no chromosome is
+	copied: the parents and children are ranked in rankedChromos, which
+	holds mu + lambda pointers, and the parents and children arrays take
+	ownership of the ranked chromosomes. The fittest become the parents and
+	the rest become the children, which mutateRandomParent overwrites.
+	Otherwise the candidates are copied into candidateChromos and given to
+	the selection scheme.
+*/
+static void selectParents(struct parameters *params, struct chromosome **parents, struct chromosome **children, struct chromosome **candidateChromos, struct chromosome **rankedChromos, int numCandidateChromos) {
+
+	int i;
+
+	if (params->selectionScheme == selectFittest && params->reproductionScheme == mutateRandomParent) {
+
+		/*
+			Note: the children are placed before the parents to
+			ensure 'new blood' is always selected over old if the
+			fitness are equal. With ',' only the children are ranked.
+		*/
+		for (i = 0; i < params->lambda; i++) {
+			rankedChromos[i] = children[i];
+		}
+
+		for (i = 0; i < params->mu; i++) {
+			rankedChromos[params->lambda + i] = parents[i];
+		}
+
+		sortChromosomeArray(rankedChromos, numCandidateChromos);
+
+		for (i = 0; i < params->mu; i++) {
+			parents[i] = rankedChromos[i];
+		}
+
+		for (i = 0; i < params->lambda; i++) {
+			children[i] = rankedChromos[params->mu + i];
+		}
+
+		return;
+	}
+
+	/*
+		Set the chromosomes which will be used by the selection scheme
+		dependant upon the evolutionary strategy. i.e. '+' all are used
+		by the selection scheme, ',' only the children are.
+	*/
+	if (params->evolutionaryStrategy == '+') {
+
+		/*
+			Note: the children are placed before the parents to
+			ensure 'new blood' is always selected over old if the
+			fitness are equal.
+		*/
+
+		for (i = 0; i < numCandidateChromos; i++) {
+
+			if (i < params->lambda) {
+				copyChromosome(candidateChromos[i], children[i] );
+			}
+			else {
+				copyChromosome(candidateChromos[i], parents[i - params->lambda] );
+			}
+		}
+	}
+	else if (params->evolutionaryStrategy == ',') {
+
+		for (i = 0; i < numCandidateChromos; i++) {
+			copyChromosome(candidateChromos[i], children[i] );
+		}
+	}
+
+	/* select the parents from the candidateChromos */
+	params->selectionScheme(params, parents, candidateChromos, params->mu, numCandidateChromos);
+}
+
+
 
 /*
-	returns a pointer to an initialised node. Initialised means that necessary
-	memory has been allocated and values set.
+	sets random genes for the given node, whose inputs and weights arrays
+	are already allocated as part of its chromosome's memory block
 */
-static struct node *initialiseNode(int numInputs, int numNodes, int arity, int numFunctions, double connectionWeightRange, double recurrentConnectionProbability, int nodePosition, unsigned int * seed) {
+static void initialiseNode(struct node *n, int numInputs, int numNodes, int arity, int numFunctions, double connectionWeightRange, double recurrentConnectionProbability, int nodePosition, unsigned int * seed) {
 
-	struct node *n;
 	int i;
 
-	/* allocate memory for node */
-	n = (struct node*)malloc(sizeof(struct node));
-
-	/* allocate memory for the node's inputs and connection weights */
-	n->inputs = (int*)malloc(arity * sizeof(int));
-	n->weights = (double*)malloc(arity * sizeof(double));
-
 	/* set the node's function */
 	n->function = getRandomFunction(numFunctions, seed);
 
@@ -4811,30 +10431,8 @@ static struct node *initialiseNode(int numInputs, int numNodes, int arity, int n
 		n->weights[i] = getRandomConnectionWeight(connectionWeightRange, seed);
 	}
 
-	/* set the output of the node to zero*/
-	n->output = 0;
-
 	/* set the arity of the node */
 	n->maxArity = arity;
-
-	return n;
-}
-
-
-/*
-	Free memory associated with given node
-*/
-static void freeNode(struct node *n) {
-
-	/* attempt to prevent user double freeing */
-	if (n == NULL) {
-		printf("Warning: double freeing of node prevented.\n");
-		return;
-	}
-
-	free(n->inputs);
-	free(n->weights);
-	free(n);
 }
 
 /*
@@ -5352,6 +10950,274 @@ static double sumWeigtedInputs(const int numInputs, const double *inputs, const
 
 
 
+/*
+	Block form of sumWeigtedInputs. Sets the sum of the weighted inputs for
+	each sample in the block. The inputs of each sample are summed in the
+	same order as sumWeigtedInputs so that the results are identical.
+*/
+static void sumWeigtedInputsBlock(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs) {
+
+	int i, s;
+	const double *inputs;
+	double weight;
+
+	for (s = 0; s < numSamples; s++) {
+		blockOutputs[s] = 0;
+	}
+
+	for (i = 0; i < numInputs; i++) {
+
+		inputs = blockValues + (inputSlots[i] * BATCHBLOCKSIZE);
+		weight = connectionWeights[i];
+
+		#pragma omp simd
+		for (s = 0; s < numSamples; s++) {
+			blockOutputs[s] += (inputs[s] * weight);
+		}
+	}
+}
+
+
+/*
+	Block form of the sigmoid node function
+*/
+static void _sigmoidBlock(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs) {
+
+	int s;
+
+	sumWeigtedInputsBlock(numSamples, numInputs, inputSlots, connectionWeights, blockValues, blockOutputs);
+
+	#pragma omp simd
+	for (s = 0; s < numSamples; s++) {
+		blockOutputs[s] = 1 / (1 + exp(-blockOutputs[s]));
+	}
+}
+
+
+/*
+	Block form of the Gaussian node function
+*/
+static void _gaussianBlock(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs) {
+
+	int s;
+
+	int centre = 0;
+	int width = 1;
+
+	sumWeigtedInputsBlock(numSamples, numInputs, inputSlots, connectionWeights, blockValues, blockOutputs);
+
+	#pragma omp simd
+	for (s = 0; s < numSamples; s++) {
+		blockOutputs[s] = exp(-(pow(blockOutputs[s] - centre, 2)) / (2 * pow(width, 2)));
+	}
+}
+
+
+/*
+	Block form of the step node function
+*/
+static void _stepBlock(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs) {
+
+	int s;
+
+	sumWeigtedInputsBlock(numSamples, numInputs, inputSlots, connectionWeights, blockValues, blockOutputs);
+
+	#pragma omp simd
+	for (s = 0; s < numSamples; s++) {
+		blockOutputs[s] = (blockOutputs[s] < 0) ? 0 : 1;
+	}
+}
+
+
+/*
+	Block form of the softsign node function
+*/
+static void _softsignBlock(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs) {
+
+	int s;
+
+	sumWeigtedInputsBlock(numSamples, numInputs, inputSlots, connectionWeights, blockValues, blockOutputs);
+
+	#pragma omp simd
+	for (s = 0; s < numSamples; s++) {
+		blockOutputs[s] = blockOutputs[s] / (1 + fabs(blockOutputs[s]));
+	}
+}
+
+
+/*
+	Block form of the tanh node function
+*/
+static void _hyperbolicTangentBlock(const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs) {
+
+	int s;
+
+	sumWeigtedInputsBlock(numSamples, numInputs, inputSlots, connectionWeights, blockValues, blockOutputs);
+
+	#pragma omp simd
+	for (s = 0; s < numSamples; s++) {
+		blockOutputs[s] = tanh(blockOutputs[s]);
+	}
+}
+
+
+#pragma omp declare target
+
+/*
+	returns the given activation of the sum of weighted inputs as computed
+	by the fast evaluator. exp is approximated by fastExp and, as the
+	activations are bounded, only NANs need be dealt with.
+*/
+static double getFastActivation(const int activation, const double weightedInputSum) {
+
+	double out;
+
+	switch (activation) {
+
+		case ACTIVATIONSIGMOID:
+			out = 1 / (1 + fastExp(-weightedInputSum));
+			break;
+
+		case ACTIVATIONHYPERBOLICTANGENT:
+			out = 1 - 2 / (fastExp(2 * weightedInputSum) + 1);
+			break;
+
+		case ACTIVATIONSOFTSIGN:
+			out = weightedInputSum / (1 + fabs(weightedInputSum));
+			break;
+
+		default:
+			out = fastExp(-(weightedInputSum * weightedInputSum) / 2);
+			break;
+	}
+
+	/* deal with doubles becoming NAN */
+	if (isnan(weightedInputSum) != 0 || isnan(out) != 0) {
+		out = 0;
+	}
+
+	return out;
+}
+
+/*
+	executes one sample of a plan packed by executeChromosomesOffload,
+	the inputs being read from the column-major copy of a dataSet. Gives
+	the same outputs as executeChromosome using the fast evaluator.
+*/
+static void executeOffloadSample(const int numInputs, const int numOutputs, const int arity, const int numActive, const int activation, const int *planArity, const int *planSlots, const int *planInputs, const double *planWeights, const int *outputNodes, const double *columns, const int numSamples, double *values, double *outputs) {
+
+	int i, j;
+	double sum;
+
+	for (j = 0; j < numInputs; j++) {
+		values[j] = columns[j * numSamples];
+	}
+
+	for (i = 0; i < numActive; i++) {
+
+		sum = 0;
+
+		for (j = 0; j < planArity[i]; j++) {
+			sum += (values[planInputs[(i * arity) + j]] * planWeights[(i * arity) + j]);
+		}
+
+		values[planSlots[i]] = getFastActivation(activation, sum);
+	}
+
+	for (i = 0; i < numOutputs; i++) {
+		outputs[i] = values[outputNodes[i]];
+	}
+}
+
+
+#pragma omp end declare target
+
+
+/*
+	Block form of getFastActivation
+*/
+static void getFastActivationBlock(const int activation, const int numSamples, const int numInputs, const int *inputSlots, const double *connectionWeights, const double *blockValues, double *blockOutputs) {
+
+	int s;
+	double out;
+
+	sumWeigtedInputsBlock(numSamples, numInputs, inputSlots, connectionWeights, blockValues, blockOutputs);
+
+	switch (activation) {
+
+		case ACTIVATIONSIGMOID:
+			#pragma omp simd private(out)
+			for (s = 0; s < numSamples; s++) {
+				out = 1 / (1 + fastExp(-blockOutputs[s]));
+				blockOutputs[s] = (isnan(blockOutputs[s]) != 0) ? 0 : out;
+			}
+			break;
+
+		case ACTIVATIONHYPERBOLICTANGENT:
+			#pragma omp simd private(out)
+			for (s = 0; s < numSamples; s++) {
+				out = 1 - 2 / (fastExp(2 * blockOutputs[s]) + 1);
+				blockOutputs[s] = (isnan(blockOutputs[s]) != 0) ? 0 : out;
+			}
+			break;
+
+		case ACTIVATIONSOFTSIGN:
+			#pragma omp simd private(out)
+			for (s = 0; s < numSamples; s++) {
+				out = blockOutputs[s] / (1 + fabs(blockOutputs[s]));
+				blockOutputs[s] = (isnan(out) != 0) ? 0 : out;
+			}
+			break;
+
+		default:
+			#pragma omp simd private(out)
+			for (s = 0; s < numSamples; s++) {
+				out = fastExp(-(blockOutputs[s] * blockOutputs[s]) / 2);
+				blockOutputs[s] = (isnan(blockOutputs[s]) != 0) ? 0 : out;
+			}
+			break;
+	}
+}
+
+
+/*
+	approximation of exp with a relative error below 1e-8. x is reduced
+	to r = x - n * ln(2) with |r| <= ln(2) / 2, exp(r) approximated by
+	its Taylor polynomial of degree seven and scaled by 2^n. x is clamped
+	to [-708,708] so that 2^n is a normal double, NANs becoming 708. There
+	are no branches, and only quiet comparisons, so that loops calling
+	fastExp can be vectorised.
+*/
+#pragma omp declare target
+static inline double fastExp(double x) {
+
+	/* adding 1.5 * 2^52 rounds to the nearest integer, held in the low bits of the sum */
+	const double shifter = 6755399441055744.0;
+
+	double t, n, r, p, scale;
+	int64_t bits;
+
+	x = isless(x, 708) ? x : 708;
+	x = isgreater(x, -708) ? x : -708;
+
+	t = (x * 1.4426950408889634) + shifter;
+	n = t - shifter;
+
+	/* ln(2) split in two so that n * 0.693145751953125 is exact */
+	r = (x - (n * 0.693145751953125)) - (n * 1.4286068203094172e-6);
+
+	p = 1 + r * (1 + r * (1.0 / 2 + r * (1.0 / 6 + r * (1.0 / 24 + r * (1.0 / 120 + r * (1.0 / 720 + r * (1.0 / 5040)))))));
+
+	/* 2^n from the exponent bits */
+	memcpy(&bits, &t, sizeof(double));
+	bits = (bits - 0x4338000000000000LL + 1023) << 52;
+	memcpy(&scale, &bits, sizeof(double));
+
+	return p * scale;
+}
+#pragma omp end declare target
+
+
 /*
 	The default fitness function used by CGP-Library.
 	Simply assigns an error of the sum of the absolute differences between the target and actual outputs for all outputs over all samples
@@ -5360,6 +11226,8 @@ static double supervisedLearning(struct parameters *params, struct chromosome *c
 
 	int i, j;
 	double error = 0;
+	double *outputs;
+	struct dataSet *chunkData;
 
 	/* error checking */
 	if (getNumChromosomeInputs(chromo) != getNumDataSetInputs(data)) {
@@ -5374,31 +11242,195 @@ static double supervisedLearning(struct parameters *params, struct chromosome *c
 		exit(0);
 	}
 
+	/* streamed dataSets are evaluated a chunk at a time, holding only the outputs of one chunk */
+	if (data->stream != NULL) {
+
+		for (i = 0; i < getNumDataSetChunks(data); i++) {
+			chunkData = initialiseDataSetChunk(data, i);
+			error += supervisedLearning(params, chromo, chunkData);
+			freeDataSet(chunkData);
+		}
+
+		return error;
+	}
+
+	/* calculate the chromosome outputs for every sample in data */
+	outputs = (double*)malloc(getNumDataSetSamples(data) * getNumChromosomeOutputs(chromo) * sizeof(double));
+	executeChromosomeBatch(chromo, data, outputs);
+
 	/* for each sample in data */
 	for (i = 0 ; i < getNumDataSetSamples(data); i++) {
 
-		/* calculate the chromosome outputs for the set of inputs  */
-		executeChromosome(chromo, getDataSetSampleInputs(data, i));
-
 		/* for each chromosome output */
 		for (j = 0; j < getNumChromosomeOutputs(chromo); j++) {
 
-			error += fabs(getChromosomeOutput(chromo, j) - getDataSetSampleOutput(data, i, j));
+			error += fabs(outputs[(i * getNumChromosomeOutputs(chromo)) + j] - getDataSetSampleOutput(data, i, j));
+		}
+	}
+
+	free(outputs);
+
+	return error;
+}
+
+
+/*
+	The bounded form of supervisedLearning. The error only grows with each
+	sample and so once it is greater than the cutoff the remaining samples
+	are not executed.
+*/
+static double supervisedLearningBounded(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff) {
+
+	int i, j;
+	int firstSample, numSamples;
+	double error = 0;
+	double *outputs;
+	struct dataSet *chunkData;
+
+	/* error checking */
+	if (getNumChromosomeInputs(chromo) != getNumDataSetInputs(data)) {
+		printf("Error: the number of chromosome inputs must match the number of inputs specified in the dataSet.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	if (getNumChromosomeOutputs(chromo) != getNumDataSetOutputs(data)) {
+		printf("Error: the number of chromosome outputs must match the number of outputs specified in the dataSet.\n");
+		printf("Terminating CGP-Library.\n");
+		exit(0);
+	}
+
+	/* streamed dataSets are evaluated a chunk at a time, each bounded by what remains of the cutoff */
+	if (data->stream != NULL) {
+
+		for (i = 0; i < getNumDataSetChunks(data) && !(error > cutoff); i++) {
+			chunkData = initialiseDataSetChunk(data, i);
+			error += supervisedLearningBounded(params, chromo, chunkData, cutoff - error);
+			freeDataSet(chunkData);
+		}
+
+		return error;
+	}
+
+	outputs = (double*)malloc(BOUNDEDFITNESSBLOCKSIZE * getNumChromosomeOutputs(chromo) * sizeof(double));
+
+	/* for each block of samples in data */
+	for (firstSample = 0; firstSample < getNumDataSetSamples(data) && !(error > cutoff); firstSample += BOUNDEDFITNESSBLOCKSIZE) {
+
+		numSamples = getNumDataSetSamples(data) - firstSample;
+
+		if (numSamples > BOUNDEDFITNESSBLOCKSIZE) {
+			numSamples = BOUNDEDFITNESSBLOCKSIZE;
+		}
+
+		executeChromosomeSamples(chromo, data, firstSample, numSamples, outputs);
+
+		/* for each sample in the block */
+		for (i = 0; i < numSamples; i++) {
+
+			/* for each chromosome output */
+			for (j = 0; j < getNumChromosomeOutputs(chromo); j++) {
+
+				error += fabs(outputs[(i * getNumChromosomeOutputs(chromo)) + j] - getDataSetSampleOutput(data, firstSample + i, j));
+			}
 		}
 	}
 
+	free(outputs);
+
 	return error;
 }
 
 
 /*
-	returns a random decimal between [0,1[
+	returns a random decimal between [0,1[. The decimals of pcg have 53
+	random bits, those of rand_r only take 1000000 values.
 */
 static double randDecimal(unsigned int * seed) {
+
+	unsigned int high, low;
+
+	if (randomNumberGenerator == RANDOMGENERATORPCG) {
+		high = randPCG(seed) >> 5;
+		low = randPCG(seed) >> 6;
+		return ((high * 67108864.0) + low) / 9007199254740992.0;
+	}
+
 	//return (double)rand() / (double)RAND_MAX;
 	return (rand_r(seed) % 1000000) / 1000000.;
 }
 
+
+/*
+	sets n random decimals between [0,1[, the same as n calls of randDecimal
+*/
+static void randDecimals(double *decimals, int n, unsigned int * seed) {
+
+	int i;
+
+	for (i = 0; i < n; i++) {
+		decimals[i] = randDecimal(seed);
+	}
+}
+
+
+/*
+	returns the next output of the PCG RXS M XS generator of the given 32 bit
+	state, which is a permutation of the state and so has a period of 2^32.
+	The state is stepped as a congruential generator and its output permuted
+	by a random shift, a multiplication and a final shift.
+	see: M. E. O'Neill, PCG: A Family of Simple Fast Space-Efficient Statistically
+	Good Algorithms for Random Number Generation, 2014
+*/
+static unsigned int randPCG(unsigned int * state) {
+
+	uint32_t old = *state;
+	uint32_t word;
+
+	*state = (old * 747796405u) + 2891336453u;
+
+	word = ((old >> ((old >> 28u) + 4u)) ^ old) * 277803737u;
+
+	return (word >> 22u) ^ word;
+}
+
+
+/*
+	returns the seed of a new stream of random numbers, such as that of one
+	thread or task, drawn from the given stream
+*/
+static unsigned int randSeed(unsigned int * seed) {
+
+	if (randomNumberGenerator == RANDOMGENERATORPCG) {
+		return randPCG(seed);
+	}
+
+	return rand_r(seed);
+}
+
+
+/*
+	returns the number of genes not mutated before the next mutated gene
+	when each gene is mutated with the given probability, not more than
+	numGenes. The number is geometrically distributed.
+*/
+static int getRandomGeneSkip(double mutationRate, int numGenes, unsigned int * seed) {
+
+	double skip;
+
+	if (mutationRate >= 1) {
+		return 0;
+	}
+
+	if (mutationRate <= 0) {
+		return numGenes;
+	}
+
+	skip = floor(log(1 - randDecimal(seed)) / log(1 - mutationRate));
+
+	return skip < numGenes ? (int)skip : numGenes;
+}
+
 /*
 	sort int array using qsort
 */
@@ -5469,10 +11501,30 @@ static int randInt(int n, unsigned int * seed) {
 	int randLimit;
 	int randExcess;
 
+	uint64_t product;
+	uint32_t threshold;
+
 	if (n == 0) {
 		return 0;
 	}
 
+	/* multiplying by n maps the 32 bits to [0,n[, the low products which would bias it being drawn again */
+	if (randomNumberGenerator == RANDOMGENERATORPCG) {
+
+		product = (uint64_t)randPCG(seed) * (uint32_t)n;
+
+		if ((uint32_t)product < (uint32_t)n) {
+
+			threshold = (uint32_t)(-n) % (uint32_t)n;
+
+			while ((uint32_t)product < threshold) {
+				product = (uint64_t)randPCG(seed) * (uint32_t)n;
+			}
+		}
+
+		return (int)(product >> 32);
+	}
+
 	randExcess = (RAND_MAX % n) + 1;
 	randLimit = RAND_MAX - randExcess;
 
@@ -50,6 +50,9 @@
 #define setReproductionScheme setCustomReproductionScheme
 #define addNodeFunctionCustom addCustomNodeFunction
 
+/* size_t, used by the migration transports */
+#include <stddef.h>
+
 /*
 	Deal with c++ compilers
 */
@@ -176,6 +179,30 @@ struct dataSet;
 */
 struct results;
 
+/*
+	variable: profile
+
+	Stores the counters and phase times collected while profiling, see <setProfile>.
+
+	See Also:
+
+		<initialiseProfile>, <setProfile>, <printProfile>, <getProfileTime>, <freeProfile>
+
+*/
+struct profile;
+
+/*
+	variable: experiment
+
+	Stores the folds of repeated stratified 10-fold cross-validations and the algorithms run on every fold.
+
+	See Also:
+
+		<initialiseExperiment>, <addExperimentAlgorithm>, <runExperiment>, <freeExperiment>
+
+*/
+struct experiment;
+
 struct DEChromosome;
 
 
@@ -399,6 +426,8 @@ DLL_EXPORT void addCustomNodeFunction(struct parameters *params, double (*functi
 
 	Resets the function set stored by a <parameters> structure to contain no functions.
 
+	Chromosomes share the function set of the <parameters> structure they were initialised from. Changing the function set of a <parameters> structure after initialising chromosomes does not change the function set of those chromosomes.
+
 	Parameters:
 		params - pointer to an initialised <parameters> structure
 
@@ -659,6 +688,63 @@ DLL_EXPORT void setConnectionWeightRange(struct parameters *params, double weigh
 DLL_EXPORT void setCustomFitnessFunction(struct parameters *params, double (*fitnessFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *data), char const *fitnessFunctionName);
 
 
+/*
+	Function: setCustomBoundedFitnessFunction
+
+	Sets the bounded form of the custom fitness function.
+
+	A bounded fitness function is given a cutoff fitness together with the chromosome and may stop evaluating the chromosome once its fitness is known to be greater than the cutoff. It must return the same fitness as the fitness function whenever that fitness is not greater than the cutoff and otherwise any fitness greater than the cutoff, so that the chromosomes selected are the same as with the fitness function.
+
+	The cutoff is used where a chromosome is only kept if its fitness is not greater than that of another: a DE trial solution and the individual it replaces, and the children and the parent of the (1+lambda)-ES with the default selection scheme of <runCGP> and <runCGPDE_OUT>. Elsewhere the fitness function is used.
+
+	The bounded fitness function prototype must take the following form. Where cutoff is the fitness the chromosome must not be greater than to be kept.
+
+	(begin code)
+	double functionName(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff);
+	(end)
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		boundedFitnessFunction - the bounded form of the current fitness function.
+
+		If the boundedFitnessFunction parameter is set as NULL, the fitness function is always used.
+
+	Note:
+		The default supervised learning fitness function has a bounded form which stops once the error is greater than the cutoff. <setCustomFitnessFunction> removes the bounded fitness function and so <setCustomBoundedFitnessFunction> must be called after it. <executeChromosomeSamples> may be used to execute the samples of the <dataSet> a block at a time.
+
+	Example:
+
+		A bounded error counting fitness function
+		(begin code)
+		double countErrorsBounded(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff){
+
+			int i;
+			double error = 0;
+
+			for(i=0; i<getNumDataSetSamples(data) && error <= cutoff; i++){
+
+				executeChromosome(chromo, getDataSetSampleInputs(data, i));
+
+				if(getChromosomeOutput(chromo, 0) != getDataSetSampleOutput(data, i, 0)){
+					error++;
+				}
+			}
+
+			return error;
+		}
+		(end)
+
+		(begin code)
+		setCustomFitnessFunction(params, countErrors, "countErrors");
+		setCustomBoundedFitnessFunction(params, countErrorsBounded);
+		(end)
+
+	See Also:
+		<setCustomFitnessFunction>
+*/
+DLL_EXPORT void setCustomBoundedFitnessFunction(struct parameters *params, double (*boundedFitnessFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *data, double cutoff));
+
+
 /*
 	Function: setCustomSelectionScheme
 
@@ -781,14 +867,51 @@ DLL_EXPORT void setCustomReproductionScheme(struct parameters *params, void
 
 		Sets the target fitness used when running CGP.
 
-		In all cases lower fitness values are used to represent fitter chromosomes.
+		In all cases lower fitness values are used to represent fitter chromosomes. <runCGP>, <runCGPDE_IN> and <runCGPDE_OUT> stop after the generation in which the training fitness of a parent, on all the training samples, is not greater than the target fitness. When mini-batches are used (<setMiniBatchSize>) a parent whose fitness on its mini-batch reaches the target is evaluated again on all the training samples. The default of -DBL_MAX is never reached, as fitness functions such as -(accuracy) are negative.
 
 	Parameters:
 		params - pointer to <parameters> structure.
 		targetFitness - The target fitness to be set.
+
+	See Also:
+		<setMaxStallGenerations> <setTimeBudget>
 */
 DLL_EXPORT void setTargetFitness(struct parameters *params, double targetFitness);
 
+/*
+	Function: setMaxStallGenerations
+
+		Sets the number of generations without improvement after which the runs stop.
+
+		<runCGP>, <runCGPDE_IN> and <runCGPDE_OUT> stop once the validation fitness of their best chromosome has not decreased for maxStallGenerations generations. The DE of the weights of <runCGPDE_OUT> is then run as usual. The generations without improvement are saved in the checkpoints (<setCheckpoint>), and so a resumed run stops as the uninterrupted run does. By default (0) the runs do not stop for a lack of improvement. A negative value is invalid; a warning is displayed and the value is left unchanged.
+
+		The number of generations actually run is given by <getChromosomeGenerations> of the returned chromosomes.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		maxStallGenerations - the number of generations, >= 0.
+
+	See Also:
+		<setTargetFitness> <setTimeBudget>
+*/
+DLL_EXPORT void setMaxStallGenerations(struct parameters *params, int maxStallGenerations);
+
+/*
+	Function: setTimeBudget
+
+		Sets the wall-clock time, in seconds, after which the runs stop.
+
+		<runCGP>, <runCGPDE_IN> and <runCGPDE_OUT> stop after the generation in which the time budget is spent, and the DE of the weights of <runCGPDE_OUT> then runs at least one iteration and stops after the iteration in which it is spent. The time is counted from the start of each run, or from that of its resume, and so the results depend on the speed of the machine. By default (0) there is no time budget. A negative value is invalid; a warning is displayed and the value is left unchanged.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		timeBudget - the time budget in seconds, >= 0.
+
+	See Also:
+		<setTargetFitness> <setMaxStallGenerations>
+*/
+DLL_EXPORT void setTimeBudget(struct parameters *params, double timeBudget);
+
 /*
 	Function: setMutationType
 
@@ -847,12 +970,210 @@ DLL_EXPORT void setMutationType(struct parameters *params, char const *mutationT
 		The CGP-Library ignores the OMP_NUM_THREADS environment variable. The
 		only method for setting the number of threads is using <setNumThreads>.
 
+	Note:
+		The threads are used to evaluate the children of each generation in parallel in <runCGP>, <runCGPDE_IN> and <runCGPDE_OUT>. The results are the same for any number of threads. When a run is itself called from within a parallel region the children are evaluated by the calling thread, unless nested parallelism is enabled.
+
 	Parameters:
 		params - pointer to <parameters> structure.
 		numThreads - The number of threads to be set.
 */
 DLL_EXPORT void setNumThreads(struct parameters *params, int numThreads);
 
+
+/*
+	Function: setFitnessMemoisation
+		Sets whether children identical to one of their parents reuse its fitness.
+
+		Most mutations only change inactive genes, leaving a child with the same active nodes and connection weights as its parent. When fitness memoisation is set (the default) such children are given the fitness of the parent, as found using <compareChromosomesActiveNodesANN>, instead of being evaluated again. In <runCGP> and <runCGPDE_OUT> both the training and validation fitness are reused; in <runCGPDE_IN> only the training fitness is.
+
+	Note:
+		Fitness memoisation assumes the fitness function only depends on the active nodes of the chromosome and the dataSet. Fitness memoisation should be turned off for fitness functions which are stochastic.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		fitnessMemoisation - 1 to reuse the fitness of identical parents or 0 to always evaluate the children.
+*/
+DLL_EXPORT void setFitnessMemoisation(struct parameters *params, int fitnessMemoisation);
+
+
+/*
+	Function: setNodeCacheSize
+		Sets the memory, in megabytes, each chromosome may use to cache the values of its nodes.
+
+		When set, <executeChromosomeBatch> keeps the value of every node for every sample of the two most recently used <dataSets>. The mutation operators mark the nodes whose genes they change and <copyChromosome> copies the cached values which are still valid, so a child only recomputes the nodes downstream of its mutated genes. Each cached <dataSet> needs numNodes * numSamples doubles; if the two do not fit in the given size the chromosome is evaluated without caching. The default of 0 turns node caching off.
+
+	Note:
+		The cached values are matched to a <dataSet> and not to its values. The values of a <dataSet> should not be changed through the arrays returned by <getDataSetSampleInputs> while chromosomes using node caching are evaluated on it.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		nodeCacheSize - the node cache size in megabytes.
+*/
+DLL_EXPORT void setNodeCacheSize(struct parameters *params, int nodeCacheSize);
+
+/*
+	Function: setFastActivation
+		Sets whether chromosomes whose active nodes all use the same activation function are evaluated by a specialised evaluator.
+
+		When set to 1, chromosomes whose active nodes all use sig, tanh, softsign or gauss are evaluated with that activation inlined rather than called through the function set, such as those of a function set holding only "sig". exp is computed by an approximation with a relative error below 1e-8 which, like the rest of the evaluator, can be vectorised by <executeChromosomeBatch>. The results therefore differ slightly from those of the node functions, and so the default of 0 evaluates every node by its node function.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		fastActivation - 0 or 1.
+*/
+DLL_EXPORT void setFastActivation(struct parameters *params, int fastActivation);
+
+/*
+	Function: setOffloadEvaluation
+		Sets whether the chromosomes of a population are executed together on an OpenMP offload device.
+
+		When set to 1, the children of each generation of <runCGP> and <runCGPDE_OUT> which are not given the fitness of a parent, the trial vectors of each synchronous DE iteration (<setSynchronousDE>) and the DE populations evaluated together are executed for every training sample in one launch before their fitnesses are calculated. The execution plans of the chromosomes are uploaded together and the training samples are uploaded once and kept on the device until the <dataSet> is freed or shuffled. The fitness functions then read the outputs through <executeChromosomeBatch> and <executeChromosomeSamples> as usual, so custom and bounded fitness functions are unchanged, although bounded fitness functions no longer save any execution.
+
+		Only chromosomes evaluated by the fast evaluator of <setFastActivation> and without recurrent connections are offloaded; the others, the validation samples, streamed dataSets and the trial vectors of the default DE update are executed on the host as usual. Without an offload device, or if the compiler does not support one, the launches run on the host. The outputs are the same as those of the host up to the rounding of the device. The default of 0 executes every chromosome on its own.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		offloadEvaluation - 0 or 1.
+
+	See Also:
+		<setFastActivation>
+*/
+DLL_EXPORT void setOffloadEvaluation(struct parameters *params, int offloadEvaluation);
+
+/*
+	Function: setMiniBatchSize
+		Sets the number of training samples in each mini-batch.
+
+		When set, the training samples are split into mini-batches of at most miniBatchSize samples, each holding about the same proportion of each class in the same way as the folds of <generateFolds>. Each generation of <runCGP> and <runCGPDE_OUT>, and each DE iteration, then evaluates the candidates on the next mini-batch rather than on every training sample, with the parents or the DE population evaluated again on the same mini-batch so that they are compared fairly. Every <setFullEvaluationInterval> generations or iterations all the training samples are used instead, so a candidate which was only fit on its mini-batches does not stay selected. The cost of each generation falls roughly in proportion to the mini-batch size.
+
+		The best chromosome is still chosen on all the validation samples. The training fitness of the chromosome returned by <runCGP>, and those of the DE population returned by <runDE>, are those of all the training samples. The children of <runCGPDE_IN> are evaluated on all the training samples, although the DE of their weights uses mini-batches. The default of 0 uses every training sample every generation.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		miniBatchSize - the number of samples in each mini-batch, or 0.
+
+	See Also:
+		<setFullEvaluationInterval>
+*/
+DLL_EXPORT void setMiniBatchSize(struct parameters *params, int miniBatchSize);
+
+/*
+	Function: setFullEvaluationInterval
+		Sets how often, when mini-batches are used, the candidates are evaluated on all the training samples.
+
+		Every fullEvaluationInterval-th generation or DE iteration uses all the training samples rather than the next mini-batch. The default is 10.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		fullEvaluationInterval - the number of generations or DE iterations, at least 1.
+
+	See Also:
+		<setMiniBatchSize>
+*/
+DLL_EXPORT void setFullEvaluationInterval(struct parameters *params, int fullEvaluationInterval);
+
+/*
+	Function: setMigrationInterval
+		Sets the number of generations between the migrations of the island model.
+
+		When a migration transport has been set using <setCustomMigrationTransport> or <setMPIMigrationTransport>, every migrationInterval-th generation of <runCGP> and <runCGPDE_OUT> sends the fittest parents of each island to its neighbours, once the parents have been selected. The default of 0 never migrates.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		migrationInterval - the number of generations, at least 0.
+
+	See Also:
+		<setNumMigrants>, <setMigrationTopology>, <setCustomMigrationTransport>
+*/
+DLL_EXPORT void setMigrationInterval(struct parameters *params, int migrationInterval);
+
+/*
+	Function: setNumMigrants
+		Sets the number of chromosomes each island sends to each of its neighbours.
+
+		The fittest numMigrants parents are sent, or all mu parents if there are fewer. Each immigrant is evaluated on the training and validation data of the receiving island and replaces its worst parent if its fitness is not greater. The default is 1.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		numMigrants - the number of migrants, at least 1.
+
+	See Also:
+		<setMigrationInterval>
+*/
+DLL_EXPORT void setNumMigrants(struct parameters *params, int numMigrants);
+
+/*
+	Function: setMigrationTopology
+		Sets which islands exchange migrants.
+
+		Valid topologies are "ring", where island i sends to island i+1 and receives from island i-1, and "complete", where every island sends to and receives from every other island. The default is "ring". If an invalid topology is given a warning is displayed and the topology is not changed.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		migrationTopology - "ring" or "complete".
+
+	See Also:
+		<setMigrationInterval>
+*/
+DLL_EXPORT void setMigrationTopology(struct parameters *params, char const *migrationTopology);
+
+/*
+	Function: setCustomMigrationTransport
+		Sets the island run by the calling process and the transport used to exchange migrants with the other islands.
+
+		Each island, typically one per node of a cluster, runs its own population using <runCGP> or <runCGPDE_OUT> with the same <parameters> (other than the island and seed) and the same number of generations. At each migration the transport is called once for each neighbour and must send the sendSize bytes of sendBuffer to island destination and, at the same time, receive the bytes sent to this island by island source. The received bytes are stored in a buffer allocated with malloc, which is free'd by the CGP-Library, and receiveSize is set to their number. The migrants are serialised in the same format as <saveChromosomesBinary>. Receiving migrants of other dimensions, or with other node functions or the same functions in another order, is an error.
+
+		If migrationTransport is NULL the island model is not used.
+
+	Note:
+		The transport is only called from the thread which called <runCGP> or <runCGPDE_OUT>. Each island should be given a different seed.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		island - the island of the calling process, from 0 to numIslands - 1.
+		numIslands - the number of islands.
+		migrationTransport - the transport, or NULL.
+		context - passed to each call of the transport.
+
+	See Also:
+		<setMPIMigrationTransport>, <setMigrationInterval>, <setNumMigrants>, <setMigrationTopology>
+*/
+DLL_EXPORT void setCustomMigrationTransport(struct parameters *params, int island, int numIslands, void (*migrationTransport)(void *context, int destination, const char *sendBuffer, size_t sendSize, int source, char **receiveBuffer, size_t *receiveSize), void *context);
+
+#ifdef CGPDE_MPI
+/*
+	Function: setMPIMigrationTransport
+		Exchanges the migrants of the island model using MPI, each rank of MPI_COMM_WORLD being one island.
+
+		Only available when the CGP-Library is compiled with CGPDE_MPI defined, e.g. using mpicc -DCGPDE_MPI. MPI must have been initialised, with at least MPI_THREAD_FUNNELED if OpenMP is also used.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+
+	See Also:
+		<setCustomMigrationTransport>
+*/
+DLL_EXPORT void setMPIMigrationTransport(struct parameters *params);
+#endif
+
+/*
+	Function: setCheckpoint
+		Sets the number of generations between the checkpoints of a run, and the file they are saved to.
+
+		Every checkpointInterval-th generation of <runCGP>, <runCGPDE_IN> and <runCGPDE_OUT> saves the parents, the children, the best chromosome, the random number seed and the number of generations completed to fileName, in the binary chromosome format of <saveChromosomesBinary>. The DE of the weights at the end of <runCGPDE_OUT> likewise saves its population every checkpointInterval-th DE iteration. Each checkpoint replaces the previous one, being written under fileName.tmp first so that a run stopped while saving leaves the previous checkpoint whole.
+
+		A stopped run is continued using <resumeCGP>, <resumeCGPDE_IN> or <resumeCGPDE_OUT>. The default of 0 saves no checkpoints.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		checkpointInterval - the number of generations, at least 0.
+		fileName - char array giving the location of the checkpoint file, of fewer than 256 characters.
+
+	See Also:
+		<resumeCGP>, <resumeCGPDE_IN>, <resumeCGPDE_OUT>
+*/
+DLL_EXPORT void setCheckpoint(struct parameters *params, int checkpointInterval, char const *fileName);
+
 DLL_EXPORT void setNP_IN(struct parameters *params, int np);
 
 DLL_EXPORT void setNP_OUT(struct parameters *params, int np);
@@ -865,6 +1186,66 @@ DLL_EXPORT void setCR(struct parameters *params, double cr);
 
 DLL_EXPORT void setF(struct parameters *params, double f);
 
+/*
+	Function: setSynchronousDE
+		Sets whether the DE population used by <runCGPDE_IN> and <runCGPDE_OUT> is updated synchronously.
+
+		By default (0) each trial vector replaces its target individual as soon as it is evaluated, so later trial vectors of the same iteration can use it. When set to 1 the trial vectors of an iteration are all built from the current population and then evaluated in parallel using the threads set by <setNumThreads>. The results are reproducible for a given seed and do not depend on the number of threads, but differ from those of the default update.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		synchronousDE - 0 or 1.
+*/
+DLL_EXPORT void setSynchronousDE(struct parameters *params, int synchronousDE);
+
+/*
+	Function: setActiveWeightsDE
+		Sets whether the DE weights vector only holds the weights of the active connections.
+
+		By default (0) DE evolves the weights of every input of every node, numNodes * arity weights, although only the used inputs of the active nodes affect the fitness. When set to 1 the weights vector holds only the weights of the used inputs of the active nodes, in the order of the active nodes. The weights of the other connections are left as those of the chromosome given to DE.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		activeWeightsDE - 0 or 1.
+*/
+DLL_EXPORT void setActiveWeightsDE(struct parameters *params, int activeWeightsDE);
+
+/*
+	Function: setRecycleDEPopulation
+		Sets whether <runCGPDE_IN> recycles its DE population across generations.
+
+		By default (0) every generation of <runCGPDE_IN> allocates a new DE population for its best children and frees it afterwards. When set to 1 the DE population is allocated once and, at every generation, given the topology of the best children and new random weights. Fewer random numbers are then drawn and so the results differ from those of the default.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		recycleDEPopulation - 0 or 1.
+*/
+DLL_EXPORT void setRecycleDEPopulation(struct parameters *params, int recycleDEPopulation);
+
+/*
+	Function: setMinDiversityDE
+		Sets the diversity of the DE population below which DE stops.
+
+		The diversity is the mean over the weights of their standard deviation in the DE population. Every DE, that of <runDE>, <runCGPDE_IN> and <runCGPDE_OUT>, stops before its next iteration once the diversity is below minDiversityDE, as the population has then collapsed to about one point. By default (0) DE runs all of maxIter_IN or maxIter_OUT iterations. A negative value is invalid; a warning is displayed and the value is left unchanged.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		minDiversityDE - the minimum diversity, >= 0.
+*/
+DLL_EXPORT void setMinDiversityDE(struct parameters *params, double minDiversityDE);
+
+/*
+	Function: setTopologyCacheSize
+		Sets the number of topologies <runCGPDE_IN> remembers with the weights DE evolved for them.
+
+		At every generation <runCGPDE_IN> evolves the weights of its best children with DE. When the active nodes of the best children are the same as those of a topology already remembered, see <compareChromosomesActiveNodes>, its DE is skipped and the children take the remembered weights of its active nodes and their fitness. Otherwise, the children with their evolved weights are remembered, replacing the least recently used topology once topologyCacheSize are remembered. By default (0) no topologies are remembered. Skipping DE draws fewer random numbers and so the results differ from those of the default. A resumed run starts with no topologies remembered. A negative value is invalid; a warning is displayed and the value is left unchanged.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		topologyCacheSize - the number of topologies, >= 0.
+*/
+DLL_EXPORT void setTopologyCacheSize(struct parameters *params, int topologyCacheSize);
+
 /*
 	Title: Chromosome Functions
 
@@ -914,6 +1295,44 @@ DLL_EXPORT struct chromosome *initialiseChromosome(struct parameters *params, un
 */
 DLL_EXPORT struct chromosome* initialiseChromosomeFromFile(char const *file, unsigned int * seed);
 
+
+/*
+	Function: initialiseChromosomeFromBinaryFile
+		Initialises a chromosome from a chromosome saved by <saveChromosomeBinary>.
+
+		The file is memory mapped and the genes are copied straight into the new chromosome, which also takes the saved fitness, validation fitness and number of generations.
+
+	Note:
+		Only chromosomes which use node functions defined by the CGP-library can be loaded. The file must have been saved with the same byte order and binary format version.
+
+	Parameters:
+		file - char array giving the location of the chromosome to be loaded.
+
+	Returns:
+		A pointer to an initialised chromosome structure.
+
+	See Also:
+		<saveChromosomeBinary>, <initialiseChromosomesFromBinaryFile>, <initialiseChromosomeFromFile>
+*/
+DLL_EXPORT struct chromosome *initialiseChromosomeFromBinaryFile(char const *file);
+
+
+/*
+	Function: initialiseChromosomesFromBinaryFile
+		Initialises the chromosomes saved by <saveChromosomesBinary>, such as the population returned by <runCGPDE_OUT>.
+
+	Parameters:
+		file - char array giving the location of the chromosomes to be loaded.
+		numChromos - set to the number of chromosomes loaded.
+
+	Returns:
+		An array of pointers to initialised chromosome structures. The chromosomes must be freed using <freeChromosome> and the array using free.
+
+	See Also:
+		<saveChromosomesBinary>, <initialiseChromosomeFromBinaryFile>
+*/
+DLL_EXPORT struct chromosome **initialiseChromosomesFromBinaryFile(char const *file, int *numChromos);
+
 /*
 	Function: initialiseChromosomeFromChromosome
 
@@ -991,7 +1410,10 @@ DLL_EXPORT void printChromosome(struct chromosome *chromo, int weights);
 
 		Executes the given chromosome with the given inputs. The dimensions of the inputs arrays must match the dimensions of the chromosome inputs. The chromosome outputs are then accessed using <getChromosomeOutput>.
 
-	Parameters:
+	Note:
+		The chromosome is executed from a flat execution plan holding the functions, inputs and connection weights of the active nodes in order. The plan is rebuilt whenever the active nodes of the chromosome are set i.e. by <initialiseChromosome>, <mutateChromosome>, <copyChromosome> and <setChromosomeFitness>.
+
+	Parameters:
 		chromo - pointer to an initialised chromosome structure.
 		inputs - array of doubles used as inputs to the chromosome
 
@@ -1030,6 +1452,54 @@ DLL_EXPORT void printChromosome(struct chromosome *chromo, int weights);
 DLL_EXPORT void executeChromosome(struct chromosome *chromo, const double *inputs);
 
 
+/*
+	Function: executeChromosomeBatch
+		Executes the given chromosome for every sample in the given dataSet.
+
+		The chromosome is executed for blocks of samples at a time, each active node being evaluated for the whole block before moving on to the next. The outputs are stored in the given outputs array sample by sample i.e. output j of sample i is stored at outputs[(i * numOutputs) + j]. The outputs array must hold at least numSamples * numOutputs doubles.
+
+		The results are identical to calling <executeChromosome> for each sample in turn.
+
+	Note:
+		After <executeChromosomeBatch> the values given by <getChromosomeOutput> and <getChromosomeNodeValue> are those of the last sample in the dataSet. Chromosomes with recurrent connections depend on the previous sample and so are always executed one sample at a time.
+
+	Parameters:
+		chromo - pointer to an initialised chromosome structure.
+		data - pointer to an initialised dataSet structure with the same number of inputs and outputs as the chromosome.
+		outputs - array of doubles in which the outputs of every sample are stored.
+
+	See Also:
+			<executeChromosome>, <getChromosomeOutput>
+*/
+DLL_EXPORT void executeChromosomeBatch(struct chromosome *chromo, struct dataSet *data, double *outputs);
+
+
+/*
+	Function: executeChromosomeSamples
+		Executes the given chromosome for numSamples samples of the given dataSet starting at firstSample.
+
+		The samples are executed in the same way as by <executeChromosomeBatch>. Output j of sample firstSample + i is stored at outputs[(i * numOutputs) + j] and so the outputs array must hold at least numSamples * numOutputs doubles.
+
+		Executing the samples of a dataSet a block at a time in order gives the same results as <executeChromosomeBatch>, including for chromosomes with recurrent connections, and allows a fitness function to stop part way through the dataSet.
+
+	Note:
+		If node caching is used the cached node values only become valid once every sample of the dataSet has been executed in order starting from the first.
+
+		The samples of a streamed dataSet are executed one chunk at a time, with a view of each chunk being created for every call. Fitness functions which execute a few samples at a time should therefore do so within each chunk given by <initialiseDataSetChunk>.
+
+	Parameters:
+		chromo - pointer to an initialised chromosome structure.
+		data - pointer to an initialised dataSet structure with the same number of inputs and outputs as the chromosome.
+		firstSample - the first sample to execute.
+		numSamples - the number of samples to execute.
+		outputs - array of doubles in which the outputs of the samples are stored.
+
+	See Also:
+			<executeChromosomeBatch>, <setCustomBoundedFitnessFunction>
+*/
+DLL_EXPORT void executeChromosomeSamples(struct chromosome *chromo, struct dataSet *data, int firstSample, int numSamples, double *outputs);
+
+
 
 /*
 	Function: getChromosomeOutput
@@ -1098,6 +1568,39 @@ DLL_EXPORT int isNodeActive(struct chromosome *chromo, int node);
 */
 DLL_EXPORT void saveChromosome(struct chromosome *chromo, char const *fileName);
 
+
+/*
+	Function: saveChromosomeBinary
+		Saves the given chromosome to a binary file which can be used to initialise new chromosomes using <initialiseChromosomeFromBinaryFile>.
+
+		The binary file is versioned and holds the genes, the fitness, the validation fitness and the number of generations of the chromosome. It is written at once and is much smaller and faster to load than the text file of <saveChromosome>, which remains for interchange.
+
+	Parameters:
+		chromo - pointer to chromosome structure.
+		fileName - char array giving the location of the chromosome to be saved.
+
+	See Also:
+		<initialiseChromosomeFromBinaryFile>, <saveChromosomesBinary>, <saveChromosome>
+*/
+DLL_EXPORT void saveChromosomeBinary(struct chromosome *chromo, char const *fileName);
+
+
+/*
+	Function: saveChromosomesBinary
+		Saves the given array of chromosomes, such as the population returned by <runCGPDE_OUT>, to one binary file.
+
+		The file takes the same form as that of <saveChromosomeBinary> and is loaded using <initialiseChromosomesFromBinaryFile>.
+
+	Parameters:
+		chromos - array of pointers to chromosome structures.
+		numChromos - the number of chromosomes to be saved.
+		fileName - char array giving the location of the chromosomes to be saved.
+
+	See Also:
+		<initialiseChromosomesFromBinaryFile>, <saveChromosomeBinary>
+*/
+DLL_EXPORT void saveChromosomesBinary(struct chromosome **chromos, int numChromos, char const *fileName);
+
 /*
 	Function: saveChromosomeDot
 
@@ -1160,6 +1663,41 @@ DLL_EXPORT void saveChromosomeDot(struct chromosome *chromo, int weights, char c
 DLL_EXPORT void saveChromosomeLatex(struct chromosome *chromo, int weights, char const *fileName);
 
 
+/*
+	Function: saveChromosomeC
+
+		Saves the given <chromosome> as a standalone C source file for
+		inference outside of CGP-Library.
+
+		Only the active nodes are written, each unrolled as one statement
+		with its connection weights as constants. The file depends only on
+		the C standard maths library and defines the following two
+		functions, where inputs and outputs hold one sample after another.
+
+		(begin code)
+		void functionName(const double *inputs, double *outputs);
+		void functionName_batch(const double *inputs, int numSamples, double *outputs);
+		(end)
+
+		Compiled as C99 without floating point contraction (e.g. gcc -ffp-contract=off)
+		the saved functions give the same outputs as <executeChromosome>, including
+		when <setFastActivation> is used.
+
+	Note:
+		This function is only compatible with feed-forward networks and the preset node
+		functions other than rand. Otherwise a warning is given and no file is saved.
+
+	Parameters:
+		chromo - pointer to chromosome structure.
+		functionName - char array giving the name of the saved function, a valid C identifier.
+		fileName - char array giving the location of the C source file to be saved.
+
+	See Also:
+		<saveChromosome> <saveChromosomeBinary> <removeInactiveNodes>
+*/
+DLL_EXPORT void saveChromosomeC(struct chromosome *chromo, char const *functionName, char const *fileName);
+
+
 /*
 	Function: compareChromosomes
 		Compares the two given chromosomes.
@@ -1436,7 +1974,7 @@ DLL_EXPORT int getNumChromosomeActiveConnections(struct chromosome *chromo);
 	Function: getChromosomeGenerations
 		Gets the number of generations for which the given chromosome has been trained.
 
-		If the chromosome has not been trained then -1 is returned.
+		If the chromosome has not been trained then -1 is returned. The chromosomes returned by <runCGP>, <runCGPDE_IN> and <runCGPDE_OUT> hold the number of generations run, which is less than the number allowed if a stopping policy was met, see <setTargetFitness>.
 
 	Parameters:
 		chromo - pointer to initialised chromosome structure.
@@ -1454,6 +1992,8 @@ DLL_EXPORT int getChromosomeGenerations(struct chromosome *chromo);
 	Title: DataSet Functions
 
 	Description of all functions and structures relating to data sets
+
+	The inputs and outputs of every sample in a <dataSet> are each stored in one aligned contiguous block, sample after sample. The arrays returned by <getDataSetSampleInputs> and <getDataSetSampleOutputs> are rows of these blocks.
 */
 
 /*
@@ -1540,6 +2080,29 @@ DLL_EXPORT struct dataSet *initialiseDataSetFromArrays(int numInputs, int numOut
 */
 DLL_EXPORT struct dataSet *initialiseDataSetFromFile(char const *file);
 
+
+/*
+	Function: initialiseDataSetFromMappedFile
+
+	Initialises a <dataSet> structure using the given file, parsed by the given number of threads.
+
+	The file takes the same form as for <initialiseDataSetFromFile>. It is memory mapped and split into one range of lines for each thread, which parses its lines straight into the <dataSet>. The values are the same as those given by atof. Lines may be of any length and blank lines are skipped.
+
+	Parameters:
+		file - the location of the file to be loaded into the <dataSet> structure
+		numThreads - the number of threads used to parse the file, at least one
+
+	Returns:
+		A pointer to an initialised <dataSet> structure.
+
+	Note:
+		<initialiseDataSetFromFile> is the same as <initialiseDataSetFromMappedFile> using a single thread. The number of samples, and the number of values of each sample, must match the header of the file.
+
+	See Also:
+		<initialiseDataSetFromFile>, <freeDataSet>
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetFromMappedFile(char const *file, int numThreads);
+
 DLL_EXPORT void shuffleData(struct dataSet *data, unsigned int * seed);
 
 DLL_EXPORT struct dataSet ** generateFolds(struct dataSet * data);
@@ -1554,6 +2117,36 @@ DLL_EXPORT struct dataSet * getValidationData(struct dataSet ** folds, int * val
 
 DLL_EXPORT struct dataSet * getTestingData(struct dataSet ** folds, int testing_index);
 
+DLL_EXPORT struct dataSet * getTrainingDataView(struct dataSet ** folds, int * training_index);
+
+DLL_EXPORT struct dataSet * getValidationDataView(struct dataSet ** folds, int * validation_index);
+
+DLL_EXPORT struct dataSet * getTestingDataView(struct dataSet ** folds, int testing_index);
+
+
+/*
+	Function: initialiseDataSetView
+
+	Initialises a <dataSet> view of the given samples of the given <dataSet>.
+
+	A view holds no samples of its own but refers to the rows of the given <dataSet>, so building one only costs a pointer per sample. A view can be used anywhere a <dataSet> is used, including as the training and validation sets of the run functions and with custom fitness functions. <getTrainingDataView>, <getValidationDataView> and <getTestingDataView> build views of the same samples as <getTrainingData>, <getValidationData> and <getTestingData>.
+
+	Parameters:
+		data - pointer to an initialised <dataSet> structure.
+		numSamples - the number of samples in the view.
+		samples - array of the indexes of the samples in the view.
+
+	Returns:
+		A pointer to an initialised <dataSet> structure.
+
+	Note:
+		A view must be freed using <freeDataSet> before the <dataSet> it refers to. Changing the samples of a view, for example with <shuffleData>, changes the samples of the <dataSet> it refers to.
+
+	See Also:
+		<freeDataSet>, <initialiseDataSetFromArrays>, <initialiseDataSetFromFile>
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetView(struct dataSet *data, int numSamples, const int *samples);
+
 
 /*
 	Function: freeDataSet
@@ -1597,6 +2190,115 @@ DLL_EXPORT void printDataSet(struct dataSet *data);
 DLL_EXPORT void saveDataSet(struct dataSet *data, char const *fileName);
 
 
+/*
+	Function: saveDataSetBinary
+		Saves the given <dataSet> to a binary file which can be read using <initialiseDataSetFromBinaryFile>.
+
+		The binary file is versioned and holds the values exactly. The inputs and outputs of each <dataSet> are contiguous and so are each written at once. The text file of <saveDataSet> remains for interchange.
+
+	Parameters:
+		data - <dataSet> to be saved.
+		fileName - the location of the file to be saved.
+
+	See Also:
+		<initialiseDataSetFromBinaryFile>, <saveDataSet>
+*/
+DLL_EXPORT void saveDataSetBinary(struct dataSet *data, char const *fileName);
+
+
+/*
+	Function: initialiseDataSetFromBinaryFile
+		Initialises a <dataSet> structure using a file saved by <saveDataSetBinary>.
+
+		The file is memory mapped and its inputs and outputs are copied straight into the <dataSet>.
+
+	Note:
+		The file must have been saved with the same byte order and binary format version.
+
+	Parameters:
+		file - the location of the file to be loaded into the <dataSet> structure
+
+	Returns:
+		A pointer to an initialised <dataSet> structure.
+
+	See Also:
+		<saveDataSetBinary>, <initialiseDataSetFromFile>, <freeDataSet>
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetFromBinaryFile(char const *file);
+
+
+/*
+	Function: initialiseDataSetStreamFromBinaryFile
+		Initialises a streamed <dataSet> structure using a file saved by <saveDataSetBinary>.
+
+		The samples of a streamed <dataSet> are not copied into memory. Instead the file stays memory mapped and its samples are used one chunk of chunkSize samples at a time, see <initialiseDataSetChunk>. The chunks are read in order and while one chunk is in use the next is read ahead and the previous one released, and so only a few chunks are held in memory at once. This allows <runCGP>, <runDE> and the other evolutionary algorithms to use dataSets far larger than memory.
+
+		The built in fitness functions, <executeChromosomeBatch>, <executeChromosomeSamples> and the sample accessors such as <getDataSetSampleOutput> all take streamed dataSets. Custom fitness functions should evaluate them a chunk at a time, so that only the outputs of one chunk need to be held.
+
+	Note:
+		The samples of a streamed <dataSet> cannot be modified and so it cannot be used with <shuffleData>, <generateFolds>, <reduceSampleSize> or <getDataSetInputColumns>. On Windows the whole file is read into memory.
+
+	Parameters:
+		file - the location of the file to be streamed.
+		chunkSize - the number of samples in each chunk.
+
+	Returns:
+		A pointer to an initialised <dataSet> structure.
+
+	See Also:
+		<initialiseDataSetChunk>, <getNumDataSetChunks>, <saveDataSetBinary>, <freeDataSet>
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetStreamFromBinaryFile(char const *file, int chunkSize);
+
+
+/*
+	Function: getNumDataSetChunks
+		Gets the number of chunks of the given <dataSet>.
+
+		A <dataSet> held in memory is one chunk of all its samples.
+
+	Parameters:
+		data - pointer to an initialised <dataSet> structure.
+
+	Returns:
+		The number of chunks of the <dataSet>.
+
+	See Also:
+		<initialiseDataSetChunk>, <initialiseDataSetStreamFromBinaryFile>
+*/
+DLL_EXPORT int getNumDataSetChunks(struct dataSet *data);
+
+
+/*
+	Function: initialiseDataSetChunk
+		Initialises a view of the samples of the given chunk of the given <dataSet>.
+
+		The view is used in the same way as any other <dataSet> and, so that node caching can be used, all the views of the same chunk share the same cached node values. A fitness function can take both streamed dataSets and those held in memory by summing its fitness over every chunk:
+
+		(begin code)
+		for (i = 0; i < getNumDataSetChunks(data); i++) {
+			chunk = initialiseDataSetChunk(data, i);
+			fitness += chunkFitness(params, chromo, chunk);
+			freeDataSet(chunk);
+		}
+		(end code)
+
+	Note:
+		The view shares the samples of the given <dataSet> and so must be freed, using <freeDataSet>, before it. Using the chunks of a streamed <dataSet> in order reads the next chunk ahead.
+
+	Parameters:
+		data - pointer to an initialised <dataSet> structure.
+		chunk - the chunk of the <dataSet> in the range [0, <getNumDataSetChunks>[.
+
+	Returns:
+		A pointer to an initialised <dataSet> structure.
+
+	See Also:
+		<getNumDataSetChunks>, <initialiseDataSetStreamFromBinaryFile>
+*/
+DLL_EXPORT struct dataSet *initialiseDataSetChunk(struct dataSet *data, int chunk);
+
+
 /*
 	Function: getNumDataSetInputs
 		Gets the number of <dataSet> inputs.
@@ -1715,6 +2417,27 @@ DLL_EXPORT double *getDataSetSampleOutputs(struct dataSet *data, int sample);
 DLL_EXPORT double getDataSetSampleOutput(struct dataSet *data, int sample, int output);
 
 
+/*
+	Function: getDataSetInputColumns
+		Gets the <dataSet> inputs stored column by column.
+
+		Input j of sample i is stored at [(j * numSamples) + i]. The column copy is built on the first call and is kept until the <dataSet> is freed or its samples are reordered by <shuffleData>. Once built, <executeChromosomeBatch> reads the inputs from the columns.
+
+	Parameters:
+		data - pointer to an initialised <dataSet> structure.
+
+	Returns:
+		Pointer to an array containing the inputs of every sample column by column.
+
+	Note:
+		The first call builds the columns and so must not be made by several threads using the same <dataSet> at once.
+
+	See Also:
+		<getDataSetSampleInputs>, <getDataSetSampleInput>
+*/
+DLL_EXPORT double *getDataSetInputColumns(struct dataSet *data);
+
+
 /*
 	Title: Results Functions
 */
@@ -1876,6 +2599,212 @@ DLL_EXPORT double getAverageGenerations(struct results *rels);
 DLL_EXPORT double getMedianGenerations(struct results *rels);
 
 
+/*
+	Title: Profile Functions
+*/
+
+/*
+	Function: initialiseProfile
+		Initialises a <profile> with every counter and time zero.
+
+	Returns:
+		A pointer to an initialised <profile>.
+
+	See Also:
+		<setProfile>, <freeProfile>, <resetProfile>
+*/
+DLL_EXPORT struct profile *initialiseProfile(void);
+
+
+/*
+	Function: freeProfile
+		Frees a <profile> instance.
+
+	Parameters:
+		prof - pointer to an initialised profile.
+
+	See Also:
+		<initialiseProfile>
+*/
+DLL_EXPORT void freeProfile(struct profile *prof);
+
+
+/*
+	Function: resetProfile
+		Sets every counter and time of a <profile> to zero, such as between runs to get the counts of each run.
+
+	Parameters:
+		prof - pointer to an initialised profile.
+*/
+DLL_EXPORT void resetProfile(struct profile *prof);
+
+
+/*
+	Function: setProfile
+		Sets the <profile> in which the work of the algorithms run with the given <parameters> is counted.
+
+		The fitness evaluations, with the number of active nodes of each evaluated chromosome, the samples executed, the updates of the active nodes, the chromosome copies, the mutations and the DE trial vectors evaluated and accepted are counted, and the time spent evaluating fitnesses, updating the active nodes, copying, mutating and running DE is summed. Only chromosomes initialised with <initialiseChromosome> after the profile is set, and those initialised from them, count their samples, active node updates and copies; those of <runCGP>, <runCGPDE_IN>, <runCGPDE_OUT> and <runCGPSteadyState> always do. The counts and times accumulate until <resetProfile> is called. The counters are shared by the threads and so profiling slows the evaluation a little. The default of NULL profiles nothing.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		prof - pointer to an initialised profile, or NULL.
+
+	See Also:
+		<setProfileLog>, <printProfile>, <getProfileTime>
+*/
+DLL_EXPORT void setProfile(struct parameters *params, struct profile *prof);
+
+
+/*
+	Function: setProfileLog
+		Sets a function called with the <profile> every logInterval generations.
+
+		The function is called by <runCGP>, <runCGPDE_IN> and <runCGPDE_OUT> at the end of every logInterval generations with the number of generations completed, provided a profile is set by <setProfile>. The function must be of the form: void profileLog(struct parameters *params, struct profile *prof, int generation);
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		logInterval - the number of generations between calls, > 0.
+		profileLog - the function called, or NULL to stop logging.
+*/
+DLL_EXPORT void setProfileLog(struct parameters *params, int logInterval, void (*profileLog)(struct parameters *params, struct profile *prof, int generation));
+
+
+/*
+	Function: printProfile
+		Prints every counter and time of a <profile> to the terminal.
+
+	Parameters:
+		prof - pointer to an initialised profile.
+*/
+DLL_EXPORT void printProfile(struct profile *prof);
+
+
+/*
+	Function: getProfileFitnessEvaluations
+		Gets the number of fitness evaluations, on training and validation samples, counted in a <profile>.
+
+	Parameters:
+		prof - pointer to an initialised profile.
+
+	Returns:
+		The number of fitness evaluations.
+*/
+DLL_EXPORT unsigned long getProfileFitnessEvaluations(struct profile *prof);
+
+
+/*
+	Function: getProfileSamplesExecuted
+		Gets the number of samples executed by the profiled chromosomes.
+
+	Parameters:
+		prof - pointer to an initialised profile.
+
+	Returns:
+		The number of samples executed.
+*/
+DLL_EXPORT unsigned long getProfileSamplesExecuted(struct profile *prof);
+
+
+/*
+	Function: getProfileAverageActiveNodes
+		Gets the average number of active nodes of the chromosomes whose fitness was evaluated.
+
+	Parameters:
+		prof - pointer to an initialised profile.
+
+	Returns:
+		The average number of active nodes per fitness evaluation, 0 if there were none.
+*/
+DLL_EXPORT double getProfileAverageActiveNodes(struct profile *prof);
+
+
+/*
+	Function: getProfileActiveNodesUpdates
+		Gets the number of times the active nodes of a profiled chromosome were found after its genes changed.
+
+	Parameters:
+		prof - pointer to an initialised profile.
+
+	Returns:
+		The number of active nodes updates.
+*/
+DLL_EXPORT unsigned long getProfileActiveNodesUpdates(struct profile *prof);
+
+
+/*
+	Function: getProfileCopies
+		Gets the number of times a chromosome was copied into a profiled chromosome, see <copyChromosome>.
+
+	Parameters:
+		prof - pointer to an initialised profile.
+
+	Returns:
+		The number of chromosome copies.
+*/
+DLL_EXPORT unsigned long getProfileCopies(struct profile *prof);
+
+
+/*
+	Function: getProfileMutations
+		Gets the number of chromosome mutations counted in a <profile>.
+
+	Parameters:
+		prof - pointer to an initialised profile.
+
+	Returns:
+		The number of mutations.
+*/
+DLL_EXPORT unsigned long getProfileMutations(struct profile *prof);
+
+
+/*
+	Function: getProfileDETrials
+		Gets the number of DE trial vectors evaluated.
+
+	Parameters:
+		prof - pointer to an initialised profile.
+
+	Returns:
+		The number of DE trial vectors.
+
+	See Also:
+		<getProfileDETrialsAccepted>
+*/
+DLL_EXPORT unsigned long getProfileDETrials(struct profile *prof);
+
+
+/*
+	Function: getProfileDETrialsAccepted
+		Gets the number of DE trial vectors which replaced their target individual.
+
+	Parameters:
+		prof - pointer to an initialised profile.
+
+	Returns:
+		The number of DE trial vectors accepted.
+
+	See Also:
+		<getProfileDETrials>
+*/
+DLL_EXPORT unsigned long getProfileDETrialsAccepted(struct profile *prof);
+
+
+/*
+	Function: getProfileTime
+		Gets the seconds spent in the given phase, summed over the threads.
+
+		The phases are "evaluation", "activeNodes", "copy", "mutation" and "DE". They nest: the evaluation time includes the time of the active nodes updates it causes, the mutation time those of the mutated chromosomes and the DE time the evaluations of its trial vectors.
+
+	Parameters:
+		prof - pointer to an initialised profile.
+		phase - the name of the phase.
+
+	Returns:
+		The seconds spent in the phase, 0 if the phase is not known.
+*/
+DLL_EXPORT double getProfileTime(struct profile *prof, char const *phase);
+
+
 /*
 	Title: CGP Functions
 */
@@ -1926,8 +2855,102 @@ DLL_EXPORT struct chromosome* runCGP(struct parameters *params, struct dataSet *
 
 DLL_EXPORT struct chromosome* runCGPDE_IN(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, unsigned int * seed);
 
+/*
+	Function: resumeCGP
+		Continues a run of <runCGP> from the checkpoint saved using <setCheckpoint>.
+
+		The parents, children, best chromosome and random number seed are those of the checkpoint, and the run continues from the generation after it until numGens generations have been completed. Given the same parameters and dataSets the returned chromosome, and the final value of seed, are those of a <runCGP> of numGens generations which had not been stopped. Checkpoints continue to be saved as set by <setCheckpoint>.
+
+	Note:
+		The parameters and random number generator (<setRandomNumberGenerator>) must be those of the stopped run. The node function rand uses the unseeded rand() and so cannot be resumed exactly. As resumeCGP returns an initialised chromosome this should later be free'd using <freeChromosome>.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		dataTrain - the <dataSet> the children are evaluated on.
+		dataValid - the <dataSet> the best chromosome is chosen on.
+		numGens - the number of generations of the whole run.
+		checkpointFile - char array giving the location of the checkpoint file.
+		seed - the random number seed, set to that of the checkpoint.
+
+	Returns:
+		A pointer to an initialised chromosome.
+
+	See Also:
+		<setCheckpoint>, <runCGP>, <resumeCGPDE_IN>, <resumeCGPDE_OUT>
+*/
+DLL_EXPORT struct chromosome* resumeCGP(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, char const *checkpointFile, unsigned int * seed);
+
+/*
+	Function: resumeCGPDE_IN
+		Continues a run of <runCGPDE_IN> from the checkpoint saved using <setCheckpoint>, as <resumeCGP> does for <runCGP>.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		dataTrain - the <dataSet> the children are evaluated on.
+		dataValid - the <dataSet> the best chromosome is chosen on.
+		numGens - the number of generations of the whole run.
+		checkpointFile - char array giving the location of the checkpoint file.
+		seed - the random number seed, set to that of the checkpoint.
+
+	Returns:
+		A pointer to an initialised chromosome.
+
+	See Also:
+		<setCheckpoint>, <runCGPDE_IN>, <resumeCGP>
+*/
+DLL_EXPORT struct chromosome* resumeCGPDE_IN(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, char const *checkpointFile, unsigned int * seed);
+
+/*
+	Function: runCGPSteadyState
+		Applies steady-state CGPANN or CGPDE-IN to the given task, updating the population asynchronously.
+
+		Rather than waiting for every child of a generation to be evaluated, each of the numEvaluations children is a task of one pool of the threads set by <setNumThreads>. Whenever a thread is free it takes the next task, which copies a random parent from the population as it is at that moment, mutates and evaluates it, and then replaces the worst parent if its fitness is not greater. In CGPDE-IN the DE of the weights of each new topology is its own task in the same pool, so all the threads stay busy even when the evaluation times of the children differ widely. As in <runCGP> the best chromosome is chosen on the validation data.
+
+		The population holds the mu parents set by <setMu>; lambda, the evolutionary strategy and the selection and reproduction schemes are not used. Fitness memoisation and the bounded fitness function are used as in <runCGP>.
+
+	Note:
+		The order in which the children are evaluated and inserted depends on the threads, and so the results are only reproducible for a given seed when a single thread is used. As runCGPSteadyState returns an initialised chromosome this should later be free'd using <freeChromosome>. For CGPDE-OUT, <runDE> with type 2 can be applied to the returned CGPANN chromosome.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		dataTrain - the <dataSet> the children are evaluated on.
+		dataValid - the <dataSet> the best chromosome is chosen on.
+		numEvaluations - the number of children to create.
+		typeCGP - 0 for CGPANN or 1 for CGPDE-IN.
+		seed - the random number seed.
+
+	Returns:
+		A pointer to an initialised chromosome.
+
+	See Also:
+		<runCGP>, <runCGPDE_IN>, <setNumThreads>
+*/
+DLL_EXPORT struct chromosome* runCGPSteadyState(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numEvaluations, int typeCGP, unsigned int * seed);
+
 DLL_EXPORT struct chromosome** runCGPDE_OUT(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, unsigned int * seed);
 
+/*
+	Function: resumeCGPDE_OUT
+		Continues a run of <runCGPDE_OUT> from the checkpoint saved using <setCheckpoint>, as <resumeCGP> does for <runCGP>.
+
+		A checkpoint saved during the DE of the weights continues that DE from the iteration after it, the generations having all been completed.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		dataTrain - the <dataSet> the children are evaluated on.
+		dataValid - the <dataSet> the best chromosome is chosen on.
+		numGens - the number of generations of the whole run.
+		checkpointFile - char array giving the location of the checkpoint file.
+		seed - the random number seed, set to that of the checkpoint.
+
+	Returns:
+		The DE population, as returned by <runCGPDE_OUT>.
+
+	See Also:
+		<setCheckpoint>, <runCGPDE_OUT>, <resumeCGP>
+*/
+DLL_EXPORT struct chromosome** resumeCGPDE_OUT(struct parameters *params, struct dataSet *dataTrain, struct dataSet *dataValid, int numGens, char const *checkpointFile, unsigned int * seed);
+
 DLL_EXPORT struct chromosome** runDE(struct parameters *params, struct chromosome *chromo, struct dataSet *dataTrain, struct dataSet *dataValid, int type, unsigned int * seed);
 
 DLL_EXPORT struct DEChromosome ** initialiseDEPopulation(struct parameters *params, struct chromosome *chromo, struct dataSet *data, int type, unsigned int * seed);
@@ -1936,6 +2959,130 @@ DLL_EXPORT struct DEChromosome * initialiseDEChromosome(struct parameters *param
 
 DLL_EXPORT struct chromosome * getBestDEChromosome(struct parameters *params, struct chromosome ** chromos, struct dataSet *dataValid, int type, unsigned int * seed);
 
+/*
+	Title: Experiment Functions
+*/
+
+/*
+	Function: initialiseExperiment
+		Initialises an <experiment> of repeated stratified 10-fold cross-validations of the given dataSet.
+
+		Each round shuffles the dataSet, reduces it using <reduceSampleSize> and divides it using <generateFolds>. Each of the ten runs of a round tests on one fold and trains and validates on the others, chosen by <getIndex>. The seeds of the rounds and runs are those of the experiments of the related paper, so the same sets are used. The folds of every round are held at once and so all the runs of the experiment can be scheduled together.
+
+	Note:
+		The dataSet is shuffled in place but it is not otherwise changed and can be free'd once the experiment is initialised. The returned experiment should later be free'd using <freeExperiment>.
+
+	Parameters:
+		params - pointer to <parameters> structure.
+		data - pointer to the dataSet of the experiment.
+		numRounds - the number of cross-validations.
+		percentage - the proportion of the samples used; 0 < percentage <= 1.
+
+	Returns:
+		A pointer to an initialised experiment.
+
+	Example:
+
+		(begin code)
+		struct experiment *experiment;
+
+		experiment = initialiseExperiment(params, data, 3, 1.0);
+
+		addExperimentAlgorithm(experiment, "CGPANN", 50000);
+		addExperimentAlgorithm(experiment, "CGPDE-OUT", 40000);
+
+		runExperiment(experiment, "./results");
+
+		freeExperiment(experiment);
+		(end)
+
+	See Also:
+		<addExperimentAlgorithm>, <runExperiment>, <freeExperiment>
+*/
+DLL_EXPORT struct experiment *initialiseExperiment(struct parameters *params, struct dataSet *data, int numRounds, double percentage);
+
+
+/*
+	Function: freeExperiment
+		Frees an <experiment> and the sets of its runs.
+
+	Parameters:
+		experiment - pointer to an initialised experiment.
+
+	See Also:
+		<initialiseExperiment>
+*/
+DLL_EXPORT void freeExperiment(struct experiment *experiment);
+
+
+/*
+	Function: addExperimentAlgorithm
+		Adds an algorithm to be run on every fold of an <experiment>.
+
+		The valid algorithms are "CGPANN" (<runCGP>), "CGPDE-IN" (<runCGPDE_IN>) and "CGPDE-OUT" (<runCGPDE_OUT>). A CGPDE-OUT job gives the results of both CGPDE-OUT-T and CGPDE-OUT-V, which use the same DE population. If the algorithm is not known, has already been added or numGens < 0 a warning is displayed and the algorithm is not added.
+
+	Parameters:
+		experiment - pointer to an initialised experiment.
+		algorithm - the name of the algorithm.
+		numGens - the number of generations of each run of the algorithm.
+
+	See Also:
+		<initialiseExperiment>, <runExperiment>
+*/
+DLL_EXPORT void addExperimentAlgorithm(struct experiment *experiment, char const *algorithm, int numGens);
+
+
+/*
+	Function: setExperimentSaveDataSets
+		Sets whether <runExperiment> saves the training, validation and testing sets of each run.
+
+		The sets are saved using <saveDataSetBinary> as TRN/TRN_i_j.bin, VLD/VLD_i_j.bin and TST/TST_i_j.bin within the results directory, for round i and fold j. The TRN, VLD and TST directories must already exist. By default the sets are not saved.
+
+	Parameters:
+		experiment - pointer to an initialised experiment.
+		saveDataSets - 0 (no) or 1 (yes).
+
+	See Also:
+		<runExperiment>
+*/
+DLL_EXPORT void setExperimentSaveDataSets(struct experiment *experiment, int saveDataSets);
+
+
+/*
+	Function: setExperimentScoreFunction
+		Sets the function giving the result of each run on its testing set.
+
+		By default the result is the fitness given by the fitness function of the <parameters>. A score function can instead give, for example, an accuracy to be maximised when the fitness function gives its negation. The score name is the header of the results column.
+
+	Parameters:
+		experiment - pointer to an initialised experiment.
+		scoreFunction - the score function, or NULL for the fitness function.
+		scoreName - the name of the score.
+
+	See Also:
+		<runExperiment>, <setCustomFitnessFunction>
+*/
+DLL_EXPORT void setExperimentScoreFunction(struct experiment *experiment, double (*scoreFunction)(struct parameters *params, struct chromosome *chromo, struct dataSet *data), char const *scoreName);
+
+
+/*
+	Function: runExperiment
+		Runs every (round, fold, algorithm) job of an <experiment> and writes the results as each job finishes.
+
+		All the jobs are shared by one pool of the threads set by <setNumThreads>. A thread takes the next job as soon as it is free, the most costly jobs being started first, so there is no barrier between the rounds or algorithms. The parallel regions within a job are then run by its thread alone. Each algorithm has its own seed in each run and so the results do not depend on the number of threads or on the other algorithms added.
+
+		The results of each added algorithm are written to cgpann.txt, cgpde_in.txt, cgpde_out_t.txt and cgpde_out_v.txt within the given directory, one line "i, j, score" per run in the order the runs finish, and are also displayed in the terminal.
+
+	Parameters:
+		experiment - pointer to an initialised experiment.
+		directory - the directory of the results files.
+
+	See Also:
+		<initialiseExperiment>, <addExperimentAlgorithm>, <setExperimentSaveDataSets>, <setExperimentScoreFunction>
+*/
+DLL_EXPORT void runExperiment(struct experiment *experiment, char const *directory);
+
+
 /*
 	Title: Other
 */
@@ -1957,6 +3104,22 @@ DLL_EXPORT struct chromosome * getBestDEChromosome(struct parameters *params, st
 */
 DLL_EXPORT void setRandomNumberSeed(unsigned int seed);
 
+/*
+	Function: setRandomNumberGenerator
+		Sets the generator of the random numbers drawn from the seeds given to CGP-Library.
+
+		The seeds passed to the CGP-Library functions are the 32 bit states of the generator. The default "rand_r" uses rand_r, giving the same results as earlier versions, although its decimals only take 1000000 values. "pcg" uses the RXS M XS member of the PCG family of the same state, which is faster and statistically sounder: its decimals have 53 random bits, its integers are drawn without bias and the seeds of the tasks of <runCGPSteadyState> are drawn from it. With "pcg" the probabilistic mutation draws the number of genes skipped before each mutated gene, rather than one number for every gene, and so its cost is proportional to the number of mutated genes. The results then differ from those of "rand_r" for the same seeds.
+
+		The generator is shared by every thread and every <parameters> structure and so must only be set between runs.
+
+	Parameters:
+		generator - "rand_r" or "pcg".
+
+	See Also:
+		<setRandomNumberSeed>, <setMutationType>
+*/
+DLL_EXPORT void setRandomNumberGenerator(char const *generator);
+
 /*
 	End of extern "C"
 */